@@ -0,0 +1,209 @@
+// Benchmark de renderização do SSD1306 no host
+// Compara o driver atual (fill com memset, linhas/retângulos por máscara de página, glifos copiados
+// coluna a coluna) com o desenho antigo pixel a pixel, reproduzido aqui como referência.
+// Antes de medir confere que os dois geram o mesmo ram_buffer em cenas com y desalinhado,
+// símbolos rotacionados e números pequenos
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_bench.h"
+#include "host_hal.h"
+#include "ssd1306.h"
+#include "font.h" // sem includes próprios: depois do ssd1306.h (uint8_t), como no ssd1306.c
+
+#define WIDTH  128
+#define HEIGHT 64
+#define BUFSIZE (WIDTH * HEIGHT / 8 + 1)
+
+// --- Referência: desenho pixel a pixel (driver anterior) ---
+
+static void ref_pixel(uint8_t *buf, uint8_t x, uint8_t y, bool value) {
+    if (x >= WIDTH || y >= HEIGHT) return;
+    uint16_t index = (y / 8) * WIDTH + x + 1;
+    if (value) {
+        buf[index] |= (1 << (y % 8));
+    } else {
+        buf[index] &= ~(1 << (y % 8));
+    }
+}
+
+static void ref_fill(uint8_t *buf, bool value) {
+    for (uint8_t y = 0; y < HEIGHT; ++y) {
+        for (uint8_t x = 0; x < WIDTH; ++x) ref_pixel(buf, x, y, value);
+    }
+}
+
+static void ref_hline(uint8_t *buf, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+    for (uint8_t x = x0; x <= x1; ++x) ref_pixel(buf, x, y, value);
+}
+
+static void ref_rect(uint8_t *buf, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+    for (uint8_t x = left; x < left + width; ++x) {
+        ref_pixel(buf, x, top, value);
+        ref_pixel(buf, x, top + height - 1, value);
+    }
+    for (uint8_t y = top; y < top + height; ++y) {
+        ref_pixel(buf, left, y, value);
+        ref_pixel(buf, left + width - 1, y, value);
+    }
+    if (fill) {
+        for (uint8_t x = left + 1; x < left + width - 1; ++x) {
+            for (uint8_t y = top + 1; y < top + height - 1; ++y) ref_pixel(buf, x, y, value);
+        }
+    }
+}
+
+static void ref_draw_char(uint8_t *buf, char c, uint8_t x, uint8_t y, bool use_small_numbers) {
+    if (use_small_numbers && c >= '0' && c <= '9') {
+        uint16_t index = 568 + (c - '0') * 5;
+        for (uint8_t i = 0; i < 5; ++i) {
+            for (uint8_t j = 0; j < 5; ++j) {
+                if ((font[index + i] >> (4 - j)) & 0x01) ref_pixel(buf, x + j, y + i, true);
+            }
+        }
+        return;
+    }
+    uint16_t index;
+    bool rotate = false;
+    if (c >= '0' && c <= '9') index = (c - '0' + 1) * 8;
+    else if (c >= 'A' && c <= 'Z') index = (c - 'A' + 11) * 8;
+    else if (c >= 'a' && c <= 'z') index = (c - 'a' + 37) * 8;
+    else if (c == ':') { index = 64 * 8; rotate = true; }
+    else if (c == '.') { index = 65 * 8; rotate = true; }
+    else if (c == '>') { index = 66 * 8; rotate = true; }
+    else if (c == '-') { index = 67 * 8; rotate = true; }
+    else if (c == 127) index = 68 * 8;
+    else if (c == '!') { index = 69 * 8; rotate = true; }
+    else if (c == '%') { index = 70 * 8; rotate = true; }
+    else if (c == '/') { index = 71 * 8; rotate = true; }
+    else return;
+    for (uint8_t i = 0; i < 8; ++i) {
+        uint8_t line = font[index + i];
+        for (uint8_t j = 0; j < 8; ++j) {
+            ref_pixel(buf, x + (rotate ? (7 - j) : i), y + (rotate ? i : j), (line >> j) & 0x01);
+        }
+    }
+}
+
+static void ref_draw_string(uint8_t *buf, const char *str, uint8_t x, uint8_t y, bool use_small_numbers) {
+    for (; *str; str++) {
+        uint8_t char_width = (use_small_numbers && *str >= '0' && *str <= '9') ? 5 : 8;
+        if (x + char_width > WIDTH) {
+            x = 0;
+            y += 8;
+            if (y + 8 > HEIGHT) break;
+        }
+        ref_draw_char(buf, *str, x, y, use_small_numbers);
+        x += char_width;
+    }
+}
+
+// --- Cenas (as duas do update_display do main.c e uma de conferência) ---
+
+// Tela inteira: o que o update_display desenhava a cada atualização antes do envio parcial
+static void scene_full_ref(uint8_t *buf) {
+    ref_fill(buf, false);
+    ref_draw_string(buf, "MOTOR LEVEL", 28, 5, false);
+    ref_hline(buf, 0, 127, 18, true);
+    ref_draw_string(buf, "Nivel: 2", 35, 30, false);
+    ref_draw_string(buf, "Acc: 97.3%", 30, 45, false);
+}
+
+static void scene_full(ssd1306_t *ssd) {
+    ssd1306_fill(ssd, false);
+    ssd1306_draw_string(ssd, "MOTOR LEVEL", 28, 5, false);
+    ssd1306_hline(ssd, 0, 127, 18, true);
+    ssd1306_draw_string(ssd, "Nivel: 2", 35, 30, false);
+    ssd1306_draw_string(ssd, "Acc: 97.3%", 30, 45, false);
+}
+
+// Uma linha: apaga a faixa e redesenha o texto (update_line do main.c)
+static void scene_line_ref(uint8_t *buf) {
+    ref_rect(buf, 44, 0, 128, 12, false, true);
+    ref_draw_string(buf, "Acc: 88.4%", 30, 45, false);
+}
+
+static void scene_line(ssd1306_t *ssd) {
+    ssd1306_rect(ssd, 44, 0, 128, 12, false, true);
+    ssd1306_draw_string(ssd, "Acc: 88.4%", 30, 45, false);
+}
+
+// Conferência: y desalinhado, símbolos rotacionados, números pequenos, contorno e borda da tela
+static void scene_check_ref(uint8_t *buf) {
+    ref_fill(buf, true);
+    ref_rect(buf, 3, 2, 121, 58, false, true);
+    ref_rect(buf, 5, 4, 60, 21, true, false);
+    ref_draw_string(buf, "Az: -1.5/2 >!%", 7, 9, false);
+    ref_draw_string(buf, "0123456789", 70, 27, true);
+    ref_draw_string(buf, "wrap text at the edge", 90, 37, false);
+    ref_hline(buf, 3, 120, 61, false);
+}
+
+static void scene_check(ssd1306_t *ssd) {
+    ssd1306_fill(ssd, true);
+    ssd1306_rect(ssd, 3, 2, 121, 58, false, true);
+    ssd1306_rect(ssd, 5, 4, 60, 21, true, false);
+    ssd1306_draw_string(ssd, "Az: -1.5/2 >!%", 7, 9, false);
+    ssd1306_draw_string(ssd, "0123456789", 70, 27, true);
+    ssd1306_draw_string(ssd, "wrap text at the edge", 90, 37, false);
+    ssd1306_hline(ssd, 3, 120, 61, false);
+}
+
+typedef struct {
+    const char *name;
+    void (*ref)(uint8_t *buf);
+    void (*fast)(ssd1306_t *ssd);
+} scene_t;
+
+static const scene_t scenes[] = {
+    {"tela inteira", scene_full_ref, scene_full},
+    {"uma linha", scene_line_ref, scene_line},
+    {"conferencia", scene_check_ref, scene_check},
+};
+
+int main(int argc, char **argv) {
+    int repeats = argc > 1 ? atoi(argv[1]) : 2000;
+    if (repeats < 1) repeats = 1;
+
+    ssd1306_t ssd;
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, i2c1);
+    static uint8_t ref[BUFSIZE];
+    double *ref_us = malloc((size_t)repeats * sizeof(double));
+    double *fast_us = malloc((size_t)repeats * sizeof(double));
+
+    fprintf(stderr, "--- bench_display: %dx%d, %d repeticoes por cena ---\n", WIDTH, HEIGHT, repeats);
+    int mismatches = 0;
+    for (size_t s = 0; s < sizeof(scenes) / sizeof(scenes[0]); s++) {
+        // Mesmo conteúdo inicial nos dois buffers
+        memset(ref + 1, 0x5A, BUFSIZE - 1);
+        memset(ssd.ram_buffer + 1, 0x5A, BUFSIZE - 1);
+        scenes[s].ref(ref);
+        scenes[s].fast(&ssd);
+        if (memcmp(ref + 1, ssd.ram_buffer + 1, BUFSIZE - 1) != 0) {
+            fprintf(stderr, "Erro: '%s' difere da referencia pixel a pixel\n", scenes[s].name);
+            mismatches++;
+        }
+
+        for (int r = 0; r < repeats; r++) {
+            uint64_t t0 = host_now_ns();
+            scenes[s].ref(ref);
+            uint64_t t1 = host_now_ns();
+            scenes[s].fast(&ssd);
+            uint64_t t2 = host_now_ns();
+            ref_us[r] = (double)(t1 - t0) / 1000.0;
+            fast_us[r] = (double)(t2 - t1) / 1000.0;
+        }
+        host_stats_t before = host_stats_compute(ref_us, (size_t)repeats);
+        host_stats_t after = host_stats_compute(fast_us, (size_t)repeats);
+        fprintf(stderr, "%s:\n", scenes[s].name);
+        host_stats_print("pixel a pixel", "us", &before);
+        host_stats_print("por byte", "us", &after);
+        fprintf(stderr, "Ganho: %.1fx (mediana)\n", before.median / after.median);
+    }
+
+    free(fast_us);
+    free(ref_us);
+    free(ssd.ram_buffer);
+    return mismatches ? 1 : 0;
+}
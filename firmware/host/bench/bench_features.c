@@ -0,0 +1,148 @@
+// Benchmark dos extratores de features no host
+// Reproduz data/nivel*.csv como série temporal (janela zerada na troca de nível) e mede,
+// por amostra, o push e o compute do window_features e do spectral_features (FFT Q15) e cada
+// entrada do filtro de decimação (sample_filter, com a amostra repetida SAMPLE_FILTER_DECIMATION
+// vezes como o sensor sobreamostrado do host)
+// O firmware de janelas faz push + compute a cada WINDOW_SAMPLE_MS, então o total tem que
+// caber com folga no período de amostragem
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fft_q15.h"
+#include "host_bench.h"
+#include "host_dataset.h"
+#include "sample_filter.h"
+#include "spectral_features.h"
+#include "window_features.h"
+
+// Mesmo período do main.c (WINDOW_SAMPLE_MS)
+#define BENCH_SAMPLE_US 10000.0
+
+// Evita que o compilador descarte as features calculadas
+static volatile float sink;
+
+// m/s² e °/s -> contagens do MPU6050 (±2g e ±250°/s), como o sensor entregaria
+static int16_t to_counts(float v, float per_lsb) {
+    float c = roundf(v / per_lsb);
+    return (int16_t)(c < -32768.0f ? -32768.0f : (c > 32767.0f ? 32767.0f : c));
+}
+
+int main(int argc, char **argv) {
+    int repeats = argc > 1 ? atoi(argv[1]) : 20;
+    if (repeats < 1) repeats = 1;
+
+    host_dataset_t ds;
+    if (host_dataset_load_levels(&ds, host_data_dir(), 0) != 0) {
+        fprintf(stderr, "Erro: nao carregou os CSVs de %s\n", host_data_dir());
+        return 1;
+    }
+
+    size_t total = ds.count * (size_t)repeats;
+    double *window_push_us = malloc(total * sizeof(double));
+    double *window_compute_us = malloc(total * sizeof(double));
+    double *spectral_push_us = malloc(total * sizeof(double));
+    double *spectral_compute_us = malloc(total * sizeof(double));
+    double *filter_push_us = malloc(total * SAMPLE_FILTER_DECIMATION * sizeof(double));
+    size_t window_n = 0, spectral_n = 0, filter_n = 0;
+
+    static window_features_t window;
+    static spectral_features_t spectrum;
+    static sample_filter_t filter;
+    int16_t filter_out[SAMPLE_FILTER_CHANNELS];
+    float window_out[WINDOW_NUM_FEATURES];
+    float spectral_out[SPECTRAL_NUM_FEATURES];
+
+    for (int r = 0; r < repeats; r++) {
+        int level = -1;
+        for (size_t i = 0; i < ds.count; i++) {
+            const float *sample = ds.samples[i].features;
+            if (ds.samples[i].label != level) {
+                window_features_init(&window);
+                spectral_features_init(&spectrum);
+                sample_filter_init(&filter);
+                level = ds.samples[i].label;
+            }
+
+            uint64_t t0 = host_now_ns();
+            window_features_push(&window, sample);
+            uint64_t t1 = host_now_ns();
+            spectral_features_push(&spectrum, sample);
+            uint64_t t2 = host_now_ns();
+            window_push_us[r * ds.count + i] = (double)(t1 - t0) / 1000.0;
+            spectral_push_us[r * ds.count + i] = (double)(t2 - t1) / 1000.0;
+
+            int16_t counts[SAMPLE_FILTER_CHANNELS];
+            for (int k = 0; k < 3; k++) {
+                counts[k] = to_counts(sample[k], 9.81f / 16384.0f);
+                counts[3 + k] = to_counts(sample[3 + k], 1.0f / 131.0f);
+            }
+            for (int d = 0; d < SAMPLE_FILTER_DECIMATION; d++) {
+                t0 = host_now_ns();
+                bool out = sample_filter_push(&filter, counts, filter_out);
+                filter_push_us[filter_n++] = (double)(host_now_ns() - t0) / 1000.0;
+                if (out) sink = filter_out[0];
+            }
+
+            if (window_features_ready(&window)) {
+                t0 = host_now_ns();
+                window_features_compute(&window, window_out);
+                window_compute_us[window_n++] = (double)(host_now_ns() - t0) / 1000.0;
+                sink = window_out[0];
+            }
+            if (spectral_features_ready(&spectrum)) {
+                t0 = host_now_ns();
+                spectral_features_compute(&spectrum, spectral_out);
+                spectral_compute_us[spectral_n++] = (double)(host_now_ns() - t0) / 1000.0;
+                sink = spectral_out[0];
+            }
+        }
+    }
+
+    // FFT real sozinha (um eixo, sem a média/normalização do compute)
+    int16_t frame[SPECTRAL_FFT_SIZE];
+    int32_t bins[SPECTRAL_FFT_SIZE + 2];
+    double *fft_us = malloc(total * sizeof(double));
+    for (size_t i = 0; i < total; i++) {
+        for (int t = 0; t < SPECTRAL_FFT_SIZE; t++) {
+            frame[t] = (int16_t)(((int32_t)(i + t) * 2654435761u) >> 20);
+        }
+        uint64_t t0 = host_now_ns();
+        fft_q15_real(frame, SPECTRAL_FFT_SIZE, bins);
+        fft_us[i] = (double)(host_now_ns() - t0) / 1000.0;
+        sink = (float)bins[2];
+    }
+
+    fprintf(stderr, "--- bench_features: %zu amostras x %d repeticoes ---\n", ds.count, repeats);
+    fprintf(stderr, "Janela: %d amostras (%d features) | FFT: %d pontos, %d bandas (%d features)\n",
+            WINDOW_SIZE, WINDOW_NUM_FEATURES, SPECTRAL_FFT_SIZE, SPECTRAL_BANDS, SPECTRAL_NUM_FEATURES);
+    fprintf(stderr, "Filtro: decimacao %d, %d biquads + FIR de %d taps\n", SAMPLE_FILTER_DECIMATION,
+            SAMPLE_FILTER_SECTIONS, SAMPLE_FILTER_TAPS);
+
+    host_stats_t wp = host_stats_compute(window_push_us, total);
+    host_stats_t wc = host_stats_compute(window_compute_us, window_n);
+    host_stats_t sp = host_stats_compute(spectral_push_us, total);
+    host_stats_t sc = host_stats_compute(spectral_compute_us, spectral_n);
+    host_stats_t fs = host_stats_compute(fft_us, total);
+    host_stats_t fp = host_stats_compute(filter_push_us, filter_n);
+    host_stats_print("janela push", "us", &wp);
+    host_stats_print("janela compute", "us", &wc);
+    host_stats_print("bandas push", "us", &sp);
+    host_stats_print("bandas compute", "us", &sc);
+    host_stats_print("fft_q15_real", "us", &fs);
+    host_stats_print("filtro push", "us", &fp);
+
+    // O filtro recebe SAMPLE_FILTER_DECIMATION entradas por amostra do modelo
+    double per_sample = wp.mean + wc.mean + sp.mean + sc.mean + fp.mean * SAMPLE_FILTER_DECIMATION;
+    fprintf(stderr, "Total por amostra: %.3f us (%.3f%% de um periodo de %.0f us)\n", per_sample,
+            100.0 * per_sample / BENCH_SAMPLE_US, BENCH_SAMPLE_US);
+
+    free(fft_us);
+    free(filter_push_us);
+    free(spectral_compute_us);
+    free(spectral_push_us);
+    free(window_compute_us);
+    free(window_push_us);
+    host_dataset_free(&ds);
+    return 0;
+}
@@ -0,0 +1,270 @@
+// Benchmark da conversão das amostras do MPU6050 no host
+// Reproduz data/nivel*.csv como contagens do sensor (±2g e ±250°/s) e mede, por amostra:
+//   - a conversão em float do mpu6050_read_data (mpu6050_frame_to_data + temperatura em double)
+//   - a conversão inteira (mpu6050_frame_to_fixed + mpu6050_temp_centi_c)
+//   - o modelo int8 pelo caminho float (conversão + tflm_infer) e direto das contagens
+//     (tflm_infer_frame, quantização só com inteiros)
+//   - o push do modelo de janelas pelo caminho float (mpu6050_frame_to_data + window_features_push +
+//     spectral_features_push) e pelo inteiro do push_frames (mpu6050_frame_to_fixed +
+//     window_features_push_fixed + spectral_features_push_counts), conferindo que as features batem
+// Cada passada sobre os CSVs é cronometrada inteira (a conversão custa menos que a leitura do
+// relógio); as estatísticas são das médias por amostra de cada passada
+// O host tem FPU: os ciclos medidos aqui não representam o RP2040, onde cada operação float é uma
+// rotina em software. Por isso o benchmark também imprime as operações float por amostra de cada caminho
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host_bench.h"
+#include "host_dataset.h"
+#include "mpu6050.h"
+#include "spectral_features.h"
+#include "tflm_wrapper.h"
+#include "window_features.h"
+
+// Temperatura bruta em torno de ~25 °C: os CSVs não têm temperatura, então cada amostra ganha uma
+// derivada da própria leitura (lida da memória por amostra, o compilador não dobra a conta)
+#define BENCH_TEMP_RAW (-2560)
+
+// Evita que o compilador descarte as conversões
+static volatile float sink_f;
+static volatile int32_t sink_i;
+
+typedef enum {
+    PATH_FLOAT,
+    PATH_FIXED,
+    PATH_INFER_FLOAT,
+    PATH_INFER_FRAME,
+    PATH_WINDOW_FLOAT,
+    PATH_WINDOW_FIXED,
+    PATH_COUNT
+} bench_path_t;
+
+static const char *const path_names[PATH_COUNT] = {
+    "conversao float", "conversao inteira", "int8 tflm_infer", "int8 tflm_infer_frame", "janela float",
+    "janela inteira"};
+
+// Janelas de cada caminho do push (o compute roda igual nos dois, só na inferência)
+static window_features_t windows[2];
+static spectral_features_t spectra[2];
+
+// Operações de ponto flutuante por amostra de cada caminho, contadas no código (no Cortex-M0+ cada uma
+// é uma chamada: __aeabi_* das rotinas de float da ROM, floorf/expf da libm)
+//   - mpu6050_frame_to_data: 3 eixos de aceleração x (i2f + 2 fmul; o /16384 vira multiplicação
+//     exata) + 3 de giro x (i2f + fdiv) = 15
+//   - temperatura antiga em double: i2d + ddiv + 2 dadd + d2f = 5
+//   - quantização da entrada int8 (dense::quantize_input): 6 x (fmul + 2 fadd + floorf + f2i) = 30
+//   - saída do modelo, igual nos dois caminhos int8: desquantização 4 x (i2f + fmul) e softmax
+//     (3 fcmp + 4 x (fsub + expf + fadd) + 4 fdiv) = 27
+//   - push float da janela: mpu6050_frame_to_data (15) + to_fixed do window_features 6 x (fmul + fadd +
+//     floorf + f2i) + Q15 do spectral_features 6 x (fmul + fadd + floorf + f2i) = 63
+// Os caminhos inteiros (mpu6050_frame_to_fixed, mpu6050_temp_centi_c, dense::quantize_input_fixed,
+// window_features_push_fixed, spectral_features_push_counts) não têm nenhuma
+typedef struct {
+    int single_ops, double_ops;
+} float_ops_t;
+
+static const float_ops_t path_float_ops[PATH_COUNT] = {{15, 5}, {0, 0}, {15 + 30 + 27, 0}, {27, 0},
+                                                       {15 + 24 + 24, 0}, {0, 0}};
+
+// Push de um frame nas janelas w do caminho float (como o push_frames antigo) ou do inteiro
+static void push_window_float(int w, const mpu6050_frame_t *f) {
+    mpu6050_data_t d;
+    mpu6050_frame_to_data(f, &d);
+    const float sample[6] = {d.accel_x, d.accel_y, d.accel_z, d.gyro_x, d.gyro_y, d.gyro_z};
+    window_features_push(&windows[w], sample);
+    spectral_features_push(&spectra[w], sample);
+}
+
+static void push_window_fixed(int w, const mpu6050_frame_t *f) {
+    mpu6050_fixed_t x;
+    mpu6050_frame_to_fixed(f, &x);
+    const int32_t sample[6] = {x.accel_mms2[0], x.accel_mms2[1], x.accel_mms2[2],
+                               x.gyro_mdps[0], x.gyro_mdps[1], x.gyro_mdps[2]};
+    const int16_t counts[6] = {f->accel[0], f->accel[1], f->accel[2], f->gyro[0], f->gyro[1], f->gyro[2]};
+    window_features_push_fixed(&windows[w], sample);
+    spectral_features_push_counts(&spectra[w], counts);
+}
+
+static int16_t to_counts(float v, float per_lsb) {
+    float c = roundf(v / per_lsb);
+    return (int16_t)(c < -32768.0f ? -32768.0f : (c > 32767.0f ? 32767.0f : c));
+}
+
+static int argmax4(const float v[4]) {
+    int best = 0;
+    for (int i = 1; i < 4; i++) {
+        if (v[i] > v[best]) best = i;
+    }
+    return best;
+}
+
+// Uma passada de um caminho sobre todos os frames; devolve os acertos (caminhos com modelo)
+static size_t run_path(bench_path_t path, const mpu6050_frame_t *frames, const int16_t *temps,
+                       const host_dataset_t *ds, int *preds) {
+    size_t hits = 0;
+    for (size_t i = 0; i < ds->count; i++) {
+        const mpu6050_frame_t *f = &frames[i];
+        switch (path) {
+        case PATH_FLOAT: {
+            mpu6050_data_t d;
+            mpu6050_frame_to_data(f, &d);
+            // Fórmula que o mpu6050_read_data usava (literais double)
+            d.temp_c = (temps[i] / 340.0) + 36.53 - 24.0;
+            sink_f = d.accel_x + d.accel_y + d.accel_z + d.gyro_x + d.gyro_y + d.gyro_z + d.temp_c;
+            break;
+        }
+        case PATH_FIXED: {
+            mpu6050_fixed_t x;
+            mpu6050_frame_to_fixed(f, &x);
+            sink_i = x.accel_mms2[0] + x.accel_mms2[1] + x.accel_mms2[2] + x.gyro_mdps[0] + x.gyro_mdps[1] +
+                     x.gyro_mdps[2] + mpu6050_temp_centi_c(temps[i]);
+            break;
+        }
+        case PATH_INFER_FLOAT: {
+            mpu6050_data_t d;
+            mpu6050_frame_to_data(f, &d);
+            float in[6] = {d.accel_x, d.accel_y, d.accel_z, d.gyro_x, d.gyro_y, d.gyro_z};
+            float out[4];
+            tflm_infer(in, out);
+            preds[i] = argmax4(out);
+            hits += preds[i] == ds->samples[i].label;
+            break;
+        }
+        case PATH_INFER_FRAME: {
+            float out[4];
+            tflm_infer_frame(f->accel, f->gyro, out);
+            preds[i] = argmax4(out);
+            hits += preds[i] == ds->samples[i].label;
+            break;
+        }
+        case PATH_WINDOW_FLOAT:
+            push_window_float(0, f);
+            break;
+        case PATH_WINDOW_FIXED:
+            push_window_fixed(1, f);
+            break;
+        default:
+            break;
+        }
+    }
+    return hits;
+}
+
+int main(int argc, char **argv) {
+    int repeats = argc > 1 ? atoi(argv[1]) : 50;
+    if (repeats < 1) repeats = 1;
+
+    host_dataset_t ds;
+    if (host_dataset_load_levels(&ds, host_data_dir(), 0) != 0) {
+        fprintf(stderr, "Erro: nao carregou os CSVs de %s\n", host_data_dir());
+        return 1;
+    }
+    if (tflm_init_model() != 0) {
+        fprintf(stderr, "Erro: tflm_init_model falhou\n");
+        return 1;
+    }
+
+    // CSVs (m/s² e °/s) -> contagens, como o sensor entregaria
+    const float accel_per_lsb = 9.81f / 16384.0f, gyro_per_lsb = 1.0f / 131.0f;
+    mpu6050_frame_t *frames = malloc(ds.count * sizeof(mpu6050_frame_t));
+    int16_t *temps = malloc(ds.count * sizeof(int16_t));
+    int *preds[2] = {malloc(ds.count * sizeof(int)), malloc(ds.count * sizeof(int))};
+    for (size_t i = 0; i < ds.count; i++) {
+        for (int k = 0; k < 3; k++) {
+            frames[i].accel[k] = to_counts(ds.samples[i].features[k], accel_per_lsb);
+            frames[i].gyro[k] = to_counts(ds.samples[i].features[3 + k], gyro_per_lsb);
+        }
+        temps[i] = (int16_t)(BENCH_TEMP_RAW + (frames[i].accel[0] & 0x3f));
+    }
+
+    double *ns[PATH_COUNT], *cycles[PATH_COUNT];
+    size_t hits[PATH_COUNT] = {0};
+    for (int p = 0; p < PATH_COUNT; p++) {
+        ns[p] = malloc(repeats * sizeof(double));
+        cycles[p] = malloc(repeats * sizeof(double));
+    }
+
+    // Caminhos intercalados em cada repetição: a frequência do host varia igual para todos
+    for (int r = 0; r < repeats; r++) {
+        for (int p = 0; p < PATH_COUNT; p++) {
+            int *pred = p == PATH_INFER_FRAME ? preds[1] : preds[0];
+            uint64_t t0 = host_now_ns(), c0 = host_now_cycles();
+            hits[p] = run_path((bench_path_t)p, frames, temps, &ds, pred);
+            uint64_t c1 = host_now_cycles(), t1 = host_now_ns();
+            ns[p][r] = (double)(t1 - t0) / (double)ds.count;
+            cycles[p][r] = (double)(c1 - c0) / (double)ds.count;
+        }
+    }
+
+    size_t agree = 0;
+    for (size_t i = 0; i < ds.count; i++) agree += preds[0][i] == preds[1][i];
+
+    // Features dos dois pushes a cada amostra (janelas zeradas na troca de nível, como o bench_features)
+    size_t window_same = 0, spectral_same = 0, compared = 0;
+    float window_diff = 0.0f, spectral_diff = 0.0f;
+    int level = -1;
+    for (size_t i = 0; i < ds.count; i++) {
+        if (ds.samples[i].label != level) {
+            for (int w = 0; w < 2; w++) {
+                window_features_init(&windows[w]);
+                spectral_features_init(&spectra[w]);
+            }
+            level = ds.samples[i].label;
+        }
+        push_window_float(0, &frames[i]);
+        push_window_fixed(1, &frames[i]);
+        if (!window_features_ready(&windows[0]) || !spectral_features_ready(&spectra[0])) continue;
+        float wf[2][WINDOW_NUM_FEATURES], sf[2][SPECTRAL_NUM_FEATURES];
+        for (int w = 0; w < 2; w++) {
+            window_features_compute(&windows[w], wf[w]);
+            spectral_features_compute(&spectra[w], sf[w]);
+        }
+        bool window_equal = true, spectral_equal = true;
+        for (int k = 0; k < WINDOW_NUM_FEATURES; k++) {
+            float d = fabsf(wf[0][k] - wf[1][k]) / fmaxf(fabsf(wf[0][k]), 1e-6f);
+            if (d > window_diff) window_diff = d;
+            window_equal &= wf[0][k] == wf[1][k];
+        }
+        for (int k = 0; k < SPECTRAL_NUM_FEATURES; k++) {
+            float d = fabsf(sf[0][k] - sf[1][k]) / fmaxf(fabsf(sf[0][k]), 1e-6f);
+            if (d > spectral_diff) spectral_diff = d;
+            spectral_equal &= sf[0][k] == sf[1][k];
+        }
+        window_same += window_equal;
+        spectral_same += spectral_equal;
+        compared++;
+    }
+
+    fprintf(stderr, "--- bench_sensor: %zu amostras x %d repeticoes (media por amostra de cada passada) ---\n",
+            ds.count, repeats);
+    for (int p = 0; p < PATH_COUNT; p++) {
+        host_stats_t s = host_stats_compute(ns[p], repeats);
+        host_stats_t c = host_stats_compute(cycles[p], repeats);
+        host_stats_print(path_names[p], "ns", &s);
+        fprintf(stderr, "  %-22s mediana %.1f ciclos do host por amostra | %d ops float + %d ops double no RP2040\n",
+                "", c.median, path_float_ops[p].single_ops, path_float_ops[p].double_ops);
+    }
+    fprintf(stderr, "Aviso: o host tem FPU, os ciclos acima nao valem para o RP2040 (Cortex-M0+ sem FPU, cada op "
+                    "float/double e uma rotina em software)\n");
+    fprintf(stderr, "Acuracia int8: tflm_infer %.2f%% | tflm_infer_frame %.2f%% | mesma classe em %.2f%%\n",
+            100.0 * hits[PATH_INFER_FLOAT] / ds.count, 100.0 * hits[PATH_INFER_FRAME] / ds.count,
+            100.0 * agree / ds.count);
+    if (compared) {
+        // O giro inteiro usa 7817/1024 m°/s por contagem contra 1000/131 do float: difere no último milésimo
+        fprintf(stderr, "Janela inteira x float: features iguais em %.2f%% das janelas (maior diferenca relativa "
+                        "%.1e) | bandas iguais em %.2f%% (%.1e)\n",
+                100.0 * window_same / compared, window_diff, 100.0 * spectral_same / compared, spectral_diff);
+    }
+
+    for (int p = 0; p < PATH_COUNT; p++) {
+        free(cycles[p]);
+        free(ns[p]);
+    }
+    free(preds[1]);
+    free(preds[0]);
+    free(temps);
+    free(frames);
+    host_dataset_free(&ds);
+    return 0;
+}
@@ -0,0 +1,391 @@
+// Benchmark do tflm_infer no host
+// Reproduz data/nivel*.csv pelo tflm_init_model/tflm_infer e reporta latência
+// (min/mediana/p99), inferências por segundo e, no motor TFLM, o custo de cada operador
+// Depois repete com tflm_infer_batch em blocos de N amostras e compara o custo por amostra
+// Compilado uma vez por motor: bench_tflm (MicroInterpreter) e bench_dense (dense_engine)
+// Com MOTOR_WINDOW_FEATURES (bench_dense_window) as entradas são as features de janela de cada CSV
+// (mais as bandas da FFT Q15 se o modelo foi exportado com MOTOR_SPECTRAL_FEATURES)
+// Com MOTOR_CHANNEL_MODEL (bench_dense_channels) só os canais do modelo entram
+// No motor TFLM registra um segundo modelo (models/motor_classification_model.tflite) na mesma arena e
+// confere, intercalando os dois, que as saídas de cada um são as mesmas de quando roda sozinho
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifndef MOTOR_ENGINE_DENSE
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/micro/micro_profiler_interface.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+#include "bench_second_model.h"  // models/motor_classification_model.tflite, gerado pelo CMake
+#include "scaler_params.h"       // o .tflite do notebook espera a entrada normalizada
+#endif
+
+#include "host_bench.h"
+#include "host_dataset.h"
+#include "tflm_wrapper.h"
+
+#ifndef MOTOR_ENGINE_DENSE
+// Profiler que acumula o tempo por tag (nome do operador) usando o relógio do host
+class OpProfiler : public tflite::MicroProfilerInterface {
+public:
+    static constexpr int kMaxTags = 16;
+    static constexpr int kMaxEvents = 32;
+
+    uint32_t BeginEvent(const char* tag) override {
+        if (open_ >= kMaxEvents) return kMaxEvents;
+        events_[open_].tag = tag;
+        events_[open_].start = host_now_ns();
+        return open_++;
+    }
+
+    void EndEvent(uint32_t handle) override {
+        if (handle >= kMaxEvents) return;
+        uint64_t elapsed = host_now_ns() - events_[handle].start;
+        Tag* t = find(events_[handle].tag);
+        if (t) {
+            t->total_ns += elapsed;
+            t->count++;
+        }
+        // Os eventos de um Invoke não se sobrepõem, então o último aberto é sempre o que fecha
+        if (handle + 1 == open_) open_--;
+    }
+
+    void Reset() {
+        num_tags_ = 0;
+        open_ = 0;
+    }
+
+    void Print(uint64_t invokes, double total_us_per_infer) const {
+        double ops_us = 0.0;
+        fprintf(stderr, "\nCusto por operador (media por inferencia):\n");
+        for (int i = 0; i < num_tags_; i++) {
+            double us = (double)tags_[i].total_ns / 1000.0 / (double)invokes;
+            ops_us += us;
+            fprintf(stderr, "  %-20s x%-3llu %9.3f us (%5.1f%%)\n", tags_[i].name,
+                    (unsigned long long)(tags_[i].count / invokes), us,
+                    100.0 * us / total_us_per_infer);
+        }
+        double rest = total_us_per_infer - ops_us;
+        fprintf(stderr, "  %-20s      %9.3f us (%5.1f%%)\n", "scaler+copia+invoke", rest,
+                100.0 * rest / total_us_per_infer);
+    }
+
+private:
+    struct Tag {
+        const char* name;
+        uint64_t total_ns;
+        uint64_t count;
+    };
+    struct Event {
+        const char* tag;
+        uint64_t start;
+    };
+
+    Tag* find(const char* name) {
+        for (int i = 0; i < num_tags_; i++) {
+            if (strcmp(tags_[i].name, name) == 0) return &tags_[i];
+        }
+        if (num_tags_ == kMaxTags) return nullptr;
+        tags_[num_tags_] = {name, 0, 0};
+        return &tags_[num_tags_++];
+    }
+
+    Tag tags_[kMaxTags];
+    Event events_[kMaxEvents];
+    int num_tags_ = 0;
+    uint32_t open_ = 0;
+};
+
+static OpProfiler op_profiler;
+#endif
+
+#ifndef BENCH_NAME
+#ifdef MOTOR_ENGINE_DENSE
+#define BENCH_NAME "bench_dense"
+#else
+#define BENCH_NAME "bench_tflm"
+#endif
+#endif
+
+static int argmax4(const float* v) {
+    int best = 0;
+    for (int i = 1; i < 4; i++) {
+        if (v[i] > v[best]) best = i;
+    }
+    return best;
+}
+
+// Entradas do tflm_infer já prontas (TFLM_NUM_FEATURES por linha) e o nível de cada uma
+struct BenchInputs {
+    float* features;
+    int* labels;
+    size_t count;
+};
+
+#ifdef MOTOR_WINDOW_FEATURES
+// Cada CSV é uma série temporal: passa as amostras pelo window_features (zerado na troca de
+// nível) e guarda uma entrada por amostra a partir da que completa a janela
+static BenchInputs prepare_inputs(const host_dataset_t& ds) {
+    BenchInputs in = {(float*)malloc(ds.count * TFLM_NUM_FEATURES * sizeof(float)),
+                      (int*)malloc(ds.count * sizeof(int)), 0};
+    window_features_t window;
+#ifdef MOTOR_SPECTRAL_FEATURES
+    spectral_features_t spectrum;
+#endif
+    double* push_us = (double*)malloc(ds.count * sizeof(double));
+    int level = -1;
+    for (size_t i = 0; i < ds.count; i++) {
+        if (ds.samples[i].label != level) {
+            window_features_init(&window);
+#ifdef MOTOR_SPECTRAL_FEATURES
+            spectral_features_init(&spectrum);
+#endif
+            level = ds.samples[i].label;
+        }
+        uint64_t t0 = host_now_ns();
+        window_features_push(&window, ds.samples[i].features);
+#ifdef MOTOR_SPECTRAL_FEATURES
+        spectral_features_push(&spectrum, ds.samples[i].features);
+        bool ready = window_features_ready(&window) && spectral_features_ready(&spectrum);
+#else
+        bool ready = window_features_ready(&window);
+#endif
+        if (ready) {
+            float* row = in.features + in.count * TFLM_NUM_FEATURES;
+            window_features_compute(&window, row);
+#ifdef MOTOR_SPECTRAL_FEATURES
+            spectral_features_compute(&spectrum, row + WINDOW_NUM_FEATURES);
+#endif
+            in.labels[in.count++] = level;
+        }
+        push_us[i] = (double)(host_now_ns() - t0) / 1000.0;
+    }
+
+    fprintf(stderr, "Janelas de %d amostras: %zu entradas de %d features\n", WINDOW_SIZE, in.count,
+            TFLM_NUM_FEATURES);
+    host_stats_t stats = host_stats_compute(push_us, ds.count);
+    host_stats_print("push+features", "us", &stats);
+    free(push_us);
+    return in;
+}
+#else
+static BenchInputs prepare_inputs(const host_dataset_t& ds) {
+    BenchInputs in = {(float*)malloc(ds.count * TFLM_NUM_FEATURES * sizeof(float)),
+                      (int*)malloc(ds.count * sizeof(int)), ds.count};
+    for (size_t i = 0; i < ds.count; i++) {
+#ifdef MOTOR_CHANNEL_MODEL
+        // Modelo de canais reduzidos: só as colunas de MOTOR_SENSOR_CHANNELS
+        for (int k = 0; k < TFLM_NUM_FEATURES; k++) {
+            in.features[i * TFLM_NUM_FEATURES + k] = ds.samples[i].features[mpu6050_channel_index(MOTOR_SENSOR_CHANNELS, k)];
+        }
+#else
+        memcpy(in.features + i * TFLM_NUM_FEATURES, ds.samples[i].features, 6 * sizeof(float));
+#endif
+        in.labels[i] = ds.samples[i].label;
+    }
+    return in;
+}
+#endif
+
+#ifndef MOTOR_ENGINE_DENSE
+// Segundo modelo rodando sozinho, com interpretador e arena próprios: a referência do registro
+static int run_second_isolated(const float* in, float* out, size_t n, unsigned int* arena_bytes) {
+    static tflite::MicroMutableOpResolver<4> resolver;
+    resolver.AddFullyConnected();
+    resolver.AddRelu();
+    resolver.AddSoftmax();
+    resolver.AddReshape();
+    alignas(16) static uint8_t arena[16 * 1024];
+
+    tflite::MicroInterpreter interpreter(tflite::GetModel(bench_second_model), resolver, arena, sizeof(arena));
+    if (interpreter.AllocateTensors() != kTfLiteOk) return -1;
+    TfLiteTensor* input = interpreter.input(0);
+    TfLiteTensor* output = interpreter.output(0);
+    if (input->type != kTfLiteFloat32 || output->type != kTfLiteFloat32) return -1;
+
+    for (size_t i = 0; i < n; i++) {
+        memcpy(input->data.f, in + i * 6, 6 * sizeof(float));
+        if (interpreter.Invoke() != kTfLiteOk) return -2;
+        memcpy(out + i * 4, output->data.f, 4 * sizeof(float));
+    }
+    *arena_bytes = (unsigned int)interpreter.arena_used_bytes();
+    return 0;
+}
+
+// Registro de modelos: modelo do motor e segundo modelo intercalados amostra a amostra sobre a mesma
+// arena; as saídas têm que ser idênticas às de cada um sozinho (main_ref: tflm_infer sem o segundo
+// modelo rodar entre as chamadas). Retorna o número de saídas diferentes
+static size_t check_registry(tflm_model_handle second, const host_dataset_t& ds, const BenchInputs& in,
+                             const float* main_ref) {
+    const size_t n = ds.count;
+    float* norm = (float*)malloc(n * 6 * sizeof(float));
+    float* second_ref = (float*)malloc(n * 4 * sizeof(float));
+    float* second_out = (float*)malloc(n * 4 * sizeof(float));
+    for (size_t i = 0; i < n; i++) {
+        for (int k = 0; k < 6; k++) {
+            norm[i * 6 + k] = (ds.samples[i].features[k] - scaler_mean[k]) / scaler_scale[k];
+        }
+    }
+
+    unsigned int isolated_bytes = 0;
+    if (run_second_isolated(norm, second_ref, n, &isolated_bytes) != 0) {
+        fprintf(stderr, "Erro: segundo modelo nao rodou sozinho\n");
+        free(second_out);
+        free(second_ref);
+        free(norm);
+        return n;
+    }
+
+    size_t main_diff = 0, second_diff = 0, same_class = 0;
+    float scores[4];
+    for (size_t i = 0; i < n; i++) {
+        if (i < in.count) {
+            tflm_infer(in.features + i * TFLM_NUM_FEATURES, scores);
+            main_diff += memcmp(scores, main_ref + i * 4, sizeof(scores)) != 0;
+        }
+        tflm_model_infer(second, norm + i * 6, second_out + i * 4, 1);
+        second_diff += memcmp(second_out + i * 4, second_ref + i * 4, 4 * sizeof(float)) != 0;
+#ifndef MOTOR_WINDOW_FEATURES
+        // Mesma amostra nos dois modelos (no de janelas a entrada i do motor é uma janela, não a amostra i)
+        same_class += i < in.count && argmax4(second_out + i * 4) == argmax4(main_ref + i * 4);
+#endif
+    }
+    // Todas as amostras numa chamada só (laço de blocos do tflm_model_infer)
+    tflm_model_infer(second, norm, second_out, (int)n);
+    size_t batch_diff = 0;
+    for (size_t i = 0; i < n; i++) {
+        batch_diff += memcmp(second_out + i * 4, second_ref + i * 4, 4 * sizeof(float)) != 0;
+    }
+
+    fprintf(stderr, "\n--- registro de modelos: motor + models/motor_classification_model.tflite ---\n");
+    fprintf(stderr, "Arena: modelo do motor +%u bytes, segundo modelo +%u bytes (sozinho usa %u), total %u\n",
+            tflm_model_arena_bytes(TFLM_MAIN_MODEL), tflm_model_arena_bytes(second), isolated_bytes,
+            tflm_arena_used_bytes());
+    fprintf(stderr, "Intercalados: motor %zu/%zu e segundo %zu/%zu saidas identicas as de cada um sozinho\n",
+            in.count - main_diff, in.count, n - second_diff, n);
+    fprintf(stderr, "Segundo modelo em uma chamada (n=%zu): %zu/%zu identicas | mesma classe do motor em %zu/%zu\n",
+            n, n - batch_diff, n, same_class, in.count < n ? in.count : n);
+
+    free(second_out);
+    free(second_ref);
+    free(norm);
+    return main_diff + second_diff + batch_diff;
+}
+#endif
+
+int main(int argc, char** argv) {
+    int repeats = argc > 1 ? atoi(argv[1]) : 20;
+    if (repeats < 1) repeats = 1;
+    int batch = argc > 2 ? atoi(argv[2]) : 16;
+    if (batch < 1) batch = 1;
+
+    host_dataset_t ds;
+    if (host_dataset_load_levels(&ds, host_data_dir(), 0) != 0) {
+        fprintf(stderr, "Erro: nao carregou os CSVs de %s\n", host_data_dir());
+        return 1;
+    }
+    BenchInputs in = prepare_inputs(ds);
+    const size_t count = in.count;
+
+#ifndef MOTOR_ENGINE_DENSE
+    tflm_set_profiler(&op_profiler);
+    tflm_model_handle second = tflm_register_model(bench_second_model, 6, 4);
+    if (second < 0) {
+        fprintf(stderr, "Erro: tflm_register_model falhou\n");
+        return 1;
+    }
+#endif
+    if (tflm_init_model() != 0) {
+        fprintf(stderr, "Erro: tflm_init_model falhou\n");
+        return 1;
+    }
+
+    float scores[4];
+
+    // Aquecimento + acurácia sobre o dataset completo (as saídas ficam de referência pro registro)
+    float* main_ref = (float*)malloc(count * 4 * sizeof(float));
+    size_t hits = 0;
+    for (size_t i = 0; i < count; i++) {
+        tflm_infer(in.features + i * TFLM_NUM_FEATURES, main_ref + i * 4);
+        if (argmax4(main_ref + i * 4) == in.labels[i]) hits++;
+    }
+#ifndef MOTOR_ENGINE_DENSE
+    op_profiler.Reset();
+#endif
+
+    size_t total = count * (size_t)repeats;
+    double* latency_us = (double*)malloc(total * sizeof(double));
+    uint64_t run_start = host_now_ns();
+    for (int r = 0; r < repeats; r++) {
+        for (size_t i = 0; i < count; i++) {
+            uint64_t t0 = host_now_ns();
+            tflm_infer(in.features + i * TFLM_NUM_FEATURES, scores);
+            latency_us[r * count + i] = (double)(host_now_ns() - t0) / 1000.0;
+        }
+    }
+    double run_s = (double)(host_now_ns() - run_start) / 1e9;
+
+    fprintf(stderr, "--- %s: %zu amostras x %d repeticoes ---\n", BENCH_NAME, count, repeats);
+    fprintf(stderr, "Arena usada: %u bytes\n", tflm_arena_used_bytes());
+    fprintf(stderr, "Acuracia (CSV completo): %.2f%%\n", 100.0 * (double)hits / (double)count);
+
+    host_stats_t stats = host_stats_compute(latency_us, total);
+    host_stats_print("tflm_infer", "us", &stats);
+    fprintf(stderr, "Vazao: %.0f inferencias/s\n", (double)total / run_s);
+
+#ifndef MOTOR_ENGINE_DENSE
+    op_profiler.Print(total, stats.mean);
+#endif
+
+    // Mesmo dataset em blocos de `batch` amostras pelo tflm_infer_batch
+    // (features e scores contíguos, como um burst lido do sensor)
+    float* batch_out = (float*)malloc(count * 4 * sizeof(float));
+
+    size_t same = 0;
+    tflm_infer_batch(in.features, batch_out, (int)count);
+    for (size_t i = 0; i < count; i++) {
+        tflm_infer(in.features + i * TFLM_NUM_FEATURES, scores);
+        if (argmax4(batch_out + i * 4) == argmax4(scores)) same++;
+    }
+
+    size_t chunks = (count + batch - 1) / batch;
+    double* chunk_us = (double*)malloc(chunks * repeats * sizeof(double));
+    run_start = host_now_ns();
+    for (int r = 0; r < repeats; r++) {
+        for (size_t c = 0; c < chunks; c++) {
+            size_t first = c * batch;
+            int rows = (int)(count - first < (size_t)batch ? count - first : (size_t)batch);
+            uint64_t t0 = host_now_ns();
+            tflm_infer_batch(in.features + first * TFLM_NUM_FEATURES, batch_out + first * 4, rows);
+            // custo por amostra dentro do bloco
+            chunk_us[r * chunks + c] = (double)(host_now_ns() - t0) / 1000.0 / rows;
+        }
+    }
+    run_s = (double)(host_now_ns() - run_start) / 1e9;
+
+    fprintf(stderr, "\n--- tflm_infer_batch: blocos de %d amostras ---\n", batch);
+    fprintf(stderr, "Predicoes iguais ao tflm_infer: %zu/%zu\n", same, count);
+    host_stats_t batch_stats = host_stats_compute(chunk_us, chunks * repeats);
+    host_stats_print("por amostra", "us", &batch_stats);
+    fprintf(stderr, "Vazao: %.0f inferencias/s (%.2fx o tflm_infer)\n", (double)total / run_s,
+            stats.mean / batch_stats.mean);
+
+    int ret = 0;
+#ifndef MOTOR_ENGINE_DENSE
+    if (check_registry(second, ds, in, main_ref) != 0) {
+        fprintf(stderr, "Erro: o registro de modelos mudou saidas\n");
+        ret = 1;
+    }
+#endif
+
+    free(chunk_us);
+    free(batch_out);
+    free(main_ref);
+    free(latency_us);
+    free(in.labels);
+    free(in.features);
+    host_dataset_free(&ds);
+    return ret;
+}
@@ -0,0 +1,59 @@
+// MPU6050 simulado: banco de registradores alimentado pelas amostras dos CSVs
+#ifndef FAKE_MPU6050_H
+#define FAKE_MPU6050_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "hardware/i2c.h"
+#include "host_dataset.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct fake_mpu6050 {
+    uint8_t regs[128];          // banco de registradores do sensor
+    uint8_t reg_ptr;            // ponteiro de registrador (auto-incremento)
+    const host_sample_t *samples;
+    size_t count;
+    size_t cursor;              // próxima amostra a ser entregue
+    _Atomic int current_label;  // nível da última amostra entregue (-1 = nenhuma; lido por outra thread com MOTOR_DUAL_CORE)
+    void (*on_exhausted)(void); // chamado quando as amostras acabam (NULL = recomeça)
+    void (*on_sample)(struct fake_mpu6050 *dev, const host_sample_t *s); // chamado a cada amostra entregue (NULL = nada)
+    // Amostras do sensor por linha dos CSVs (0 ou 1 = uma linha por amostra): com o sensor
+    // sobreamostrado (MOTOR_SENSOR_FILTER) cada linha de 100 Hz é repetida, o sinal não acelera
+    uint32_t hold;
+    uint32_t held;              // repetições que faltam da linha atual
+
+    // FIFO: com USER_CTRL.FIFO_EN o sensor grava uma amostra a cada período de amostragem
+    // (SMPLRT_DIV/CONFIG) do tempo virtual dos sleeps, como o MPU6050 real faz sozinho
+    uint8_t fifo[1024];
+    size_t fifo_head;           // próximo byte a ser lido
+    size_t fifo_count;          // bytes na FIFO
+    uint64_t fifo_next_ns;      // instante (virtual) da próxima amostra
+    uint32_t fifo_frames;       // frames gravados desde o início
+    uint32_t fifo_overflows;    // vezes em que a FIFO encheu e perdeu dados
+
+    // Pino INT: com INT_ENABLE.DATA_RDY_EN, um pulso por período de amostragem do tempo virtual
+    uint64_t drdy_next_us;      // instante (virtual) do próximo pulso
+    uint32_t drdy_pulses;       // pulsos entregues desde o início
+} fake_mpu6050_t;
+
+// Inicializa o sensor simulado com as amostras (não copia o vetor)
+void fake_mpu6050_init(fake_mpu6050_t *dev, const host_sample_t *samples, size_t count);
+
+// Conecta o sensor no barramento e endereço dados
+void fake_mpu6050_attach(fake_mpu6050_t *dev, i2c_inst_t *i2c, uint8_t addr);
+
+// Liga o pino INT do sensor ao GPIO gpio (host_gpio_attach_source)
+void fake_mpu6050_connect_int(fake_mpu6050_t *dev, unsigned int gpio);
+
+// Converte uma amostra física para os registradores brutos 0x3B..0x48
+// (inverso da conversão feita em mpu6050_read_data)
+void fake_mpu6050_encode(const host_sample_t *s, uint8_t out[14]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FAKE_MPU6050_H
@@ -0,0 +1,44 @@
+// SSD1306 simulado: interpreta os comandos de endereçamento e captura a GDDRAM
+#ifndef FAKE_SSD1306_H
+#define FAKE_SSD1306_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "hardware/i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FAKE_SSD1306_WIDTH 128
+#define FAKE_SSD1306_PAGES 8
+
+typedef struct fake_ssd1306 {
+    uint8_t gddram[FAKE_SSD1306_PAGES][FAKE_SSD1306_WIDTH];
+    uint8_t col_start, col_end, col;    // janela de colunas (cmd 0x21)
+    uint8_t page_start, page_end, page; // janela de páginas (cmd 0x22)
+    uint8_t pending_cmd;                // comando aguardando argumentos
+    uint8_t pending_args;
+    uint8_t args[2];
+    bool display_on;
+    uint32_t frames;                    // janelas de colunas/páginas preenchidas (quadros enviados)
+    uint32_t transfers;                 // transações de dados recebidas
+    uint64_t data_bytes;                // bytes de GDDRAM recebidos
+    void (*on_frame)(struct fake_ssd1306 *dev); // chamado ao fim de cada quadro
+} fake_ssd1306_t;
+
+void fake_ssd1306_init(fake_ssd1306_t *dev);
+void fake_ssd1306_attach(fake_ssd1306_t *dev, i2c_inst_t *i2c, uint8_t addr);
+
+// Lê um pixel da GDDRAM capturada
+bool fake_ssd1306_pixel(const fake_ssd1306_t *dev, int x, int y);
+
+// Grava a GDDRAM como imagem PBM (P1) de 128x64
+void fake_ssd1306_write_pbm(const fake_ssd1306_t *dev, FILE *f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FAKE_SSD1306_H
@@ -0,0 +1,36 @@
+// Shim do hardware/flash.h para o build host (Linux)
+// A flash QSPI é um vetor na RAM (host_flash.c) que imita a NOR: apagar deixa 0xFF, gravar só
+// leva bits de 1 para 0 e os endereços precisam respeitar setor/página (senão o programa aborta)
+// O XIP_BASE aponta para o vetor, então o firmware lê a flash por ponteiro como no RP2040
+#ifndef HOST_HARDWARE_FLASH_H
+#define HOST_HARDWARE_FLASH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+
+// Mesma flash do Pico W (W25Q16JV, 2 MB)
+#ifndef PICO_FLASH_SIZE_BYTES
+#define PICO_FLASH_SIZE_BYTES (2u * 1024u * 1024u)
+#endif
+
+extern uint8_t host_flash_contents[PICO_FLASH_SIZE_BYTES];
+#define XIP_BASE ((uintptr_t)host_flash_contents)
+
+// flash_offs e count múltiplos de FLASH_SECTOR_SIZE
+void flash_range_erase(uint32_t flash_offs, size_t count);
+
+// flash_offs e count múltiplos de FLASH_PAGE_SIZE
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_HARDWARE_FLASH_H
@@ -0,0 +1,33 @@
+// Utilitários de medição para os benchmarks e o harness do build host
+#ifndef HOST_BENCH_H
+#define HOST_BENCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    double min, median, p99, max, mean;
+    size_t n;
+} host_stats_t;
+
+// Relógio monotônico real em nanossegundos (não inclui o tempo virtual dos sleeps)
+uint64_t host_now_ns(void);
+
+// Contador de ciclos do host (TSC no x86; nas outras arquiteturas, o mesmo que host_now_ns)
+uint64_t host_now_cycles(void);
+
+// Calcula min/mediana/p99/max/média (ordena o vetor no lugar)
+host_stats_t host_stats_compute(double *values, size_t n);
+
+// Imprime uma linha de estatísticas em stderr
+void host_stats_print(const char *name, const char *unit, const host_stats_t *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_BENCH_H
@@ -0,0 +1,38 @@
+// Carregamento dos CSVs de data/nivel*.csv para o build host
+#ifndef HOST_DATASET_H
+#define HOST_DATASET_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HOST_NUM_LEVELS 4
+
+// Uma linha do CSV: Acel_X..Z (m/s²), Giro_X..Z (°/s), Temperatura (°C) e o nível de origem
+typedef struct {
+    float features[6];
+    float temp_c;
+    int label;
+} host_sample_t;
+
+typedef struct {
+    host_sample_t *samples;
+    size_t count;
+} host_dataset_t;
+
+// Diretório dos CSVs: variável de ambiente MOTOR_HOST_DATA_DIR ou o data/ do repositório
+const char *host_data_dir(void);
+
+// Carrega nivel0.csv..nivel3.csv em sequência (max_per_level = 0 carrega tudo)
+// Retorna 0 em caso de sucesso
+int host_dataset_load_levels(host_dataset_t *ds, const char *data_dir, size_t max_per_level);
+
+void host_dataset_free(host_dataset_t *ds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_DATASET_H
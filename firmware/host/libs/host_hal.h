@@ -0,0 +1,100 @@
+// Camada de simulação do HAL para rodar o firmware no Linux
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hardware/i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Dispositivo I2C simulado: recebe as escritas e atende as leituras de um endereço
+typedef struct {
+    void *ctx;
+    int (*write)(void *ctx, const uint8_t *src, size_t len);
+    int (*read)(void *ctx, uint8_t *dst, size_t len);
+} host_i2c_device_t;
+
+// Estatísticas de tráfego de um barramento
+typedef struct {
+    uint32_t transactions;
+    uint64_t bytes;
+} host_i2c_stats_t;
+
+// Registra um dispositivo simulado em (porta, endereço)
+void host_i2c_attach(i2c_inst_t *i2c, uint8_t addr, const host_i2c_device_t *dev);
+
+// Trava todos os barramentos I2C simulados (recursiva); os i2c_*_blocking já a usam
+void host_bus_lock(void);
+void host_bus_unlock(void);
+
+// Lê as estatísticas de tráfego da porta
+host_i2c_stats_t host_i2c_get_stats(const i2c_inst_t *i2c);
+
+// Estima o tempo de barramento (us) para o tráfego dado na velocidade configurada
+// Cada byte custa 9 bits (8 + ACK) e cada transação mais um byte de endereço
+uint64_t host_i2c_bus_time_us(const i2c_inst_t *i2c, const host_i2c_stats_t *stats);
+
+// Transferências do i2c_dma.h simuladas (host_i2c_dma.c)
+// Escritas contam em transfers/bytes, mas são síncronas: não somam tempo de barramento
+typedef struct {
+    uint32_t transfers;
+    uint64_t bytes;
+    uint64_t bus_us;      // tempo de barramento das leituras
+    uint64_t stalled_us;  // parte desse tempo em que a CPU esperou no i2c_dma_read_finish
+} host_i2c_dma_stats_t;
+
+// Valor escrito em dst enquanto a transferência simulada não terminou
+#define HOST_I2C_DMA_POISON 0xA5
+
+host_i2c_dma_stats_t host_i2c_dma_get_stats(const i2c_inst_t *i2c);
+
+// Flash QSPI simulada (host_flash.c): tempos típicos da W25Q16JV, somados ao relógio do host
+#define HOST_FLASH_ERASE_US 45000u  // setor de 4 KB
+#define HOST_FLASH_PAGE_US  400u    // página de 256 bytes
+
+typedef struct {
+    uint32_t sector_erases;
+    uint32_t max_sector_erases;  // desgaste do setor mais apagado
+    uint32_t pages_programmed;
+    uint64_t busy_us;            // tempo com a flash ocupada (CPU parada no RP2040)
+} host_flash_stats_t;
+
+host_flash_stats_t host_flash_get_stats(void);
+
+// Carrega/salva a flash inteira (PICO_FLASH_SIZE_BYTES); o load deixa apagado o que faltar no arquivo
+bool host_flash_load(const char *path);
+bool host_flash_save(const char *path);
+
+// Fonte de bordas de subida num GPIO (ex: pino INT do MPU6050 simulado)
+// next_edge_us: instante da próxima borda no relógio de host_slept_us (UINT64_MAX: nenhuma)
+// edge_done: a borda foi entregue, passa para a seguinte
+typedef struct {
+    void *ctx;
+    uint64_t (*next_edge_us)(void *ctx);
+    void (*edge_done)(void *ctx);
+} host_gpio_source_t;
+
+// Liga a fonte ao GPIO; as bordas só chegam enquanto o firmware espera em best_effort_wfe_or_timeout
+// (as que passaram com o core ocupado são entregues todas na espera seguinte)
+void host_gpio_attach_source(unsigned int gpio, const host_gpio_source_t *src);
+
+// Tempo virtual acumulado pelos sleep_ms/sleep_us (o relógio do sensor simulado)
+// Com escala de tempo é o próprio relógio escalado
+uint64_t host_slept_us(void);
+
+// 0 (padrão): sleeps não bloqueiam, só avançam o relógio virtual
+// scale > 0: o relógio é o tempo real multiplicado por scale e cada sleep dorme de verdade
+// us / scale (ex: 100 -> 100x mais rápido que o tempo real). Necessário com MOTOR_DUAL_CORE: as
+// threads dividem o mesmo relógio e uma que dorme não corre na frente das outras. O tempo de CPU
+// também aparece multiplicado por scale
+void host_set_time_scale(uint32_t scale);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_HAL_H
@@ -0,0 +1,27 @@
+// Shim do pico/flash.h para o build host (Linux)
+// No RP2040 o flash_safe_execute desliga as interrupções e para o outro core enquanto a flash
+// (e o XIP) está ocupada; no host só chama a função
+#ifndef HOST_PICO_FLASH_H
+#define HOST_PICO_FLASH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef PICO_OK
+#define PICO_OK 0
+#endif
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms);
+
+// Chamada pelo outro core para aceitar ser parado pelo flash_safe_execute
+bool flash_safe_execute_core_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_PICO_FLASH_H
@@ -0,0 +1,17 @@
+// Shim do pico/multicore.h para o build host (Linux)
+// O core 1 é uma thread; o core 0 é a thread do main()
+#ifndef HOST_PICO_MULTICORE_H
+#define HOST_PICO_MULTICORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Roda entry numa thread separada (uma só, como no RP2040)
+void multicore_launch_core1(void (*entry)(void));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_PICO_MULTICORE_H
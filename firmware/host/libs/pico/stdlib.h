@@ -0,0 +1,66 @@
+// Shim do pico/stdlib.h para o build host (Linux)
+// Implementa apenas o subconjunto do Pico SDK usado pelo firmware
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Funções de GPIO (sem efeito no host)
+enum gpio_function {
+    GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_SIO = 5,
+};
+
+void gpio_set_function(unsigned int gpio, enum gpio_function fn);
+void gpio_pull_up(unsigned int gpio);
+void gpio_pull_down(unsigned int gpio);
+void gpio_init(unsigned int gpio);
+#define GPIO_IN  false
+#define GPIO_OUT true
+void gpio_set_dir(unsigned int gpio, bool out);
+
+// Interrupção de GPIO: as bordas vêm das fontes simuladas (host_gpio_attach_source) e o callback
+// roda na thread que espera em best_effort_wfe_or_timeout, como no core que registrou a interrupção
+enum gpio_irq_level {
+    GPIO_IRQ_LEVEL_LOW = 0x1u,
+    GPIO_IRQ_LEVEL_HIGH = 0x2u,
+    GPIO_IRQ_EDGE_FALL = 0x4u,
+    GPIO_IRQ_EDGE_RISE = 0x8u,
+};
+typedef void (*gpio_irq_callback_t)(unsigned int gpio, uint32_t event_mask);
+void gpio_set_irq_enabled_with_callback(unsigned int gpio, uint32_t event_mask, bool enabled,
+                                        gpio_irq_callback_t callback);
+
+// stdio: no host o printf já vai direto pro terminal
+bool stdio_init_all(void);
+// Escreve len bytes de uma vez (sem tradução de \n com cr_translation = false) em stdout
+int stdio_put_string(const char *s, int len, bool newline, bool cr_translation);
+
+// Tempo: relógio monotônico real + tempo "dormido" virtual
+// sleep_ms/sleep_us não bloqueiam, só avançam o relógio virtual
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+void sleep_ms(uint32_t ms);
+void sleep_us(uint64_t us);
+void tight_loop_contents(void);
+
+typedef uint64_t absolute_time_t;
+static inline absolute_time_t from_us_since_boot(uint64_t us) {
+    return us;
+}
+// WFE até timeout_timestamp (time_us_64): avança o relógio até a próxima borda de GPIO simulada,
+// se vier antes, e roda o callback da interrupção. true se o prazo chegou
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_PICO_STDLIB_H
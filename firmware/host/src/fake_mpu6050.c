@@ -0,0 +1,223 @@
+#include "fake_mpu6050.h"
+#include "host_hal.h"
+#include <math.h>
+#include <string.h>
+
+// Registradores usados pelo driver
+#define REG_SMPLRT_DIV   0x19
+#define REG_CONFIG       0x1A
+#define REG_FIFO_EN      0x23
+#define REG_INT_ENABLE   0x38
+#define REG_INT_STATUS   0x3A
+#define REG_ACCEL_XOUT_H 0x3B
+#define REG_USER_CTRL    0x6A
+#define REG_PWR_MGMT_1   0x6B
+#define REG_FIFO_COUNT_H 0x72
+#define REG_FIFO_COUNT_L 0x73
+#define REG_FIFO_R_W     0x74
+#define REG_WHO_AM_I     0x75
+
+#define USER_CTRL_FIFO_EN    0x40
+#define USER_CTRL_FIFO_RESET 0x04
+#define INT_STATUS_FIFO_OFLOW 0x10
+#define INT_ENABLE_DATA_RDY   0x01
+
+// Mesmas constantes do driver (mpu6050.c)
+#define ACCEL_SENSITIVITY 16384.0f
+#define GYRO_SENSITIVITY  131.0f
+#define GRAVITY_MS2       9.81f
+
+static int16_t to_raw(float value) {
+    float r = roundf(value);
+    if (r > 32767.0f) r = 32767.0f;
+    if (r < -32768.0f) r = -32768.0f;
+    return (int16_t)r;
+}
+
+static void put_be16(uint8_t *dst, int16_t v) {
+    dst[0] = (uint8_t)((uint16_t)v >> 8);
+    dst[1] = (uint8_t)((uint16_t)v & 0xFF);
+}
+
+void fake_mpu6050_encode(const host_sample_t *s, uint8_t out[14]) {
+    for (int i = 0; i < 3; i++) {
+        put_be16(&out[i * 2], to_raw(s->features[i] / GRAVITY_MS2 * ACCEL_SENSITIVITY));
+        put_be16(&out[8 + i * 2], to_raw(s->features[3 + i] * GYRO_SENSITIVITY));
+    }
+    // Inverso de temp_c = raw/340 + 36.53 - 24.0
+    put_be16(&out[6], to_raw((s->temp_c - 36.53f + 24.0f) * 340.0f));
+}
+
+static void reset_registers(fake_mpu6050_t *dev) {
+    memset(dev->regs, 0, sizeof(dev->regs));
+    dev->regs[REG_PWR_MGMT_1] = 0x40; // sai do reset em modo sleep
+    dev->regs[REG_WHO_AM_I] = 0x68;
+}
+
+// Carrega a próxima amostra nos registradores de saída (ou repete a atual, com hold)
+static void latch_next_sample(fake_mpu6050_t *dev) {
+    if (dev->count == 0) return;
+    if (dev->held) {
+        dev->held--;
+        return;
+    }
+    if (dev->cursor >= dev->count) {
+        if (dev->on_exhausted) dev->on_exhausted();
+        dev->cursor = 0;
+    }
+    const host_sample_t *s = &dev->samples[dev->cursor++];
+    if (dev->hold > 1) dev->held = dev->hold - 1;
+    fake_mpu6050_encode(s, &dev->regs[REG_ACCEL_XOUT_H]);
+    dev->current_label = s->label;
+    if (dev->on_sample) dev->on_sample(dev, s);
+}
+
+static void fifo_clear(fake_mpu6050_t *dev) {
+    dev->fifo_head = 0;
+    dev->fifo_count = 0;
+}
+
+// Período de amostragem em ns: 8 kHz sem DLPF (CONFIG 0 ou 7), 1 kHz com, dividido por 1 + SMPLRT_DIV
+static uint64_t fifo_period_ns(const fake_mpu6050_t *dev) {
+    uint8_t dlpf = dev->regs[REG_CONFIG] & 0x07;
+    uint64_t base_ns = (dlpf == 0 || dlpf == 7) ? 125000u : 1000000u;
+    return base_ns * (1u + dev->regs[REG_SMPLRT_DIV]);
+}
+
+static bool fifo_enabled(const fake_mpu6050_t *dev) {
+    return (dev->regs[REG_USER_CTRL] & USER_CTRL_FIFO_EN) && dev->regs[REG_FIFO_EN];
+}
+
+// Grava uma amostra na FIFO com os campos habilitados em FIFO_EN, na ordem do datasheet
+// (aceleração, temperatura, giroscópio X/Y/Z); cheia, sobrescreve os bytes mais antigos
+static void fifo_push_sample(fake_mpu6050_t *dev) {
+    latch_next_sample(dev);
+    const uint8_t *r = &dev->regs[REG_ACCEL_XOUT_H];
+    const uint8_t en = dev->regs[REG_FIFO_EN];
+    uint8_t frame[14];
+    size_t n = 0;
+    if (en & 0x08) { memcpy(frame + n, r, 6); n += 6; }      // ACCEL
+    if (en & 0x80) { memcpy(frame + n, r + 6, 2); n += 2; }  // TEMP
+    if (en & 0x40) { memcpy(frame + n, r + 8, 2); n += 2; }  // XG
+    if (en & 0x20) { memcpy(frame + n, r + 10, 2); n += 2; } // YG
+    if (en & 0x10) { memcpy(frame + n, r + 12, 2); n += 2; } // ZG
+
+    const size_t size = sizeof(dev->fifo);
+    for (size_t i = 0; i < n; i++) {
+        if (dev->fifo_count == size) {
+            dev->fifo_head = (dev->fifo_head + 1) % size;
+            dev->fifo_count--;
+            if (!(dev->regs[REG_INT_STATUS] & INT_STATUS_FIFO_OFLOW)) dev->fifo_overflows++;
+            dev->regs[REG_INT_STATUS] |= INT_STATUS_FIFO_OFLOW;
+        }
+        dev->fifo[(dev->fifo_head + dev->fifo_count) % size] = frame[i];
+        dev->fifo_count++;
+    }
+    dev->fifo_frames++;
+}
+
+// Gera as amostras que o sensor teria gravado até o tempo virtual atual
+static void fifo_update(fake_mpu6050_t *dev) {
+    if (!fifo_enabled(dev)) return;
+    const uint64_t now_ns = host_slept_us() * 1000u;
+    const uint64_t period = fifo_period_ns(dev);
+    while (dev->fifo_next_ns <= now_ns) {
+        fifo_push_sample(dev);
+        dev->fifo_next_ns += period;
+    }
+}
+
+static int fake_write(void *ctx, const uint8_t *src, size_t len) {
+    fake_mpu6050_t *dev = (fake_mpu6050_t *)ctx;
+    if (len == 0) return 0;
+
+    dev->reg_ptr = src[0] & 0x7F;
+    for (size_t i = 1; i < len; i++) {
+        uint8_t reg = dev->reg_ptr;
+        dev->regs[reg] = src[i];
+        if (reg == REG_PWR_MGMT_1 && (src[i] & 0x80)) {
+            reset_registers(dev);
+            fifo_clear(dev);
+        }
+        if (reg == REG_USER_CTRL) {
+            // FIFO_RESET se limpa sozinho; a primeira amostra sai um período depois de ligar
+            if (src[i] & USER_CTRL_FIFO_RESET) fifo_clear(dev);
+            dev->regs[reg] &= (uint8_t)~USER_CTRL_FIFO_RESET;
+            dev->fifo_next_ns = host_slept_us() * 1000u + fifo_period_ns(dev);
+        }
+        if (reg == REG_INT_ENABLE) {
+            // O primeiro pulso sai um período depois de ligar
+            dev->drdy_next_us = host_slept_us() + fifo_period_ns(dev) / 1000u;
+        }
+        dev->reg_ptr = (reg + 1) & 0x7F;
+    }
+    return (int)len;
+}
+
+static int fake_read(void *ctx, uint8_t *dst, size_t len) {
+    fake_mpu6050_t *dev = (fake_mpu6050_t *)ctx;
+
+    // Uma leitura em rajada que começa nos registradores de dados (ACCEL_XOUT_H..GYRO_ZOUT_L, o
+    // driver lê só o trecho dos canais escolhidos) representa uma nova amostra
+    // (com a FIFO ligada os registradores só mudam no ritmo da amostragem)
+    fifo_update(dev);
+    if (dev->reg_ptr >= REG_ACCEL_XOUT_H && dev->reg_ptr < REG_ACCEL_XOUT_H + 14 && !fifo_enabled(dev)) {
+        latch_next_sample(dev);
+    }
+
+    // FIFO_COUNT é o número de bytes disponíveis no momento da leitura
+    dev->regs[REG_FIFO_COUNT_H] = (uint8_t)(dev->fifo_count >> 8);
+    dev->regs[REG_FIFO_COUNT_L] = (uint8_t)(dev->fifo_count & 0xFF);
+
+    for (size_t i = 0; i < len; i++) {
+        if (dev->reg_ptr == REG_FIFO_R_W) {
+            // Leituras de FIFO_R_W não avançam o ponteiro: cada byte sai da FIFO (vazia = 0)
+            dst[i] = 0;
+            if (dev->fifo_count) {
+                dst[i] = dev->fifo[dev->fifo_head];
+                dev->fifo_head = (dev->fifo_head + 1) % sizeof(dev->fifo);
+                dev->fifo_count--;
+            }
+            continue;
+        }
+        dst[i] = dev->regs[dev->reg_ptr];
+        // INT_STATUS é limpo na leitura
+        if (dev->reg_ptr == REG_INT_STATUS) dev->regs[REG_INT_STATUS] = 0;
+        dev->reg_ptr = (dev->reg_ptr + 1) & 0x7F;
+    }
+    return (int)len;
+}
+
+void fake_mpu6050_init(fake_mpu6050_t *dev, const host_sample_t *samples, size_t count) {
+    memset(dev, 0, sizeof(*dev));
+    dev->samples = samples;
+    dev->count = count;
+    dev->current_label = -1;
+    reset_registers(dev);
+}
+
+static uint64_t drdy_next_edge(void *ctx) {
+    fake_mpu6050_t *dev = (fake_mpu6050_t *)ctx;
+    host_bus_lock();
+    uint64_t next = (dev->regs[REG_INT_ENABLE] & INT_ENABLE_DATA_RDY) ? dev->drdy_next_us : UINT64_MAX;
+    host_bus_unlock();
+    return next;
+}
+
+static void drdy_edge_done(void *ctx) {
+    fake_mpu6050_t *dev = (fake_mpu6050_t *)ctx;
+    host_bus_lock();
+    dev->drdy_next_us += fifo_period_ns(dev) / 1000u;
+    dev->drdy_pulses++;
+    host_bus_unlock();
+}
+
+void fake_mpu6050_connect_int(fake_mpu6050_t *dev, unsigned int gpio) {
+    host_gpio_source_t src = {dev, drdy_next_edge, drdy_edge_done};
+    host_gpio_attach_source(gpio, &src);
+}
+
+void fake_mpu6050_attach(fake_mpu6050_t *dev, i2c_inst_t *i2c, uint8_t addr) {
+    host_i2c_device_t bus_dev = {dev, fake_write, fake_read};
+    host_i2c_attach(i2c, addr, &bus_dev);
+}
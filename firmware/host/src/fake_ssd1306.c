@@ -0,0 +1,127 @@
+#include "fake_ssd1306.h"
+#include "host_hal.h"
+#include <string.h>
+
+// Prefixos de controle (byte após o endereço)
+#define CTRL_COMMAND 0x00
+#define CTRL_DATA    0x40
+
+// Número de argumentos de cada comando com parâmetros
+static uint8_t command_args(uint8_t cmd) {
+    switch (cmd) {
+        case 0x21: // endereço de coluna
+        case 0x22: // endereço de página
+            return 2;
+        case 0x20: // modo de memória
+        case 0x81: // contraste
+        case 0x8D: // charge pump
+        case 0xA8: // multiplexação
+        case 0xD3: // deslocamento
+        case 0xD5: // clock
+        case 0xD9: // pré-carga
+        case 0xDA: // pinos COM
+        case 0xDB: // VCOMH
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static void execute_command(fake_ssd1306_t *dev, uint8_t cmd) {
+    switch (cmd) {
+        case 0x21:
+            dev->col_start = dev->args[0] & 0x7F;
+            dev->col_end = dev->args[1] & 0x7F;
+            dev->col = dev->col_start;
+            break;
+        case 0x22:
+            dev->page_start = dev->args[0] & 0x07;
+            dev->page_end = dev->args[1] & 0x07;
+            dev->page = dev->page_start;
+            break;
+        case 0xAE:
+            dev->display_on = false;
+            break;
+        case 0xAF:
+            dev->display_on = true;
+            break;
+        default:
+            break;
+    }
+}
+
+static void command_byte(fake_ssd1306_t *dev, uint8_t byte) {
+    if (dev->pending_args) {
+        uint8_t n = command_args(dev->pending_cmd);
+        dev->args[n - dev->pending_args] = byte;
+        if (--dev->pending_args == 0) execute_command(dev, dev->pending_cmd);
+        return;
+    }
+    dev->pending_cmd = byte;
+    dev->pending_args = command_args(byte);
+    if (dev->pending_args == 0) execute_command(dev, byte);
+}
+
+// Escrita na GDDRAM em modo de endereçamento horizontal
+// Retorna true quando o ponteiro volta ao início da janela (a janela inteira foi escrita)
+static bool data_byte(fake_ssd1306_t *dev, uint8_t byte) {
+    dev->gddram[dev->page][dev->col] = byte;
+    if (dev->col < dev->col_end) {
+        dev->col++;
+        return false;
+    }
+    dev->col = dev->col_start;
+    if (dev->page < dev->page_end) {
+        dev->page++;
+        return false;
+    }
+    dev->page = dev->page_start;
+    return true;
+}
+
+static int fake_write(void *ctx, const uint8_t *src, size_t len) {
+    fake_ssd1306_t *dev = (fake_ssd1306_t *)ctx;
+    if (len == 0) return 0;
+
+    if (src[0] == CTRL_DATA) {
+        // Um envio parcial pode vir em várias transações (uma por página): o quadro termina
+        // quando a janela de colunas/páginas foi preenchida
+        bool wrapped = false;
+        for (size_t i = 1; i < len; i++) wrapped |= data_byte(dev, src[i]);
+        dev->transfers++;
+        dev->data_bytes += len - 1;
+        if (wrapped) {
+            dev->frames++;
+            if (dev->on_frame) dev->on_frame(dev);
+        }
+    } else {
+        for (size_t i = 1; i < len; i++) command_byte(dev, src[i]);
+    }
+    return (int)len;
+}
+
+void fake_ssd1306_init(fake_ssd1306_t *dev) {
+    memset(dev, 0, sizeof(*dev));
+    dev->col_end = FAKE_SSD1306_WIDTH - 1;
+    dev->page_end = FAKE_SSD1306_PAGES - 1;
+}
+
+void fake_ssd1306_attach(fake_ssd1306_t *dev, i2c_inst_t *i2c, uint8_t addr) {
+    host_i2c_device_t bus_dev = {dev, fake_write, NULL};
+    host_i2c_attach(i2c, addr, &bus_dev);
+}
+
+bool fake_ssd1306_pixel(const fake_ssd1306_t *dev, int x, int y) {
+    if (x < 0 || x >= FAKE_SSD1306_WIDTH || y < 0 || y >= FAKE_SSD1306_PAGES * 8) return false;
+    return (dev->gddram[y / 8][x] >> (y % 8)) & 0x01;
+}
+
+void fake_ssd1306_write_pbm(const fake_ssd1306_t *dev, FILE *f) {
+    fprintf(f, "P1\n%d %d\n", FAKE_SSD1306_WIDTH, FAKE_SSD1306_PAGES * 8);
+    for (int y = 0; y < FAKE_SSD1306_PAGES * 8; y++) {
+        for (int x = 0; x < FAKE_SSD1306_WIDTH; x++) {
+            fputc(fake_ssd1306_pixel(dev, x, y) ? '1' : '0', f);
+        }
+        fputc('\n', f);
+    }
+}
@@ -0,0 +1,50 @@
+#define _POSIX_C_SOURCE 199309L
+#include "host_bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+uint64_t host_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t host_now_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return host_now_ns();
+#endif
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+host_stats_t host_stats_compute(double *values, size_t n) {
+    host_stats_t s = {0};
+    s.n = n;
+    if (n == 0) return s;
+
+    qsort(values, n, sizeof(double), cmp_double);
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) sum += values[i];
+
+    s.min = values[0];
+    s.median = values[n / 2];
+    s.p99 = values[(n * 99) / 100];
+    s.max = values[n - 1];
+    s.mean = sum / (double)n;
+    return s;
+}
+
+void host_stats_print(const char *name, const char *unit, const host_stats_t *s) {
+    if (s->n == 0) return;
+    fprintf(stderr, "%-14s min %9.2f %s | mediana %9.2f %s | p99 %9.2f %s | max %9.2f %s | media %9.2f %s\n",
+            name, s->min, unit, s->median, unit, s->p99, unit, s->max, unit, s->mean, unit);
+}
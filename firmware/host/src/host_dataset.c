@@ -0,0 +1,81 @@
+#include "host_dataset.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef MOTOR_HOST_DEFAULT_DATA_DIR
+#define MOTOR_HOST_DEFAULT_DATA_DIR "data"
+#endif
+
+const char *host_data_dir(void) {
+    const char *dir = getenv("MOTOR_HOST_DATA_DIR");
+    return (dir && *dir) ? dir : MOTOR_HOST_DEFAULT_DATA_DIR;
+}
+
+// Acrescenta as linhas de um CSV ao dataset
+static int load_csv(host_dataset_t *ds, size_t *capacity, const char *path, int label, size_t max_rows) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "Erro: nao conseguiu abrir %s\n", path);
+        return -1;
+    }
+
+    char line[256];
+    size_t rows = 0;
+
+    // Pula o cabeçalho (Amostra,Acel_X,...,Temperatura)
+    if (!fgets(line, sizeof(line), f)) {
+        fclose(f);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        if (max_rows && rows >= max_rows) break;
+
+        host_sample_t s;
+        int index;
+        if (sscanf(line, "%d,%f,%f,%f,%f,%f,%f,%f", &index,
+                   &s.features[0], &s.features[1], &s.features[2],
+                   &s.features[3], &s.features[4], &s.features[5], &s.temp_c) != 8) {
+            continue;
+        }
+        s.label = label;
+
+        if (ds->count == *capacity) {
+            size_t new_capacity = *capacity ? *capacity * 2 : 1024;
+            host_sample_t *grown = realloc(ds->samples, new_capacity * sizeof(host_sample_t));
+            if (!grown) {
+                fclose(f);
+                return -1;
+            }
+            ds->samples = grown;
+            *capacity = new_capacity;
+        }
+        ds->samples[ds->count++] = s;
+        rows++;
+    }
+
+    fclose(f);
+    return 0;
+}
+
+int host_dataset_load_levels(host_dataset_t *ds, const char *data_dir, size_t max_per_level) {
+    size_t capacity = 0;
+    ds->samples = NULL;
+    ds->count = 0;
+
+    for (int level = 0; level < HOST_NUM_LEVELS; level++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/nivel%d.csv", data_dir, level);
+        if (load_csv(ds, &capacity, path, level, max_per_level) != 0) {
+            host_dataset_free(ds);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void host_dataset_free(host_dataset_t *ds) {
+    free(ds->samples);
+    ds->samples = NULL;
+    ds->count = 0;
+}
@@ -0,0 +1,103 @@
+// Flash QSPI simulada no host (hardware/flash.h e pico/flash.h)
+// Apagar e gravar seguem as regras da NOR e custam o tempo típico da W25Q16JV no relógio do host,
+// como a CPU parada do RP2040; o conteúdo pode ser carregado/salvo num arquivo entre execuções
+#include "host_hal.h"
+#include "hardware/flash.h"
+#include "pico/flash.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FLASH_SECTORS (PICO_FLASH_SIZE_BYTES / FLASH_SECTOR_SIZE)
+
+uint8_t host_flash_contents[PICO_FLASH_SIZE_BYTES];
+static uint32_t sector_erases[FLASH_SECTORS];
+static host_flash_stats_t flash_stats;
+// O harness salva a flash de outra thread (fim dos CSVs no core 1): não pega uma gravação pela metade
+static pthread_mutex_t flash_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Flash nova: tudo apagado, antes do construtor do harness carregar o arquivo
+__attribute__((constructor(101))) static void flash_blank(void) {
+    memset(host_flash_contents, 0xFF, sizeof(host_flash_contents));
+}
+
+static void check(bool ok, const char *what, uint32_t offset, size_t count) {
+    if (ok) return;
+    fprintf(stderr, "Flash simulada: %s (offset 0x%06x, %zu bytes)\n", what, (unsigned)offset, count);
+    abort();
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    check(flash_offs % FLASH_SECTOR_SIZE == 0 && count % FLASH_SECTOR_SIZE == 0, "apagamento fora do setor",
+          flash_offs, count);
+    check(flash_offs + count <= PICO_FLASH_SIZE_BYTES, "apagamento fora da flash", flash_offs, count);
+
+    pthread_mutex_lock(&flash_lock);
+    memset(host_flash_contents + flash_offs, 0xFF, count);
+    uint32_t sectors = (uint32_t)(count / FLASH_SECTOR_SIZE);
+    for (uint32_t s = flash_offs / FLASH_SECTOR_SIZE; s < flash_offs / FLASH_SECTOR_SIZE + sectors; s++) {
+        if (++sector_erases[s] > flash_stats.max_sector_erases) flash_stats.max_sector_erases = sector_erases[s];
+    }
+    flash_stats.sector_erases += sectors;
+    flash_stats.busy_us += (uint64_t)sectors * HOST_FLASH_ERASE_US;
+    pthread_mutex_unlock(&flash_lock);
+    sleep_us((uint64_t)sectors * HOST_FLASH_ERASE_US);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+    check(flash_offs % FLASH_PAGE_SIZE == 0 && count % FLASH_PAGE_SIZE == 0, "gravacao fora da pagina",
+          flash_offs, count);
+    check(flash_offs + count <= PICO_FLASH_SIZE_BYTES, "gravacao fora da flash", flash_offs, count);
+
+    // A NOR só leva bits de 1 para 0: gravar por cima sem apagar é erro do firmware
+    pthread_mutex_lock(&flash_lock);
+    uint8_t *dst = host_flash_contents + flash_offs;
+    for (size_t i = 0; i < count; i++) {
+        check((dst[i] & data[i]) == data[i], "gravacao sobre bits nao apagados", flash_offs + (uint32_t)i, 1);
+    }
+    memcpy(dst, data, count);
+
+    uint32_t pages = (uint32_t)(count / FLASH_PAGE_SIZE);
+    flash_stats.pages_programmed += pages;
+    flash_stats.busy_us += (uint64_t)pages * HOST_FLASH_PAGE_US;
+    pthread_mutex_unlock(&flash_lock);
+    sleep_us((uint64_t)pages * HOST_FLASH_PAGE_US);
+}
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms) {
+    (void)enter_exit_timeout_ms;
+    func(param);
+    return PICO_OK;
+}
+
+bool flash_safe_execute_core_init(void) {
+    return true;
+}
+
+host_flash_stats_t host_flash_get_stats(void) {
+    pthread_mutex_lock(&flash_lock);
+    host_flash_stats_t s = flash_stats;
+    pthread_mutex_unlock(&flash_lock);
+    return s;
+}
+
+bool host_flash_load(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+    size_t n = fread(host_flash_contents, 1, sizeof(host_flash_contents), f);
+    fclose(f);
+    // Arquivo menor: o resto continua apagado
+    memset(host_flash_contents + n, 0xFF, sizeof(host_flash_contents) - n);
+    return true;
+}
+
+bool host_flash_save(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+    pthread_mutex_lock(&flash_lock);
+    size_t n = fwrite(host_flash_contents, 1, sizeof(host_flash_contents), f);
+    pthread_mutex_unlock(&flash_lock);
+    fclose(f);
+    return n == sizeof(host_flash_contents);
+}
@@ -0,0 +1,260 @@
+#define _POSIX_C_SOURCE 200809L
+#include "host_hal.h"
+#include "pico/multicore.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+i2c_inst_t i2c0_inst = {0, 0};
+i2c_inst_t i2c1_inst = {1, 0};
+
+// Tabela de dispositivos por porta (endereços de 7 bits)
+static host_i2c_device_t devices[2][128];
+static bool attached[2][128];
+static host_i2c_stats_t stats[2];
+
+// Tempo virtual acumulado pelos sleeps (sem escala de tempo; atômico por segurança entre threads)
+static _Atomic uint64_t slept_us;
+
+// --- GPIO / stdio ---
+
+void gpio_set_function(unsigned int gpio, enum gpio_function fn) {
+    (void)gpio;
+    (void)fn;
+}
+
+void gpio_pull_up(unsigned int gpio) {
+    (void)gpio;
+}
+
+void gpio_pull_down(unsigned int gpio) {
+    (void)gpio;
+}
+
+void gpio_init(unsigned int gpio) {
+    (void)gpio;
+}
+
+void gpio_set_dir(unsigned int gpio, bool out) {
+    (void)gpio;
+    (void)out;
+}
+
+// Um callback de interrupção só, do core (thread) que o registrou: como no Pico SDK, as
+// interrupções de GPIO vão para o core que chamou gpio_set_irq_enabled_with_callback
+#define HOST_GPIO_COUNT 30
+static gpio_irq_callback_t gpio_callback;
+static pthread_t gpio_irq_thread;
+static _Atomic bool gpio_irq_registered;
+static uint32_t gpio_rise_enabled;  // bit por GPIO
+static host_gpio_source_t gpio_sources[HOST_GPIO_COUNT];
+
+void gpio_set_irq_enabled_with_callback(unsigned int gpio, uint32_t event_mask, bool enabled,
+                                        gpio_irq_callback_t callback) {
+    if (gpio >= HOST_GPIO_COUNT) return;
+    gpio_callback = callback;
+    gpio_irq_thread = pthread_self();
+    if (enabled && (event_mask & GPIO_IRQ_EDGE_RISE)) {
+        gpio_rise_enabled |= 1u << gpio;
+    } else if (!enabled && (event_mask & GPIO_IRQ_EDGE_RISE)) {
+        gpio_rise_enabled &= ~(1u << gpio);
+    }
+    gpio_irq_registered = true;
+}
+
+void host_gpio_attach_source(unsigned int gpio, const host_gpio_source_t *src) {
+    if (gpio < HOST_GPIO_COUNT) gpio_sources[gpio] = *src;
+}
+
+// Próxima borda entre as fontes com interrupção ligada (UINT64_MAX: nenhuma)
+static uint64_t next_gpio_edge(unsigned int *gpio) {
+    uint64_t next = UINT64_MAX;
+    for (unsigned int g = 0; g < HOST_GPIO_COUNT; g++) {
+        if (!gpio_sources[g].next_edge_us || !(gpio_rise_enabled & (1u << g))) continue;
+        uint64_t at = gpio_sources[g].next_edge_us(gpio_sources[g].ctx);
+        if (at < next) {
+            next = at;
+            *gpio = g;
+        }
+    }
+    return next;
+}
+
+bool stdio_init_all(void) {
+    return true;
+}
+
+int stdio_put_string(const char *s, int len, bool newline, bool cr_translation) {
+    (void)cr_translation;
+    // Um fwrite só: o stdout do glibc trava por chamada, então quadros de dois cores não se misturam
+    fwrite(s, 1, (size_t)len, stdout);
+    if (newline) putchar('\n');
+    return len;
+}
+
+// --- Tempo ---
+
+static uint64_t real_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+// Com escala, todas as threads dividem um relógio só: o tempo real desde o host_set_time_scale
+// multiplicado pela escala (somar os sleeps de dois cores faria o tempo correr em dobro)
+static uint32_t time_scale;
+static uint64_t scale_origin_us;
+
+static uint64_t scaled_us(void) {
+    return (real_us() - scale_origin_us) * time_scale;
+}
+
+uint64_t time_us_64(void) {
+    if (time_scale) return scaled_us();
+    return real_us() + slept_us;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+void host_set_time_scale(uint32_t scale) {
+    scale_origin_us = real_us();
+    time_scale = scale;
+}
+
+void sleep_us(uint64_t us) {
+    if (!time_scale) {
+        slept_us += us;
+        return;
+    }
+    uint64_t ns = us * 1000u / time_scale;
+    struct timespec ts = {(time_t)(ns / 1000000000u), (long)(ns % 1000000000u)};
+    nanosleep(&ts, NULL);
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000u);
+}
+
+void tight_loop_contents(void) {
+}
+
+uint64_t host_slept_us(void) {
+    if (time_scale) return scaled_us();
+    return slept_us;
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp) {
+    uint64_t now = time_us_64();
+    uint64_t remaining = timeout_timestamp > now ? timeout_timestamp - now : 0;
+    unsigned int gpio = 0;
+    bool irq_core = gpio_irq_registered && pthread_equal(pthread_self(), gpio_irq_thread);
+    uint64_t edge = irq_core ? next_gpio_edge(&gpio) : UINT64_MAX;
+    uint64_t sensor_now = host_slept_us();
+
+    if (edge == UINT64_MAX || edge > sensor_now + remaining) {
+        if (remaining) sleep_us(remaining);
+        return true;
+    }
+    if (edge > sensor_now) sleep_us(edge - sensor_now);
+    // Entrega a borda e as que já passaram (a interrupção de cada uma teria rodado)
+    sensor_now = host_slept_us();
+    while (edge != UINT64_MAX && edge <= sensor_now) {
+        gpio_sources[gpio].edge_done(gpio_sources[gpio].ctx);
+        if (gpio_callback) gpio_callback(gpio, GPIO_IRQ_EDGE_RISE);
+        edge = next_gpio_edge(&gpio);
+    }
+    return time_us_64() >= timeout_timestamp;
+}
+
+// --- Multicore ---
+
+static pthread_t core1_thread;
+static void (*core1_entry)(void);
+
+static void *core1_main(void *arg) {
+    (void)arg;
+    core1_entry();
+    return NULL;
+}
+
+void multicore_launch_core1(void (*entry)(void)) {
+    core1_entry = entry;
+    if (pthread_create(&core1_thread, NULL, core1_main, NULL) != 0) {
+        fprintf(stderr, "Erro: nao criou a thread do core 1\n");
+        exit(1);
+    }
+}
+
+// --- I2C ---
+
+uint32_t i2c_init(i2c_inst_t *i2c, uint32_t baudrate) {
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+// Trava dos barramentos (recursiva: o relatório do harness roda dentro de um callback de leitura)
+// Com MOTOR_DUAL_CORE cada core usa a sua porta, mas o relatório lê as estatísticas das duas
+static pthread_mutex_t bus_lock;
+static pthread_once_t bus_lock_once = PTHREAD_ONCE_INIT;
+
+static void bus_lock_init(void) {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&bus_lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+void host_bus_lock(void) {
+    pthread_once(&bus_lock_once, bus_lock_init);
+    pthread_mutex_lock(&bus_lock);
+}
+
+void host_bus_unlock(void) {
+    pthread_mutex_unlock(&bus_lock);
+}
+
+void host_i2c_attach(i2c_inst_t *i2c, uint8_t addr, const host_i2c_device_t *dev) {
+    devices[i2c->id][addr & 0x7F] = *dev;
+    attached[i2c->id][addr & 0x7F] = true;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)nostop;
+    addr &= 0x7F;
+    if (!attached[i2c->id][addr]) return PICO_ERROR_GENERIC; // sem ACK
+    host_bus_lock();
+    stats[i2c->id].transactions++;
+    stats[i2c->id].bytes += len;
+    host_i2c_device_t *dev = &devices[i2c->id][addr];
+    int ret = dev->write ? dev->write(dev->ctx, src, len) : (int)len;
+    host_bus_unlock();
+    return ret;
+}
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+    (void)nostop;
+    addr &= 0x7F;
+    if (!attached[i2c->id][addr]) return PICO_ERROR_GENERIC;
+    host_bus_lock();
+    stats[i2c->id].transactions++;
+    stats[i2c->id].bytes += len;
+    host_i2c_device_t *dev = &devices[i2c->id][addr];
+    int ret = dev->read ? dev->read(dev->ctx, dst, len) : (int)len;
+    host_bus_unlock();
+    return ret;
+}
+
+host_i2c_stats_t host_i2c_get_stats(const i2c_inst_t *i2c) {
+    return stats[i2c->id];
+}
+
+uint64_t host_i2c_bus_time_us(const i2c_inst_t *i2c, const host_i2c_stats_t *s) {
+    uint32_t baud = i2c->baudrate ? i2c->baudrate : 100000u;
+    uint64_t bits = (s->bytes + s->transactions) * 9u;
+    return bits * 1000000u / baud;
+}
@@ -0,0 +1,344 @@
+// Harness do build host: conecta os dispositivos simulados antes do main() do firmware,
+// mede o tflm_infer (via -Wl,--wrap=tflm_infer, --wrap=tflm_infer_frame e --wrap=tflm_infer_batch),
+// confere o nível cru e o filtrado de cada motor (via -Wl,--wrap=prediction_filter_update) e
+// imprime um relatório quando os CSVs acabam
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "host_hal.h"
+#include "host_dataset.h"
+#include "host_bench.h"
+#include "fake_mpu6050.h"
+#include "fake_ssd1306.h"
+#include "prediction_filter.h"
+#ifdef MOTOR_SENSOR_FILTER
+#include "sample_filter.h"
+#endif
+#ifdef MOTOR_FLASH_LOG
+#include "flash_log.h"
+#endif
+
+#ifndef MOTOR_SENSOR_COUNT
+#define MOTOR_SENSOR_COUNT 1
+#endif
+
+// Mesma pinagem/endereços do main.c (SENSOR_SLOTS: um sensor por motor)
+#define HOST_SENSOR_PORT  i2c0
+#define HOST_DISPLAY_PORT i2c1
+#define HOST_DISPLAY_ADDR 0x3C
+#define HOST_SENSOR_INT_GPIO 2
+
+static const struct {
+    i2c_inst_t *port;
+    uint8_t addr;
+} sensor_slots[] = {{i2c0, 0x68}, {i2c0, 0x69}, {i2c1, 0x68}, {i2c1, 0x69}};
+
+static host_dataset_t dataset;
+// Todos os sensores reproduzem os mesmos CSVs, o sensor k a partir de k/MOTOR_SENSOR_COUNT do
+// total (cada motor num nível diferente); o relatório sai quando o sensor 0 chega ao fim
+static fake_mpu6050_t mpus[MOTOR_SENSOR_COUNT];
+static fake_ssd1306_t oled;
+static const char *frame_dir;
+static const char *flash_file;
+
+// Medições por iteração
+static double *infer_us;
+static double *loop_us;
+static size_t measured;
+static uint64_t last_infer_end; // tempo real (ns, sem sleeps) do fim do último tflm_infer
+
+// Acertos de um motor: todo score cru do modelo passa pelo prediction_filter_update do motor
+typedef struct {
+    const prediction_filter_t *filter; // filtro do motor no main.c
+    uint32_t hits[HOST_NUM_LEVELS], totals[HOST_NUM_LEVELS];
+    // Trocas do argmax cru x do nível filtrado (quantas vezes o display mudaria de nível)
+    int last_raw, last_filtered;
+    uint32_t raw_changes, filtered_changes, filtered_hits, filtered_total;
+    // Nível mostrado quando cada amostra foi entregue: mede também as amostras sem inferência
+    uint32_t shown_hits, shown_total, shown_none;
+} motor_report_t;
+
+static motor_report_t reports[MOTOR_SENSOR_COUNT];
+// Com MOTOR_DUAL_CORE o finish roda no core 1 (quem lê o sensor) enquanto o core 0 mede inferências
+static pthread_mutex_t report_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Registra o tempo de uma chamada do modelo (features em float, frame bruto ou lote de motores)
+static void record_infer(uint64_t start, uint64_t end) {
+    pthread_mutex_lock(&report_lock);
+    if (measured < dataset.count) {
+        infer_us[measured] = (double)(end - start) / 1000.0;
+        loop_us[measured] = last_infer_end ? (double)(end - last_infer_end) / 1000.0 : 0.0;
+        measured++;
+    }
+    last_infer_end = end;
+    pthread_mutex_unlock(&report_lock);
+}
+
+int __real_tflm_infer(const float in_features[6], float out_scores[4]);
+
+int __wrap_tflm_infer(const float in_features[6], float out_scores[4]) {
+    uint64_t start = host_now_ns();
+    int ret = __real_tflm_infer(in_features, out_scores);
+    record_infer(start, host_now_ns());
+    return ret;
+}
+
+#ifndef MOTOR_WINDOW_FEATURES
+int __real_tflm_infer_frame(const int16_t accel[3], const int16_t gyro[3], float out_scores[4]);
+
+int __wrap_tflm_infer_frame(const int16_t accel[3], const int16_t gyro[3], float out_scores[4]) {
+    uint64_t start = host_now_ns();
+    int ret = __real_tflm_infer_frame(accel, gyro, out_scores);
+    record_infer(start, host_now_ns());
+    return ret;
+}
+#endif
+
+int __real_tflm_infer_batch(const float *in, float *out, int n);
+
+int __wrap_tflm_infer_batch(const float *in, float *out, int n) {
+    uint64_t start = host_now_ns();
+    int ret = __real_tflm_infer_batch(in, out, n);
+    record_infer(start, host_now_ns());
+    return ret;
+}
+
+// Motor dono do filtro: os motores publicam a primeira previsão na ordem do main.c (todos são
+// classificados na primeira amostra), então o k-ésimo filtro visto é o do motor k
+static int motor_of(const prediction_filter_t *f) {
+    for (int k = 0; k < MOTOR_SENSOR_COUNT; k++) {
+        if (!reports[k].filter) reports[k].filter = f;
+        if (reports[k].filter == f) return k;
+    }
+    return 0;
+}
+
+int __real_prediction_filter_update(prediction_filter_t *f, const float scores[PREDICTION_NUM_CLASSES]);
+
+int __wrap_prediction_filter_update(prediction_filter_t *f, const float scores[PREDICTION_NUM_CLASSES]) {
+    int level = __real_prediction_filter_update(f, scores);
+
+    pthread_mutex_lock(&report_lock);
+    int k = motor_of(f);
+    motor_report_t *r = &reports[k];
+    int best = 0;
+    for (int i = 1; i < PREDICTION_NUM_CLASSES; i++) {
+        if (scores[i] > scores[best]) best = i;
+    }
+    int label = mpus[k].current_label;
+    if (label >= 0 && label < HOST_NUM_LEVELS) {
+        r->totals[label]++;
+        if (best == label) r->hits[label]++;
+        r->filtered_total++;
+        if (level == label) r->filtered_hits++;
+    }
+    if (r->last_raw >= 0 && best != r->last_raw) r->raw_changes++;
+    r->last_raw = best;
+    if (r->last_filtered >= 0 && level != r->last_filtered) r->filtered_changes++;
+    r->last_filtered = level;
+    pthread_mutex_unlock(&report_lock);
+    return level;
+}
+
+// Chamado pelo sensor simulado a cada amostra (no core 1 com MOTOR_DUAL_CORE)
+static void count_shown(fake_mpu6050_t *dev, const host_sample_t *s) {
+    pthread_mutex_lock(&report_lock);
+    motor_report_t *r = &reports[dev - mpus];
+    if (r->last_filtered < 0) {
+        r->shown_none++;
+    } else {
+        r->shown_total++;
+        if (r->last_filtered == s->label) r->shown_hits++;
+    }
+    pthread_mutex_unlock(&report_lock);
+}
+
+// Um barramento inteiro: com MOTOR_SENSOR_COUNT > 2 o i2c1 leva o display e os sensores 2 e 3, então
+// a linha lista os dispositivos ligados nele
+static void print_bus(const char *name, i2c_inst_t *i2c, size_t iterations) {
+    host_i2c_stats_t s = host_i2c_get_stats(i2c);
+    uint64_t bus_us = host_i2c_bus_time_us(i2c, &s);
+    char devices[64] = "";
+    size_t used = 0;
+    for (int k = 0; k < MOTOR_SENSOR_COUNT && used < sizeof(devices); k++) {
+        if (sensor_slots[k].port != i2c) continue;
+        used += (size_t)snprintf(devices + used, sizeof(devices) - used, "%ssensor %d (0x%02x)", used ? ", " : "",
+                                 k, sensor_slots[k].addr);
+    }
+    if (i2c == HOST_DISPLAY_PORT && used < sizeof(devices)) {
+        snprintf(devices + used, sizeof(devices) - used, "%sdisplay (0x%02x)", used ? ", " : "", HOST_DISPLAY_ADDR);
+    }
+    fprintf(stderr, "%-14s %u transacoes, %llu bytes, ~%llu us de barramento/iteracao: %s\n",
+            name, s.transactions, (unsigned long long)s.bytes,
+            (unsigned long long)(iterations ? bus_us / iterations : 0), devices);
+}
+
+// Chamado pelo sensor simulado quando todas as amostras foram entregues
+static void finish(void) {
+    // Não solta: o exit() encerra com o core 0 parado numa das travas
+    pthread_mutex_lock(&report_lock);
+    host_bus_lock();
+    fflush(stdout);
+    fprintf(stderr, "\n--- Relatorio host (%zu amostras) ---\n", measured);
+
+    // Somas de todos os motores
+    motor_report_t all = {0};
+    for (int k = 0; k < MOTOR_SENSOR_COUNT; k++) {
+        const motor_report_t *r = &reports[k];
+        for (int level = 0; level < HOST_NUM_LEVELS; level++) {
+            all.hits[level] += r->hits[level];
+            all.totals[level] += r->totals[level];
+        }
+        all.raw_changes += r->raw_changes;
+        all.filtered_changes += r->filtered_changes;
+        all.filtered_hits += r->filtered_hits;
+        all.filtered_total += r->filtered_total;
+        all.shown_hits += r->shown_hits;
+        all.shown_total += r->shown_total;
+        all.shown_none += r->shown_none;
+    }
+
+    uint32_t all_hits = 0, all_total = 0;
+    for (int level = 0; level < HOST_NUM_LEVELS; level++) {
+        if (all.totals[level] == 0) continue;
+        fprintf(stderr, "Nivel %d: %u/%u corretas (%.1f%%)\n", level, all.hits[level], all.totals[level],
+                100.0 * all.hits[level] / all.totals[level]);
+        all_hits += all.hits[level];
+        all_total += all.totals[level];
+    }
+    if (all_total) {
+        fprintf(stderr, "Acuracia total: %.2f%%\n", 100.0 * all_hits / all_total);
+    }
+    if (all.filtered_total) {
+        // As inferências puladas pelo duty cycle não entram em nenhuma das duas contas
+        fprintf(stderr, "Filtrada: %.2f%% | trocas de nivel: %u cruas, %u filtradas | %u inferencias para %zu amostras\n",
+                100.0 * all.filtered_hits / all.filtered_total, all.raw_changes, all.filtered_changes,
+                all.filtered_total, dataset.count * MOTOR_SENSOR_COUNT);
+    }
+    if (all.shown_total) {
+        // O que o display mostrava a cada amostra: inclui o atraso até a próxima inferência
+        fprintf(stderr, "Nivel mostrado: %.2f%% das amostras (%u antes da primeira previsao)\n",
+                100.0 * all.shown_hits / all.shown_total, all.shown_none);
+    }
+#if MOTOR_SENSOR_COUNT > 1
+    for (int k = 0; k < MOTOR_SENSOR_COUNT; k++) {
+        const motor_report_t *r = &reports[k];
+        uint32_t hits = 0, total = 0;
+        for (int level = 0; level < HOST_NUM_LEVELS; level++) {
+            hits += r->hits[level];
+            total += r->totals[level];
+        }
+        fprintf(stderr, "Motor %d (0x%02x no i2c%d): %.2f%% cru, %.2f%% filtrada, %.2f%% mostrado, %u inferencias\n",
+                k, sensor_slots[k].addr, sensor_slots[k].port == i2c0 ? 0 : 1, total ? 100.0 * hits / total : 0.0,
+                r->filtered_total ? 100.0 * r->filtered_hits / r->filtered_total : 0.0,
+                r->shown_total ? 100.0 * r->shown_hits / r->shown_total : 0.0, r->filtered_total);
+    }
+#endif
+
+    // O primeiro laço não tem iteração anterior para medir
+    host_stats_t infer_stats = host_stats_compute(infer_us, measured);
+    host_stats_t loop_stats = host_stats_compute(loop_us + 1, measured ? measured - 1 : 0);
+    host_stats_print(MOTOR_SENSOR_COUNT > 1 ? "tflm_infer_batch" : "tflm_infer", "us", &infer_stats);
+    host_stats_print("laco", "us", &loop_stats);
+    print_bus("i2c0", i2c0, measured);
+    print_bus("i2c1", i2c1, measured);
+    if (mpus[0].fifo_frames) {
+        host_i2c_stats_t s = host_i2c_get_stats(HOST_SENSOR_PORT);
+        fprintf(stderr, "FIFO sensor    %u amostras, %u overflows, %.2f transacoes i2c/amostra\n",
+                mpus[0].fifo_frames, mpus[0].fifo_overflows, (double)s.transactions / mpus[0].fifo_frames);
+    }
+    host_i2c_dma_stats_t dma = host_i2c_dma_get_stats(HOST_SENSOR_PORT);
+    if (dma.transfers) {
+        // Barramento que correu em paralelo com o firmware (o resto a CPU esperou no finish)
+        fprintf(stderr, "DMA sensor     %u rajadas, %llu bytes, %llu us de barramento, %.1f%% sobreposto\n",
+                dma.transfers, (unsigned long long)dma.bytes, (unsigned long long)dma.bus_us,
+                100.0 * (double)(dma.bus_us - dma.stalled_us) / (double)dma.bus_us);
+    }
+    host_i2c_dma_stats_t oled_dma = host_i2c_dma_get_stats(HOST_DISPLAY_PORT);
+    if (oled_dma.transfers) {
+        fprintf(stderr, "DMA display    %u envios, %llu bytes (sincronos no host)\n", oled_dma.transfers,
+                (unsigned long long)oled_dma.bytes);
+    }
+    fprintf(stderr, "Quadros do display: %u em %u transacoes (%llu bytes de GDDRAM)\n", oled.frames,
+            oled.transfers, (unsigned long long)oled.data_bytes);
+#if defined(MOTOR_FLASH_LOG) && !defined(MOTOR_DUAL_CORE)
+    // Fim da coleta: o setor incompleto também vai para a flash (o finish roda no lado do append e
+    // com um só núcleo o logger está parado aqui; com dois, o service é do core 0 e o resto fica na RAM)
+    flash_log_flush();
+    while (flash_log_service()) {
+    }
+#endif
+    host_flash_stats_t flash = host_flash_get_stats();
+    if (flash.sector_erases || flash.pages_programmed) {
+        fprintf(stderr, "Flash          %u setores apagados (max %u por setor), %u paginas, ~%llu ms ocupada\n",
+                flash.sector_erases, flash.max_sector_erases, flash.pages_programmed,
+                (unsigned long long)(flash.busy_us / 1000));
+    }
+    if (flash_file && *flash_file && !host_flash_save(flash_file)) {
+        fprintf(stderr, "Erro: nao salvou a flash em %s\n", flash_file);
+    }
+
+    free(infer_us);
+    free(loop_us);
+    host_dataset_free(&dataset);
+    exit(0);
+}
+
+static void dump_frame(fake_ssd1306_t *dev) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/frame_%05u.pbm", frame_dir, dev->frames);
+    FILE *f = fopen(path, "w");
+    if (!f) return;
+    fake_ssd1306_write_pbm(dev, f);
+    fclose(f);
+}
+
+__attribute__((constructor))
+static void host_harness_setup(void) {
+    const char *max_env = getenv("MOTOR_HOST_MAX_SAMPLES");
+    size_t max_per_level = max_env ? (size_t)strtoul(max_env, NULL, 10) : 0;
+
+    if (host_dataset_load_levels(&dataset, host_data_dir(), max_per_level) != 0) {
+        fprintf(stderr, "Erro: nao carregou os CSVs de %s (defina MOTOR_HOST_DATA_DIR)\n",
+                host_data_dir());
+        exit(1);
+    }
+    // MOTOR_HOST_TIME_SCALE: sleeps reais de us / escala; no pipeline de dois núcleos o padrão é
+    // 100 (senão o core 1 reproduz os CSVs inteiros antes de o core 0 acordar para classificar)
+    const char *scale_env = getenv("MOTOR_HOST_TIME_SCALE");
+#ifdef MOTOR_DUAL_CORE
+    host_set_time_scale(scale_env ? (uint32_t)strtoul(scale_env, NULL, 10) : 100);
+#else
+    host_set_time_scale(scale_env ? (uint32_t)strtoul(scale_env, NULL, 10) : 0);
+#endif
+    infer_us = calloc(dataset.count, sizeof(double));
+    loop_us = calloc(dataset.count, sizeof(double));
+
+    for (int k = 0; k < MOTOR_SENSOR_COUNT; k++) {
+        fake_mpu6050_t *mpu = &mpus[k];
+        fake_mpu6050_init(mpu, dataset.samples, dataset.count);
+        mpu->cursor = dataset.count * k / MOTOR_SENSOR_COUNT;
+        mpu->on_sample = count_shown;
+#ifdef MOTOR_SENSOR_FILTER
+        // Sensor sobreamostrado: cada linha dos CSVs vale SAMPLE_FILTER_DECIMATION leituras
+        mpu->hold = SAMPLE_FILTER_DECIMATION;
+#endif
+        fake_mpu6050_attach(mpu, sensor_slots[k].port, sensor_slots[k].addr);
+        reports[k].last_raw = -1;
+        reports[k].last_filtered = -1;
+    }
+    mpus[0].on_exhausted = finish;
+    fake_mpu6050_connect_int(&mpus[0], HOST_SENSOR_INT_GPIO);
+
+    fake_ssd1306_init(&oled);
+    frame_dir = getenv("MOTOR_HOST_FRAME_DIR");
+    if (frame_dir && *frame_dir) oled.on_frame = dump_frame;
+    fake_ssd1306_attach(&oled, HOST_DISPLAY_PORT, HOST_DISPLAY_ADDR);
+
+    // MOTOR_HOST_FLASH_FILE: a flash simulada continua de onde a execução anterior parou
+    flash_file = getenv("MOTOR_HOST_FLASH_FILE");
+    if (flash_file && *flash_file) host_flash_load(flash_file);
+}
@@ -0,0 +1,123 @@
+// Motor de transferência do i2c_dma.h simulado no host
+// A leitura é feita no dispositivo simulado já no start (o estado do sensor avança naquele
+// instante), mas os bytes só aparecem em dst quando o tempo de barramento da transferência
+// passou no relógio do host; até lá dst fica preenchido com HOST_I2C_DMA_POISON, então um
+// pipeline que lê o buffer antes do finish classifica lixo e aparece no relatório
+// Escritas (i2c_dma_write_start) não são simuladas: viram i2c_write_blocking na hora, para que o
+// SSD1306 simulado capture os quadros no mesmo ponto do envio síncrono
+#include "host_hal.h"
+#include "i2c_dma.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    bool active;                  // iniciada e ainda sem finish (como no RP2040)
+    bool delivered;               // bytes já copiados para dst
+    uint8_t *dst;
+    size_t len;
+    int result;
+    uint64_t done_at_us;          // fim da transferência no time_us_64
+    uint8_t staged[I2C_DMA_MAX_LEN];
+    host_i2c_dma_stats_t stats;
+} host_dma_port_t;
+
+static host_dma_port_t ports[2];
+
+// Copia os bytes para dst quando a transferência terminou; true se já terminou
+static bool complete(host_dma_port_t *p) {
+    if (p->delivered) return true;
+    if (time_us_64() < p->done_at_us) return false;
+    if (p->result > 0 && p->dst) memcpy(p->dst, p->staged, p->len);
+    p->delivered = true;
+    return true;
+}
+
+void i2c_dma_init(i2c_inst_t *i2c) {
+    (void)i2c;
+}
+
+bool i2c_dma_read_start(i2c_inst_t *i2c, uint8_t addr, uint8_t reg, uint8_t *dst, size_t len) {
+    host_dma_port_t *p = &ports[i2c->id];
+    if (p->active || len == 0 || len > I2C_DMA_MAX_LEN) return false;
+
+    // Mesmo tráfego da versão bloqueante (conta nas estatísticas do barramento)
+    host_i2c_stats_t before = host_i2c_get_stats(i2c);
+    p->result = i2c_write_blocking(i2c, addr, &reg, 1, true);
+    if (p->result > 0) p->result = i2c_read_blocking(i2c, addr, p->staged, len, false);
+    host_i2c_stats_t after = host_i2c_get_stats(i2c);
+    host_i2c_stats_t traffic = {after.transactions - before.transactions, after.bytes - before.bytes};
+    uint64_t bus_us = host_i2c_bus_time_us(i2c, &traffic);
+
+    memset(dst, HOST_I2C_DMA_POISON, len);
+    p->dst = dst;
+    p->len = len;
+    p->done_at_us = time_us_64() + bus_us;
+    p->active = true;
+    p->delivered = false;
+    p->stats.transfers++;
+    p->stats.bytes += len;
+    p->stats.bus_us += bus_us;
+    return true;
+}
+
+bool i2c_dma_write_start(i2c_inst_t *i2c, uint8_t addr, const uint16_t *cmds, size_t count) {
+    host_dma_port_t *p = &ports[i2c->id];
+    if (p->active || count == 0) return false;
+
+    // Cada trecho entre START/RESTART e STOP é uma transação
+    uint8_t *bytes = malloc(count);
+    size_t n = 0;
+    p->result = (int)count;
+    for (size_t i = 0; i < count; i++) {
+        if ((cmds[i] & I2C_DMA_CMD_RESTART) && n > 0) {
+            if (i2c_write_blocking(i2c, addr, bytes, n, true) < 0) p->result = PICO_ERROR_GENERIC;
+            n = 0;
+        }
+        bytes[n++] = (uint8_t)cmds[i];
+        if ((cmds[i] & I2C_DMA_CMD_STOP) || i == count - 1) {
+            if (i2c_write_blocking(i2c, addr, bytes, n, false) < 0) p->result = PICO_ERROR_GENERIC;
+            n = 0;
+        }
+    }
+    free(bytes);
+
+    p->dst = NULL;
+    p->len = count;
+    p->done_at_us = time_us_64();
+    p->active = true;
+    p->delivered = false;
+    p->stats.transfers++;
+    p->stats.bytes += count;
+    return true;
+}
+
+bool i2c_dma_busy(i2c_inst_t *i2c) {
+    host_dma_port_t *p = &ports[i2c->id];
+    return p->active && !complete(p);
+}
+
+static int finish(i2c_inst_t *i2c) {
+    host_dma_port_t *p = &ports[i2c->id];
+    if (!p->active) return PICO_ERROR_GENERIC;
+    // A CPU fica parada até o fim do barramento: avança o relógio virtual pelo que falta
+    uint64_t now = time_us_64();
+    if (now < p->done_at_us) {
+        p->stats.stalled_us += p->done_at_us - now;
+        sleep_us(p->done_at_us - now);
+    }
+    complete(p);
+    p->active = false;
+    return p->result > 0 ? (int)p->len : PICO_ERROR_GENERIC;
+}
+
+int i2c_dma_read_finish(i2c_inst_t *i2c) {
+    return finish(i2c);
+}
+
+int i2c_dma_write_finish(i2c_inst_t *i2c) {
+    return finish(i2c);
+}
+
+host_i2c_dma_stats_t host_i2c_dma_get_stats(const i2c_inst_t *i2c) {
+    return ports[i2c->id].stats;
+}
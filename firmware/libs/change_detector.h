@@ -0,0 +1,74 @@
+#ifndef CHANGE_DETECTOR_H
+#define CHANGE_DETECTOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Detector de mudança do sinal bruto: decide se vale rodar o modelo antes de gastar um tflm_infer
+// Cada amostra (unidades físicas, na ordem das features do modelo) atualiza a média e a variância
+// móveis exponenciais de cada canal (peso CHANGE_DETECT_ALPHA, ~1/alpha amostras). As estatísticas
+// são comparadas com uma referência guardada na última vez em que o detector pediu uma inferência:
+//   - média: |média - ref| > CHANGE_DETECT_MEAN_THRESHOLD desvios padrão da referência
+//   - variância: razão entre a atual e a da referência acima de 1 + CHANGE_DETECT_VAR_THRESHOLD
+//     (para cima ou para baixo); nos CSVs os níveis diferem sobretudo na variância
+// Os pisos de ruído por canal evitam que um canal quase parado (nível 0) dispare com qualquer vibração
+// Mesmo sem mudança, a referência vence depois de CHANGE_DETECT_MAX_SKIP amostras e o detector
+// pede uma inferência de confirmação (o nível mostrado nunca fica velho por mais que isso)
+// Custo: ~15 operações de ponto flutuante por canal e amostra, uma fração do MLP
+
+#define CHANGE_DETECT_CHANNELS 6
+
+#ifndef CHANGE_DETECT_ALPHA
+#define CHANGE_DETECT_ALPHA (1.0f / 32.0f)
+#endif
+#ifndef CHANGE_DETECT_MEAN_THRESHOLD
+#define CHANGE_DETECT_MEAN_THRESHOLD 3.0f
+#endif
+#ifndef CHANGE_DETECT_VAR_THRESHOLD
+#define CHANGE_DETECT_VAR_THRESHOLD 0.5f
+#endif
+// Desvio padrão mínimo considerado em cada canal: aceleração (m/s²) e giroscópio (°/s)
+#ifndef CHANGE_DETECT_ACCEL_FLOOR
+#define CHANGE_DETECT_ACCEL_FLOOR 0.05f
+#endif
+#ifndef CHANGE_DETECT_GYRO_FLOOR
+#define CHANGE_DETECT_GYRO_FLOOR 0.5f
+#endif
+// 500 amostras: 5 s a 100 Hz
+#ifndef CHANGE_DETECT_MAX_SKIP
+#define CHANGE_DETECT_MAX_SKIP 500
+#endif
+
+typedef enum {
+    CHANGE_NONE = 0,   // sinal parecido com a referência
+    CHANGE_DRIFT,      // as estatísticas se afastaram da referência
+    CHANGE_REFRESH     // primeira referência ou referência vencida (CHANGE_DETECT_MAX_SKIP)
+} change_t;
+
+typedef struct {
+    float mean[CHANGE_DETECT_CHANNELS], var[CHANGE_DETECT_CHANNELS];
+    float ref_mean[CHANGE_DETECT_CHANNELS], ref_var[CHANGE_DETECT_CHANNELS];
+    uint32_t samples;        // amostras desde o init
+    uint32_t since_ref;      // amostras desde a referência
+    bool armed;              // referência guardada (depois de ~1/alpha amostras)
+    bool drifted;            // alguma amostra desde a referência passou de um limiar
+} change_detector_t;
+
+void change_detector_init(change_detector_t *d);
+
+// Acrescenta uma amostra; a mudança fica marcada até o próximo change_detector_check
+void change_detector_push(change_detector_t *d, const float sample[CHANGE_DETECT_CHANNELS]);
+
+// O que aconteceu desde o último check; se não for CHANGE_NONE, as estatísticas atuais viram a
+// nova referência (quem chama deve rodar o modelo agora)
+change_t change_detector_check(change_detector_t *d);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHANGE_DETECTOR_H
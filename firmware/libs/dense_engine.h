@@ -0,0 +1,136 @@
+// Motor de inferência denso (MLP) especializado em tempo de compilação
+// Alternativa ao MicroInterpreter: os tamanhos das camadas são parâmetros de template,
+// os pesos ficam em arrays constexpr (flash) e o produto escalar é desenrolado
+#ifndef DENSE_ENGINE_H
+#define DENSE_ENGINE_H
+
+#include <math.h>
+#include <stdint.h>
+
+namespace dense {
+
+enum class Activation { kNone, kRelu };
+
+// Produto escalar desenrolado: soma na mesma ordem (0..N-1) que o kernel de referência do TFLM
+template <int N>
+struct Dot {
+    static inline float run(const float* w, const float* x) {
+        return Dot<N - 1>::run(w, x) + w[N - 1] * x[N - 1];
+    }
+};
+
+template <>
+struct Dot<0> {
+    static inline float run(const float*, const float*) { return 0.0f; }
+};
+
+template <Activation A>
+inline float activate(float v) {
+    return v;
+}
+
+template <>
+inline float activate<Activation::kRelu>(float v) {
+    return v > 0.0f ? v : 0.0f;
+}
+
+// out = act(W * in + b), com W no layout [saída][entrada] do TFLite
+template <int IN, int OUT, Activation A>
+inline void fully_connected(const float (&weights)[OUT][IN], const float (&bias)[OUT],
+                            const float* in, float* out) {
+    for (int o = 0; o < OUT; o++) {
+        out[o] = activate<A>(Dot<IN>::run(weights[o], in) + bias[o]);
+    }
+}
+
+// Softmax no lugar, subtraindo o máximo para estabilidade numérica
+template <int N>
+inline void softmax(float* v) {
+    float max_value = v[0];
+    for (int i = 1; i < N; i++) {
+        if (v[i] > max_value) max_value = v[i];
+    }
+    float sum = 0.0f;
+    for (int i = 0; i < N; i++) {
+        v[i] = expf(v[i] - max_value);
+        sum += v[i];
+    }
+    for (int i = 0; i < N; i++) {
+        v[i] /= sum;
+    }
+}
+
+// --- Caminho int8 (modelo gerado com tools/dense_export.py --int8) ---
+
+// Produto escalar int8 x int8 com acumulador int32, desenrolado como o float
+template <int N>
+struct DotI8 {
+    static inline int32_t run(const int8_t* w, const int8_t* x) {
+        return DotI8<N - 1>::run(w, x) + (int32_t)w[N - 1] * (int32_t)x[N - 1];
+    }
+};
+
+template <>
+struct DotI8<0> {
+    static inline int32_t run(const int8_t*, const int8_t*) { return 0; }
+};
+
+inline int8_t saturate_int8(int32_t v) {
+    return (int8_t)(v < -128 ? -128 : (v > 127 ? 127 : v));
+}
+
+// acc * multiplier * 2^(shift - 31), com arredondamento (multiplier em Q31)
+inline int32_t requantize(int32_t acc, int32_t multiplier, int shift) {
+    const int total = 31 - shift;
+    const int64_t prod = (int64_t)acc * multiplier;
+    return (int32_t)((prod + ((int64_t)1 << (total - 1))) >> total);
+}
+
+// Quantiza as features: q = round(x * mult + offset); o scaler já vem embutido em mult/offset
+template <int N>
+inline void quantize_input(const float (&mult)[N], const float (&offset)[N],
+                           const float* in, int8_t* out) {
+    for (int i = 0; i < N; i++) {
+        out[i] = saturate_int8((int32_t)floorf(in[i] * mult[i] + offset[i] + 0.5f));
+    }
+}
+
+// Fator float em Q16 arredondado, calculado em tempo de compilação
+constexpr int32_t to_q16(float v) {
+    return (int32_t)(v * 65536.0f + (v < 0.0f ? -0.5f : 0.5f));
+}
+
+// Quantiza contagens inteiras (ex: mpu6050_frame_t) sem ponto flutuante: q = (x * mult + offset) >> 16
+// mult e offset em Q16, com o +0.5 do arredondamento já somado no offset
+template <int N>
+inline void quantize_input_fixed(const int32_t (&mult)[N], const int32_t (&offset)[N],
+                                 const int16_t* in, int8_t* out) {
+    for (int i = 0; i < N; i++) {
+        out[i] = saturate_int8((in[i] * mult[i] + offset[i]) >> 16);
+    }
+}
+
+// out = act(requantize(W * in + b)) com pesos simétricos por canal;
+// o zero point da entrada já foi descontado no bias pelo gerador
+template <int IN, int OUT, Activation A>
+inline void fully_connected_int8(const int8_t (&weights)[OUT][IN], const int32_t (&bias)[OUT],
+                                 const int32_t (&multiplier)[OUT], const int8_t (&shift)[OUT],
+                                 int32_t output_zero_point, const int8_t* in, int8_t* out) {
+    for (int o = 0; o < OUT; o++) {
+        int32_t acc = DotI8<IN>::run(weights[o], in) + bias[o];
+        int32_t q = output_zero_point + requantize(acc, multiplier[o], shift[o]);
+        if (A == Activation::kRelu && q < output_zero_point) q = output_zero_point;
+        out[o] = saturate_int8(q);
+    }
+}
+
+template <int N>
+inline void dequantize(const int8_t* in, float scale, int32_t zero_point, float* out) {
+    for (int i = 0; i < N; i++) {
+        out[i] = (float)(in[i] - zero_point) * scale;
+    }
+}
+
+}  // namespace dense
+
+#endif  // DENSE_ENGINE_H
@@ -0,0 +1,30 @@
+#ifndef FFT_Q15_H
+#define FFT_Q15_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// FFT radix-2 em ponto fixo Q15 (só inteiros, para o Cortex-M0+ sem FPU)
+// A tabela de twiddles (um quarto de seno) é const e fica na flash; serve para
+// qualquer n potência de 2 até FFT_Q15_MAX_SIZE
+// A mesma aritmética está em tools/spectral_features.py (usado no treino)
+
+#define FFT_Q15_MAX_SIZE 256
+
+// FFT complexa in-place de n pontos, dados intercalados [re0, im0, re1, im1, ...]
+// Cada estágio divide por 2 (saída = X / n) e o resultado é saturado em int16
+void fft_q15_complex(int16_t *data, int n);
+
+// FFT real de n amostras (n potência de 2, 4 <= n <= FFT_Q15_MAX_SIZE) via FFT complexa de n/2 pontos
+// data (n amostras) é usado como área de trabalho e destruído
+// bins recebe n/2 + 1 bins intercalados [re0, im0, ..., re(n/2), im(n/2)] escalados por 2/n
+void fft_q15_real(int16_t *data, int n, int32_t *bins);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FFT_Q15_H
@@ -0,0 +1,90 @@
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "mpu6050.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Registrador de amostras na flash QSPI para retreino offline
+// Cada amostra bruta do sensor vira um registro de 16 bytes com a última previsão; os registros
+// enchem um setor inteiro na RAM e o setor é gravado de uma vez numa região circular no fim da
+// flash (cada setor é apagado uma vez por volta, então o desgaste fica igual em toda a região)
+// Gravar a flash para o XIP e desliga as interrupções, então a gravação não acontece no append:
+// flash_log_service faz uma operação por chamada (apagar o setor ou gravar uma página) e roda
+// como uma tarefa de baixa prioridade
+// Dois buffers de setor: o append enche um enquanto o service grava o outro. append e service
+// podem rodar em cores diferentes (o append no core 1 do pipeline de dois núcleos)
+// Um setor vai para a flash quando enche ou no flash_log_flush (troca de rótulo, fim de rajada ou
+// de coleta); o cabeçalho guarda quantos registros o setor tem
+// tools/flash_log_dump.py converte a região (picotool save ou a flash simulada do host) em CSV
+
+// Região do log: os últimos FLASH_LOG_SIZE bytes da flash (múltiplo do setor de 4 KB)
+#ifndef FLASH_LOG_SIZE
+#define FLASH_LOG_SIZE (512u * 1024u)
+#endif
+#define FLASH_LOG_SECTOR_BYTES 4096u
+
+#define FLASH_LOG_MAGIC 0x474F4C4Du  // "MLOG"
+
+// Registro de uma amostra (layout gravado na flash, little-endian)
+typedef struct {
+    int16_t accel[3];     // contagens do MPU6050 (16384 LSB/g)
+    int16_t gyro[3];      // contagens do MPU6050 (131 LSB/°/s)
+    int8_t predicted;     // último nível previsto quando a amostra entrou (-1: sem previsão)
+    uint8_t confidence;   // score do nível previsto * 255
+    int8_t label;         // nível conhecido durante a coleta (-1: sem rótulo)
+    uint8_t reserved;     // 0xFF
+} flash_log_record_t;
+
+// Cabeçalho no início de cada setor; gravado por último, então um setor só vale com ele inteiro
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;         // cresce a cada setor gravado: o maior é o mais recente
+    uint32_t seq_inv;     // ~seq (detecta um cabeçalho gravado pela metade)
+    uint16_t count;       // registros no setor
+    uint16_t rate_hz;     // taxa de amostragem
+} flash_log_header_t;
+
+#define FLASH_LOG_RECORDS_PER_SECTOR \
+    ((FLASH_LOG_SECTOR_BYTES - sizeof(flash_log_header_t)) / sizeof(flash_log_record_t))
+
+typedef struct {
+    uint32_t records;     // registros aceitos desde o boot
+    uint32_t dropped;     // registros perdidos porque os dois buffers estavam ocupados
+    uint32_t sectors;     // setores gravados desde o boot
+    uint32_t errors;      // operações de flash que falharam (repetidas na próxima chamada)
+    uint32_t seq;         // sequência do próximo setor
+} flash_log_stats_t;
+
+// Procura o setor mais recente da região e continua depois dele
+// false (log desligado) se a região invade o programa gravado na flash
+bool flash_log_init(uint16_t rate_hz);
+
+// Rótulo gravado nos próximos registros (-1 sem rótulo); se ele muda, faz o flash_log_flush
+// (lado do append)
+void flash_log_set_label(int label);
+
+// Previsão gravada nos próximos registros (a mais recente, atualizada a cada inferência)
+void flash_log_set_prediction(int level, float confidence);
+
+// Produtor: acrescenta uma amostra ao setor em montagem; false se ela foi descartada
+bool flash_log_append(const mpu6050_frame_t *frame);
+
+// Produtor: entrega ao service o setor em montagem mesmo incompleto (um setor apagado por chamada);
+// false se não havia registro pendente
+bool flash_log_flush(void);
+
+// Consumidor: no máximo uma operação de flash por chamada; true se fez alguma
+bool flash_log_service(void);
+
+flash_log_stats_t flash_log_get_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLASH_LOG_H
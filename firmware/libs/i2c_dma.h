@@ -0,0 +1,55 @@
+#ifndef I2C_DMA_H
+#define I2C_DMA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "hardware/i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Leitura I2C não bloqueante por DMA: escreve o registrador inicial e lê len bytes
+// (RESTART entre os dois, STOP no fim) sem ocupar a CPU durante a transferência
+// No RP2040 são dois canais de DMA por porta: um alimenta o IC_DATA_CMD com os comandos
+// de leitura (DREQ de TX) e o outro copia os bytes recebidos para dst (DREQ de RX)
+// No build host a transferência é simulada (firmware/host/src/host_i2c_dma.c)
+
+// Maior leitura suportada por transferência (tamanho da lista de comandos do canal de TX)
+#define I2C_DMA_MAX_LEN 256
+
+// Bits de controle das palavras do IC_DATA_CMD usadas no i2c_dma_write_start (byte nos bits 0-7)
+// STOP encerra a transação depois do byte; se ainda houver palavras, o controlador abre outra
+// (START) para o mesmo endereço. RESTART abre uma nova transação antes do byte sem STOP
+#define I2C_DMA_CMD_STOP    0x200u
+#define I2C_DMA_CMD_RESTART 0x400u
+
+// Reserva os canais de DMA da porta (chamar depois do i2c_init)
+void i2c_dma_init(i2c_inst_t *i2c);
+
+// Inicia a leitura de len bytes a partir de reg; dst só é válido depois do i2c_dma_read_finish
+// Retorna false se já existe uma transferência em andamento na porta ou len é inválido
+// Enquanto a transferência não termina, a porta não pode ser usada com as funções bloqueantes
+bool i2c_dma_read_start(i2c_inst_t *i2c, uint8_t addr, uint8_t reg, uint8_t *dst, size_t len);
+
+// Inicia a escrita de count palavras do IC_DATA_CMD (byte | I2C_DMA_CMD_STOP/RESTART), que podem
+// formar várias transações; a última palavra deve ter STOP. cmds tem que continuar válido até o
+// i2c_dma_write_finish (o canal de TX lê direto dele, em transferências de 16 bits)
+// No build host as transações são feitas na hora com i2c_write_blocking (envio síncrono)
+bool i2c_dma_write_start(i2c_inst_t *i2c, uint8_t addr, const uint16_t *cmds, size_t count);
+
+// true enquanto a transferência da porta está em andamento
+bool i2c_dma_busy(i2c_inst_t *i2c);
+
+// Espera a transferência terminar; retorna os bytes lidos ou PICO_ERROR_GENERIC (sem ACK ou nada iniciado)
+int i2c_dma_read_finish(i2c_inst_t *i2c);
+
+// Espera a escrita terminar (último STOP no barramento); retorna count ou PICO_ERROR_GENERIC
+int i2c_dma_write_finish(i2c_inst_t *i2c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // I2C_DMA_H
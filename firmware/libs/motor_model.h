@@ -37,64 +37,64 @@ const unsigned char motor_model[] = {
   0x26, 0xf2, 0xff, 0xff, 0x04, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x31, 0x2e, 0x35, 0x2e,
   0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0xed, 0xff, 0xff,
   0x48, 0xed, 0xff, 0xff, 0x4c, 0xed, 0xff, 0xff, 0x50, 0xed, 0xff, 0xff, 0x52, 0xf2, 0xff, 0xff,
-  0x04, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0xc7, 0xd6, 0x03, 0xbe, 0xaa, 0xb7, 0xee, 0xbe,
-  0xdb, 0xc6, 0x85, 0xbe, 0xe5, 0xee, 0x07, 0xbf, 0xbd, 0xda, 0x3b, 0xbf, 0x8e, 0x1f, 0x4e, 0xbf,
-  0x71, 0xf0, 0x53, 0xbe, 0xb3, 0xdf, 0x5d, 0xbe, 0xf1, 0xa7, 0x9e, 0xbe, 0xc5, 0xcf, 0x27, 0xbf,
-  0xda, 0x8c, 0xc5, 0xbe, 0xdd, 0xa0, 0xaf, 0xbe, 0xac, 0x67, 0x60, 0xbe, 0x2f, 0x60, 0x9d, 0xbd,
-  0x1b, 0x50, 0x16, 0x3d, 0xcf, 0x08, 0xbc, 0xbe, 0xdb, 0x42, 0xcf, 0xbe, 0xad, 0x72, 0x6e, 0xbe,
-  0x0c, 0x36, 0x96, 0xbe, 0x70, 0xba, 0x7b, 0xbf, 0x58, 0x4d, 0x26, 0xbf, 0x59, 0xed, 0x6b, 0x3e,
-  0xe2, 0xda, 0xcf, 0xbe, 0x09, 0xff, 0x86, 0x3e, 0xd0, 0xb9, 0x87, 0xbf, 0xfc, 0xcc, 0x92, 0xbe,
-  0x36, 0xb6, 0x51, 0xbf, 0x09, 0xd7, 0x04, 0xbf, 0xca, 0xd6, 0xb1, 0xbe, 0x2b, 0x57, 0xaa, 0x3d,
-  0x51, 0x04, 0x12, 0xbe, 0xcc, 0x5a, 0xab, 0xbd, 0xde, 0xf2, 0xff, 0xff, 0x04, 0x00, 0x00, 0x00,
-  0x00, 0x03, 0x00, 0x00, 0xe9, 0xaa, 0x0e, 0x3f, 0xca, 0x87, 0x01, 0x3f, 0x69, 0xc4, 0x9d, 0x3e,
-  0xc7, 0x45, 0xa7, 0xbe, 0xb2, 0xc9, 0xab, 0x3e, 0x13, 0xd7, 0x10, 0xbf, 0xb3, 0xd0, 0xe2, 0xbd,
-  0x5e, 0x8f, 0x54, 0xbe, 0x2c, 0x02, 0x4a, 0x3e, 0x48, 0x55, 0x3b, 0x3e, 0x38, 0x7c, 0x98, 0x3d,
-  0x16, 0xc9, 0x8f, 0x3f, 0x6e, 0x63, 0x88, 0xbe, 0xe9, 0xba, 0xb0, 0xbc, 0x6d, 0x8d, 0x1f, 0x3e,
-  0x82, 0x60, 0xcc, 0x3e, 0x13, 0x89, 0x45, 0x3e, 0xe2, 0x55, 0x9b, 0x3f, 0x7d, 0x82, 0xbb, 0x3e,
-  0x89, 0x90, 0xba, 0x3e, 0xbf, 0x15, 0x73, 0x3f, 0xe8, 0xa0, 0x95, 0x3e, 0xf5, 0x45, 0x24, 0x3e,
-  0x17, 0x21, 0x9e, 0xbe, 0x44, 0x3a, 0x4c, 0xbe, 0xfc, 0xc2, 0xd8, 0x3e, 0xac, 0x61, 0xce, 0x3e,
-  0xd3, 0x70, 0xa8, 0x3c, 0x40, 0xaf, 0x14, 0xbf, 0xd8, 0x92, 0x1d, 0x3d, 0x05, 0x60, 0xc9, 0x3e,
-  0x3b, 0x9d, 0xcd, 0x3e, 0x6e, 0xd9, 0x42, 0xbe, 0x14, 0x15, 0x2b, 0x3f, 0x35, 0x6c, 0x78, 0xbe,
-  0xfd, 0x16, 0x2d, 0xbf, 0xa0, 0xa1, 0x47, 0xbf, 0x02, 0x96, 0x75, 0x3d, 0xa5, 0x44, 0x66, 0xbe,
-  0x2e, 0xe6, 0x78, 0x3d, 0x66, 0xa4, 0x12, 0x3f, 0x10, 0x28, 0x80, 0x3d, 0xdd, 0x07, 0xc6, 0x3e,
-  0x02, 0x17, 0x05, 0xbf, 0x47, 0x2d, 0x95, 0xbe, 0x5b, 0x3c, 0x5d, 0xbd, 0x0b, 0xf9, 0x4d, 0x3e,
-  0xd9, 0xa1, 0x9f, 0x3f, 0xa1, 0x55, 0xf1, 0xbe, 0x07, 0x81, 0xd1, 0x3e, 0x9d, 0xa6, 0x1f, 0xbc,
-  0x15, 0xb0, 0x37, 0xbf, 0xe2, 0xfe, 0xbf, 0x3e, 0x9b, 0xc0, 0x77, 0x3f, 0xe2, 0x7f, 0x90, 0xbe,
-  0x62, 0x82, 0xd5, 0x3c, 0xf0, 0xa3, 0x9f, 0x3d, 0x3d, 0x71, 0x4e, 0x3f, 0x02, 0xf2, 0x73, 0x3e,
-  0xec, 0xbe, 0x5a, 0x3f, 0xe6, 0xf0, 0x1d, 0xbe, 0xe7, 0xb2, 0x0d, 0x3e, 0x60, 0x82, 0x42, 0x3d,
-  0x3c, 0xd9, 0x6b, 0x3f, 0x0f, 0x88, 0x2e, 0xbf, 0x85, 0x5e, 0x01, 0x3e, 0x64, 0x8f, 0x34, 0x3f,
-  0x51, 0x33, 0x03, 0x3f, 0xbb, 0x12, 0xdc, 0x3d, 0x44, 0x9b, 0xd2, 0xbe, 0x7c, 0x89, 0xa3, 0xbe,
-  0x44, 0xdd, 0xd8, 0x3e, 0x35, 0x6d, 0xaa, 0xbe, 0x90, 0x35, 0x55, 0xbf, 0x6a, 0x72, 0x00, 0xbf,
-  0x10, 0x4e, 0x98, 0x3e, 0xa1, 0x4f, 0xc0, 0x3c, 0x64, 0xb0, 0x13, 0xbf, 0xf1, 0x88, 0x62, 0xbe,
-  0xe6, 0xdd, 0xd7, 0x3e, 0x21, 0x5c, 0x91, 0xbe, 0x9c, 0x1e, 0xd9, 0x3e, 0x5e, 0xc9, 0x5f, 0x3e,
-  0xe3, 0x60, 0x35, 0x3f, 0xc7, 0x53, 0x15, 0x3c, 0x84, 0x8b, 0x36, 0xbd, 0xf8, 0x00, 0x83, 0xbe,
-  0x81, 0x4a, 0x34, 0xbe, 0x2e, 0x8e, 0x82, 0xbc, 0x25, 0x24, 0x8e, 0xbf, 0xb8, 0xef, 0x6e, 0x3e,
-  0x95, 0x4b, 0xdf, 0x3d, 0x31, 0x68, 0x60, 0xbd, 0x9b, 0xbf, 0xf5, 0xbe, 0xde, 0x61, 0x7d, 0xbc,
-  0xb7, 0x0a, 0x84, 0xbf, 0x61, 0x31, 0x53, 0xbd, 0x32, 0xfe, 0x74, 0xbe, 0x98, 0xd2, 0x7d, 0x3d,
-  0xd9, 0xe0, 0x83, 0xbf, 0xaa, 0x20, 0x15, 0x3e, 0xba, 0x2f, 0x5e, 0xbf, 0x1b, 0x5c, 0xf1, 0xbd,
-  0x77, 0x48, 0xb4, 0xbe, 0x49, 0x5b, 0x0e, 0xbf, 0x63, 0xcf, 0x96, 0x3e, 0xff, 0x1a, 0xfd, 0x3e,
-  0x9e, 0x03, 0xab, 0x3e, 0xb2, 0x2b, 0x6a, 0x3f, 0xa5, 0xb8, 0x8f, 0x3e, 0xc9, 0xcb, 0xb7, 0x3e,
-  0xfb, 0xbb, 0x50, 0xbe, 0x0c, 0x27, 0xcf, 0xbe, 0x44, 0x2a, 0xc3, 0xbd, 0xb8, 0x03, 0x9b, 0xbd,
-  0xcf, 0xf1, 0x03, 0x3e, 0xfc, 0x57, 0x9a, 0xbd, 0xaf, 0xd3, 0x90, 0x3f, 0x5d, 0x79, 0x81, 0x3e,
-  0x30, 0x24, 0x85, 0xbe, 0xd8, 0xe9, 0x9a, 0xbd, 0x10, 0x85, 0xd6, 0xbe, 0xc4, 0xe2, 0x66, 0x3e,
-  0x09, 0x06, 0x67, 0xbf, 0x35, 0x17, 0xb4, 0x3c, 0xad, 0xf8, 0x01, 0x3f, 0x1f, 0xea, 0xe9, 0x3d,
-  0x11, 0x14, 0xe4, 0x3e, 0x04, 0xd4, 0xc5, 0x3d, 0x87, 0x3a, 0x99, 0x3e, 0xee, 0x15, 0x57, 0xbd,
-  0xc4, 0xf8, 0x5b, 0x3e, 0x3b, 0xb7, 0xe6, 0xbe, 0x2e, 0x13, 0x42, 0xbf, 0x50, 0x20, 0x71, 0xbf,
-  0xa6, 0x75, 0xeb, 0x3e, 0x92, 0xe3, 0x5e, 0xbc, 0xc4, 0x73, 0x32, 0xbe, 0x62, 0x3b, 0xa0, 0x3c,
-  0xb3, 0xe3, 0xb0, 0x3e, 0x32, 0x3d, 0x7d, 0x3d, 0x9f, 0x45, 0x87, 0x3e, 0xb2, 0x99, 0xeb, 0xbc,
-  0x01, 0x37, 0x28, 0x3e, 0xbd, 0xcd, 0xbc, 0xbe, 0xca, 0x67, 0x7e, 0x3e, 0xbe, 0x6b, 0x9b, 0x3d,
-  0xb2, 0x70, 0x35, 0xbe, 0xd6, 0x66, 0x1c, 0xbf, 0x10, 0xb2, 0xa8, 0x3d, 0xb7, 0x63, 0x14, 0xbf,
-  0x41, 0x23, 0xda, 0xbe, 0xd7, 0x49, 0x3c, 0x3e, 0xf5, 0x6b, 0x5d, 0x3f, 0x84, 0x56, 0x9f, 0x3e,
-  0x95, 0x52, 0x22, 0xbf, 0x03, 0x75, 0x9d, 0x3e, 0x98, 0x9e, 0x11, 0x3f, 0xf8, 0x32, 0xea, 0x3d,
-  0x43, 0xbb, 0x34, 0x3a, 0x58, 0x67, 0x14, 0x3f, 0xb7, 0x4f, 0xf2, 0x3e, 0x03, 0x97, 0x07, 0x3f,
-  0x9c, 0x71, 0xd2, 0x3e, 0x07, 0x13, 0x9a, 0x3e, 0xbe, 0xfb, 0x87, 0xbf, 0x68, 0xdc, 0x59, 0xbe,
-  0xa3, 0xd8, 0xcf, 0x3e, 0x80, 0x34, 0xcd, 0x3c, 0x73, 0xec, 0x34, 0xbf, 0x45, 0x47, 0xc4, 0xbe,
-  0x12, 0x6e, 0xfa, 0x3e, 0x08, 0x48, 0xbe, 0xbe, 0xc7, 0x1e, 0x10, 0xbf, 0x14, 0x04, 0x90, 0xbe,
-  0x3f, 0xaf, 0x01, 0xbf, 0x6e, 0xfb, 0x85, 0x3e, 0xce, 0xb1, 0x46, 0xbe, 0xcf, 0x0e, 0x0a, 0xbd,
-  0xcc, 0xa6, 0x03, 0xbf, 0xcf, 0xff, 0x65, 0x3f, 0x01, 0xd2, 0x5a, 0x3d, 0xec, 0xcb, 0x71, 0x3d,
-  0xca, 0xd0, 0x1f, 0xbe, 0x94, 0x6f, 0x55, 0xbf, 0x22, 0xf7, 0x08, 0xbe, 0xaf, 0x87, 0x19, 0x3d,
-  0x96, 0x6f, 0x07, 0x3e, 0xbf, 0x56, 0x4d, 0x3d, 0x8a, 0xb0, 0x5b, 0xbf, 0x0d, 0xab, 0x9f, 0xbd,
-  0xfc, 0xa2, 0x1b, 0xbf, 0xea, 0xf5, 0xff, 0xff, 0x04, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x38, 0xad, 0xae, 0xc0, 0x31, 0xe2, 0x7b, 0xc0,
+  0x58, 0x76, 0x4f, 0xc0, 0xb4, 0x38, 0x87, 0xc1, 0x71, 0x34, 0xf6, 0xc0, 0xe0, 0xb2, 0x1e, 0x40,
+  0x07, 0x3e, 0x46, 0x40, 0xae, 0xb6, 0x9f, 0x40, 0x8b, 0x2f, 0x1e, 0xbf, 0x68, 0xe5, 0x17, 0xc0,
+  0x2d, 0x98, 0x99, 0xbf, 0xe1, 0xe6, 0xff, 0xbf, 0xd8, 0xd6, 0x09, 0x41, 0xc2, 0x72, 0x8a, 0x40,
+  0x78, 0xe3, 0x91, 0x40, 0x95, 0xf4, 0x42, 0x3f, 0x7e, 0x68, 0x9d, 0xbf, 0x3f, 0x89, 0x12, 0x41,
+  0x6e, 0x25, 0xc1, 0xc0, 0x8d, 0xb3, 0xb4, 0xbb, 0xa3, 0x08, 0x89, 0xc0, 0x1f, 0xc0, 0xce, 0xbf,
+  0x3b, 0xb0, 0x7d, 0x41, 0x4f, 0x71, 0x7a, 0xbf, 0x91, 0x5e, 0x17, 0xc0, 0xae, 0x05, 0x6a, 0xc0,
+  0x60, 0x89, 0x4a, 0xc0, 0xad, 0xd1, 0xae, 0xc0, 0x3a, 0x12, 0xd5, 0x40, 0x38, 0xa7, 0x86, 0xc0,
+  0xf7, 0xeb, 0xfc, 0xbe, 0xab, 0x91, 0x4b, 0xbf, 0xde, 0xf2, 0xff, 0xff, 0x04, 0x00, 0x00, 0x00,
+  0x00, 0x03, 0x00, 0x00, 0xae, 0xf5, 0x5a, 0x3e, 0x7a, 0xec, 0xac, 0x3e, 0x89, 0xdc, 0x07, 0x3f,
+  0xac, 0x85, 0x8d, 0xbd, 0xa3, 0x92, 0xc5, 0x3d, 0x88, 0x30, 0x06, 0xbe, 0x83, 0x0d, 0x2e, 0xbd,
+  0x63, 0xe2, 0x0d, 0xbe, 0xbb, 0xf5, 0xad, 0x3e, 0x9a, 0x7e, 0x1e, 0x3d, 0x75, 0x5f, 0xaf, 0x3c,
+  0x65, 0x36, 0x85, 0x3e, 0x98, 0x52, 0xd1, 0xbd, 0x80, 0xef, 0x6b, 0xbc, 0x18, 0x66, 0x89, 0x3e,
+  0x24, 0xea, 0xac, 0x3d, 0x5e, 0x2f, 0x63, 0x3d, 0xc5, 0xe9, 0x8f, 0x3e, 0x01, 0xe4, 0x0f, 0x3e,
+  0x8b, 0x10, 0x79, 0x3e, 0x3c, 0x55, 0xd1, 0x3f, 0x48, 0x30, 0x7d, 0x3d, 0x27, 0xee, 0x3c, 0x3d,
+  0x63, 0x80, 0x92, 0xbd, 0x35, 0xb8, 0x9c, 0xbd, 0x5d, 0xb0, 0x90, 0x3e, 0xca, 0xb9, 0x31, 0x3f,
+  0xaf, 0x82, 0x8e, 0x3b, 0x73, 0x00, 0x2b, 0xbe, 0x99, 0xfc, 0x11, 0x3c, 0xd5, 0x87, 0x1a, 0x3e,
+  0x7a, 0x3f, 0x89, 0x3e, 0x76, 0xcb, 0xa7, 0xbe, 0xd5, 0xbe, 0x10, 0x3e, 0xeb, 0xda, 0x8e, 0xbd,
+  0xa9, 0x5c, 0x20, 0xbe, 0x48, 0x31, 0x99, 0xbe, 0xe1, 0xed, 0x23, 0x3d, 0xb5, 0x4b, 0xc6, 0xbe,
+  0x39, 0x95, 0x52, 0x3c, 0x1e, 0xa7, 0x28, 0x3e, 0x29, 0x77, 0x6d, 0x3c, 0xd6, 0xf6, 0x17, 0x3e,
+  0xf5, 0xac, 0xb1, 0xbe, 0xc0, 0x76, 0x00, 0xbf, 0x98, 0x2d, 0x3b, 0xbc, 0x8a, 0xe3, 0x6c, 0x3d,
+  0xda, 0xe4, 0x93, 0x3e, 0xcc, 0x31, 0x39, 0xbe, 0x2c, 0xd8, 0x8b, 0x3e, 0xc9, 0x7b, 0x89, 0xbc,
+  0x10, 0x69, 0x1b, 0xbe, 0x4f, 0xd0, 0xdc, 0x3d, 0xca, 0x88, 0x65, 0x3e, 0x70, 0xc5, 0xdd, 0xbd,
+  0x9a, 0x84, 0x8e, 0x3c, 0x7b, 0x79, 0x09, 0x3e, 0x7a, 0xa9, 0x2e, 0x3e, 0xcd, 0x47, 0x8c, 0x3d,
+  0x24, 0xa9, 0x4a, 0x3e, 0x8d, 0x66, 0x72, 0xbd, 0x2b, 0x2b, 0xbd, 0x3d, 0x7f, 0x80, 0xa7, 0x3d,
+  0x97, 0x8a, 0x47, 0x3e, 0x6c, 0xba, 0x48, 0xbe, 0x6b, 0xb6, 0xef, 0x3c, 0xc4, 0x8e, 0x8a, 0x3e,
+  0x3a, 0x27, 0xaf, 0x3e, 0x2d, 0x84, 0x3d, 0x3e, 0x65, 0x2f, 0xb2, 0xbd, 0x64, 0x15, 0xbc, 0xbd,
+  0xe7, 0xea, 0xc8, 0x3d, 0x0c, 0xc8, 0x02, 0xbe, 0x53, 0x51, 0x0e, 0xbf, 0x79, 0x39, 0x5d, 0xbf,
+  0xd2, 0xdb, 0x80, 0x3d, 0x2c, 0x2d, 0xdd, 0x3b, 0x38, 0xd4, 0x08, 0xbe, 0x73, 0xd6, 0xad, 0xbd,
+  0x73, 0x17, 0x90, 0x3e, 0x8e, 0x5a, 0xfa, 0xbe, 0x10, 0xb2, 0xb7, 0x3d, 0x2e, 0xb0, 0x80, 0x3d,
+  0x87, 0x0a, 0x28, 0x3e, 0x3b, 0x2e, 0x65, 0x3b, 0xcc, 0xb2, 0xf3, 0xbc, 0xd1, 0xa0, 0xe1, 0xbe,
+  0x59, 0x89, 0x18, 0xbd, 0xc4, 0x26, 0x96, 0xbb, 0x68, 0xb0, 0x83, 0xbe, 0xb3, 0x5a, 0xb7, 0x3d,
+  0xd4, 0x0c, 0x95, 0x3d, 0x97, 0x3f, 0xc1, 0xbd, 0xd0, 0xea, 0xcf, 0xbd, 0x09, 0xb5, 0x91, 0xbb,
+  0x30, 0xaa, 0x74, 0xbe, 0x87, 0x10, 0xa2, 0xbc, 0x8b, 0x88, 0x23, 0xbe, 0x68, 0x94, 0xda, 0x3d,
+  0x37, 0x27, 0x5f, 0xbe, 0xe3, 0x82, 0x2b, 0x3d, 0x2e, 0xd9, 0x4d, 0xbe, 0xc5, 0x36, 0x39, 0xbd,
+  0xc3, 0xad, 0x70, 0xbe, 0x5f, 0x2e, 0x75, 0xbf, 0x1c, 0x30, 0x7f, 0x3d, 0x48, 0x8c, 0x11, 0x3e,
+  0x5d, 0x70, 0x9e, 0x3d, 0x7b, 0xb2, 0xb3, 0x3e, 0x5b, 0xde, 0x3f, 0x3e, 0xb6, 0x46, 0x1e, 0x3f,
+  0xe5, 0x99, 0x30, 0xbd, 0xe0, 0x3e, 0xee, 0xbd, 0x61, 0xd0, 0xb4, 0xbc, 0xbe, 0xe8, 0xed, 0xbc,
+  0x89, 0x25, 0xb0, 0x3d, 0xcd, 0xe9, 0x04, 0xbe, 0x4b, 0x10, 0x75, 0x3e, 0x66, 0xe8, 0x94, 0x3d,
+  0xbc, 0xb3, 0x76, 0xbd, 0x08, 0xc1, 0xed, 0xbc, 0x45, 0x31, 0x8f, 0xbe, 0xe0, 0xd3, 0xc6, 0x3e,
+  0x8b, 0x75, 0x43, 0xbe, 0x2f, 0x1f, 0xcf, 0x3b, 0x0f, 0xd4, 0xf0, 0x3d, 0x29, 0x80, 0x33, 0x3d,
+  0x2c, 0x3e, 0x98, 0x3e, 0x2a, 0x5c, 0x2a, 0x3e, 0xe2, 0xa3, 0x81, 0x3d, 0x96, 0x5e, 0x77, 0xbc,
+  0xe8, 0xcb, 0x4b, 0x3d, 0xc3, 0x0b, 0x31, 0xbe, 0xa4, 0x8b, 0x01, 0xbf, 0x6c, 0xa5, 0xcf, 0xbf,
+  0x56, 0x36, 0xc7, 0x3d, 0x09, 0x2c, 0x80, 0xbb, 0x7e, 0x54, 0x25, 0xbd, 0xa9, 0xea, 0xf5, 0x3b,
+  0xf4, 0x25, 0x6c, 0x3e, 0xc0, 0x13, 0xda, 0x3d, 0x47, 0xe5, 0x64, 0x3d, 0x51, 0x7b, 0x07, 0xbc,
+  0x71, 0xd8, 0x1b, 0x3d, 0x33, 0xe2, 0x10, 0xbe, 0xf4, 0xd0, 0x29, 0x3e, 0x45, 0xd7, 0x05, 0x3e,
+  0x40, 0x82, 0x19, 0xbd, 0x91, 0xe0, 0x33, 0xbe, 0x74, 0x4a, 0x9c, 0x3c, 0xcb, 0xbd, 0x63, 0xbe,
+  0x81, 0x9b, 0x91, 0xbe, 0x15, 0x25, 0xa2, 0x3e, 0xde, 0x55, 0x3b, 0x3e, 0x12, 0x41, 0xb7, 0x3d,
+  0xf1, 0x62, 0x16, 0xbe, 0x6a, 0xa8, 0xf1, 0x3d, 0x1a, 0x67, 0xc2, 0x3e, 0x4e, 0xae, 0x49, 0x3e,
+  0xbf, 0xe8, 0x18, 0x39, 0xc0, 0xad, 0x2a, 0x3e, 0x53, 0x7e, 0xe0, 0x3d, 0xdd, 0x18, 0x50, 0x3e,
+  0xc3, 0x78, 0x8c, 0x3e, 0x6b, 0xae, 0x04, 0x3f, 0x72, 0x19, 0x66, 0xbe, 0xb4, 0x8f, 0x7a, 0xbd,
+  0x09, 0x90, 0xc0, 0x3d, 0x3b, 0x78, 0x1d, 0x3c, 0xae, 0x88, 0xf1, 0xbe, 0x82, 0x06, 0x29, 0xbf,
+  0xc9, 0xe0, 0xd3, 0x3d, 0x96, 0xd7, 0xda, 0xbd, 0xc9, 0x85, 0x05, 0xbe, 0x6d, 0x07, 0xdd, 0xbd,
+  0x27, 0x21, 0xad, 0xbe, 0x01, 0xc2, 0xe6, 0x3e, 0x61, 0x1b, 0x28, 0xbd, 0xad, 0xc7, 0x1e, 0xbc,
+  0x0b, 0xf1, 0xf3, 0xbd, 0x02, 0x7f, 0xb0, 0x3e, 0x27, 0x10, 0x12, 0x3d, 0x34, 0x39, 0xd0, 0x3d,
+  0x8f, 0x36, 0x07, 0xbd, 0xd8, 0x78, 0x75, 0xbe, 0xa8, 0xc9, 0xfd, 0xbc, 0x7c, 0xa1, 0x6b, 0x3c,
+  0xbb, 0xce, 0xb4, 0x3d, 0xed, 0xd3, 0xb0, 0x3d, 0xb6, 0xde, 0x39, 0xbe, 0x4b, 0xa2, 0xb7, 0xbc,
+  0x34, 0x31, 0x10, 0xbe, 0xea, 0xf5, 0xff, 0xff, 0x04, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00,
   0xff, 0xd4, 0xb7, 0x3e, 0x16, 0xf7, 0x55, 0xbf, 0xb3, 0x5b, 0xd0, 0xbe, 0xed, 0xfa, 0xd6, 0x3e,
   0x37, 0x19, 0xea, 0x3e, 0x63, 0x99, 0x79, 0xbf, 0xf1, 0xb3, 0x81, 0x3e, 0x2a, 0x54, 0xe3, 0x3d,
   0xdf, 0x28, 0x1a, 0xbd, 0x45, 0x92, 0x87, 0xbf, 0x18, 0x37, 0xe0, 0xbd, 0x37, 0xbc, 0x9b, 0x3d,
@@ -349,6 +349,10 @@ const unsigned int motor_model_len = 5376;
 #define NUM_FEATURES 6
 #define NUM_CLASSES 4
 
+// StandardScaler folded into hidden1 (W' = W / scale, b' = b - W' * mean):
+// feed raw sensor features, scaler_params.h is not needed
+#define MOTOR_MODEL_SCALER_FOLDED 1
+
 // Class names
 const char* class_names[] = {
   "Nivel 0",
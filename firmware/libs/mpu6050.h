@@ -1,8 +1,14 @@
 #ifndef MPU6050_H
 #define MPU6050_H
 
+#include <stdbool.h>
+#include <stdint.h>
 #include "hardware/i2c.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 //Estrutura para armazenar os dados lidos do sensor já convertidos
 typedef struct {
     float accel_x, accel_y, accel_z;
@@ -10,10 +16,179 @@ typedef struct {
     float temp_c;
 } mpu6050_data_t;
 
-//Inicializa o sensor MPU6050, configurando-o e tirando-o do modo de suspensão
-void mpu6050_init(i2c_inst_t *i2c);
+//Amostra bruta da FIFO (contagens do sensor, ±2g e ±250°/s), na ordem em que o MPU6050 grava
+typedef struct {
+    int16_t accel[3];  // X, Y, Z (16384 LSB/g)
+    int16_t gyro[3];   // X, Y, Z (131 LSB/°/s)
+} mpu6050_frame_t;
+
+//Amostra em unidades físicas inteiras (caminho sem ponto flutuante, mpu6050_frame_to_fixed)
+typedef struct {
+    int32_t accel_mms2[3];  // X, Y, Z em mm/s²
+    int32_t gyro_mdps[3];   // X, Y, Z em milésimos de °/s
+} mpu6050_fixed_t;
+
+//Escalas em ponto fixo das contagens (±2g e ±250°/s): valor = (contagem * MULT) >> SHIFT, arredondado
+//O RP2040 não tem FPU: com elas a conversão é uma multiplicação inteira e um deslocamento por eixo
+//Aceleração: 9810 mm/s² / 16384 LSB, exato em Q14
+#define MPU6050_ACCEL_MMS2_MULT 9810
+#define MPU6050_ACCEL_MMS2_SHIFT 14
+//Giroscópio: 1000 m°/s / 131 LSB em Q10 (7817, erro de 0,003%)
+#define MPU6050_GYRO_MDPS_MULT 7817
+#define MPU6050_GYRO_MDPS_SHIFT 10
+//Temperatura: °C = contagem / 340 + 12,53 (datasheet + calibração); em centésimos, 100/340 em Q16
+#define MPU6050_TEMP_CENTI_MULT 19275
+#define MPU6050_TEMP_CENTI_SHIFT 16
+#define MPU6050_TEMP_CENTI_OFFSET 1253
+
+//Canais lidos do sensor (mpu6050_set_channels): um bit por eixo, na ordem das features do modelo
+#define MPU6050_CH_ACCEL_X 0x01
+#define MPU6050_CH_ACCEL_Y 0x02
+#define MPU6050_CH_ACCEL_Z 0x04
+#define MPU6050_CH_GYRO_X  0x08
+#define MPU6050_CH_GYRO_Y  0x10
+#define MPU6050_CH_GYRO_Z  0x20
+#define MPU6050_CH_ACCEL   0x07
+#define MPU6050_CH_GYRO    0x38
+#define MPU6050_CH_ALL     0x3F
+//Número de canais de uma máscara (constante em tempo de compilação)
+#define MPU6050_CHANNEL_COUNT(mask) \
+    (((mask) & 1) + (((mask) >> 1) & 1) + (((mask) >> 2) & 1) + (((mask) >> 3) & 1) + (((mask) >> 4) & 1) + \
+     (((mask) >> 5) & 1))
+
+//Bytes de um frame na FIFO com todos os canais (aceleração + giroscópio, sem temperatura)
+#define MPU6050_FIFO_FRAME_BYTES 12
+//Capacidade da FIFO interna do MPU6050
+#define MPU6050_FIFO_SIZE 1024
+
+//Endereços I2C: pino AD0 em 0 (padrão) ou em 1; dois sensores por barramento
+#define MPU6050_ADDR     0x68
+#define MPU6050_ADDR_ALT 0x69
+
+//Um MPU6050: barramento, endereço, canais escolhidos e a leitura da FIFO em andamento
+//Vários sensores podem dividir uma porta (endereços diferentes); cada um tem o seu estado
+typedef struct {
+    i2c_inst_t *i2c;
+    uint8_t addr;
+    //Canais escolhidos e o que eles custam: trecho dos registradores de dados lido por amostra
+    //(deslocamento a partir de ACCEL_XOUT_H e tamanho) e bytes por frame na FIFO
+    uint8_t channel_mask;
+    uint8_t span_first, span_len;
+    uint8_t fifo_frame_bytes;
+    int16_t last_temp_raw;            //temperatura bruta da última leitura por registrador
+    mpu6050_frame_t *pending_frames;  //leitura da FIFO em andamento por DMA (mpu6050_fifo_read_start)
+    int pending_count;
+} mpu6050_t;
+
+//Filtro passa-baixa digital (CONFIG.DLPF_CFG): banda do acelerômetro
+//Com MPU6050_DLPF_260HZ o giroscópio amostra a 8 kHz, nos outros a 1 kHz
+typedef enum {
+    MPU6050_DLPF_260HZ = 0,
+    MPU6050_DLPF_184HZ = 1,
+    MPU6050_DLPF_94HZ = 2,
+    MPU6050_DLPF_44HZ = 3,
+    MPU6050_DLPF_21HZ = 4,
+    MPU6050_DLPF_10HZ = 5,
+    MPU6050_DLPF_5HZ = 6
+} mpu6050_dlpf_t;
+
+//Inicializa o sensor no endereço addr (MPU6050_ADDR ou MPU6050_ADDR_ALT) da porta i2c,
+//configurando-o e tirando-o do modo de suspensão
+void mpu6050_init(mpu6050_t *dev, i2c_inst_t *i2c, uint8_t addr);
 
 //Lê os dados brutos do MPU6050, converte para unidades padrão e preenche a estrutura fornecida
-void mpu6050_read_data(mpu6050_data_t *data);
+void mpu6050_read_data(mpu6050_t *dev, mpu6050_data_t *data);
+
+//Escolhe os canais lidos (MPU6050_CH_*, padrão MPU6050_CH_ALL); chame antes de mpu6050_fifo_start
+//- leitura por registrador: só o trecho de ACCEL_XOUT_H..GYRO_ZOUT_L entre o primeiro e o último
+//  canal (MPU6050_CH_ACCEL lê 6 bytes em vez de 14; a temperatura só vem se estiver no trecho)
+//- FIFO: a aceleração entra com os 3 eixos (o MPU6050 não separa) se algum foi escolhido, e o
+//  giroscópio só com os eixos escolhidos (MPU6050_CH_ACCEL grava 6 bytes por frame em vez de 12)
+//Os canais fora da máscara ficam em 0 nos frames
+void mpu6050_set_channels(mpu6050_t *dev, uint8_t channels);
+
+//Canais escolhidos com mpu6050_set_channels
+uint8_t mpu6050_channels(const mpu6050_t *dev);
+
+//Bytes de dados por amostra no barramento: leitura por registrador e frame da FIFO
+unsigned int mpu6050_sample_bytes(const mpu6050_t *dev);
+unsigned int mpu6050_fifo_frame_bytes(const mpu6050_t *dev);
+
+//Copia para out as contagens dos canais de mask, na ordem Acel_X..Giro_Z
+//(MPU6050_CHANNEL_COUNT(mask) valores, a entrada de um modelo treinado só com esses canais)
+static inline void mpu6050_gather_channels(uint8_t mask, const int16_t accel[3], const int16_t gyro[3], int16_t *out) {
+    int n = 0;
+    for (int c = 0; c < 6; c++) {
+        if (mask & (1u << c)) out[n++] = c < 3 ? accel[c] : gyro[c - 3];
+    }
+}
+
+//Canal (0..5, Acel_X..Giro_Z) do n-ésimo bit de mask, -1 se mask tem menos canais
+static inline int mpu6050_channel_index(uint8_t mask, int n) {
+    for (int c = 0; c < 6; c++) {
+        if ((mask & (1u << c)) && n-- == 0) return c;
+    }
+    return -1;
+}
+
+//Lê uma amostra dos registradores sem converter (contagens, como na FIFO), numa leitura em rajada
+//A temperatura vem na mesma rajada e fica guardada bruta (mpu6050_last_temp_raw), sem conversão
+void mpu6050_read_frame(mpu6050_t *dev, mpu6050_frame_t *frame);
+
+//Temperatura bruta da última leitura por registrador (mpu6050_read_frame ou mpu6050_read_data)
+int16_t mpu6050_last_temp_raw(const mpu6050_t *dev);
+
+//Temperatura em centésimos de °C só com inteiros (mesma fórmula do mpu6050_read_data)
+static inline int32_t mpu6050_temp_centi_c(int16_t raw) {
+    return ((raw * MPU6050_TEMP_CENTI_MULT + (1 << (MPU6050_TEMP_CENTI_SHIFT - 1))) >> MPU6050_TEMP_CENTI_SHIFT) +
+           MPU6050_TEMP_CENTI_OFFSET;
+}
+
+//Taxa de amostragem interna (divisor de 1 kHz, ou 8 kHz sem DLPF) e filtro passa-baixa; é o ritmo
+//da FIFO e da interrupção de dados prontos. Retorna a taxa realmente configurada em Hz
+uint32_t mpu6050_set_sample_rate(mpu6050_t *dev, uint32_t rate_hz, mpu6050_dlpf_t dlpf);
+
+//Pino INT: um pulso de 50 us (ativo em nível alto) a cada amostra nova, no ritmo de
+//mpu6050_set_sample_rate; o MPU6050 não tem interrupção de nível da FIFO, então no modo FIFO quem
+//espera uma rajada conta os pulsos. false desliga a interrupção
+void mpu6050_enable_data_ready_int(mpu6050_t *dev, bool enable);
+
+//Modo FIFO: o próprio sensor amostra a rate_hz (divisor de 1 kHz, ou 8 kHz sem DLPF) e guarda
+//os frames na FIFO; o firmware só precisa drenar antes de encher (MPU6050_FIFO_SIZE bytes)
+//Retorna a taxa realmente configurada em Hz (a divisão é inteira)
+uint32_t mpu6050_fifo_start(mpu6050_t *dev, uint32_t rate_hz, mpu6050_dlpf_t dlpf);
+
+//Desliga a FIFO e volta ao modo de leitura por registrador
+void mpu6050_fifo_stop(mpu6050_t *dev);
+
+//Drena até max_frames frames da FIFO (os mais antigos primeiro) numa única leitura em rajada
+//Retorna quantos frames foram lidos (0 se vazia) ou -1 se a FIFO transbordou: nesse caso ela
+//é zerada e as amostras acumuladas se perdem (a série temporal tem um buraco)
+//Equivale a mpu6050_fifo_read_start + mpu6050_fifo_read_finish
+int mpu6050_fifo_read(mpu6050_t *dev, mpu6050_frame_t *frames, int max_frames);
+
+//Versão não bloqueante (DMA, i2c_dma.h): lê o status e o contador da FIFO e dispara a rajada
+//de até max_frames frames (no máximo I2C_DMA_MAX_LEN / MPU6050_FIFO_FRAME_BYTES) para frames
+//Retorna quantos frames estão a caminho, 0 se não havia nada (ou outra leitura em andamento)
+//ou -1 se a FIFO transbordou. frames só pode ser lido depois do mpu6050_fifo_read_finish e
+//nenhum sensor da mesma porta pode ser usado enquanto a leitura não termina
+int mpu6050_fifo_read_start(mpu6050_t *dev, mpu6050_frame_t *frames, int max_frames);
+
+//true enquanto a rajada iniciada por mpu6050_fifo_read_start está no barramento
+bool mpu6050_fifo_read_busy(const mpu6050_t *dev);
+
+//Espera a rajada terminar e converte os frames para a ordem de bytes nativa
+//Retorna quantos frames foram lidos (0 se nada foi iniciado) ou -1 se o sensor não respondeu
+int mpu6050_fifo_read_finish(mpu6050_t *dev);
+
+//Converte um frame bruto para unidades físicas (temp_c não é alterado, a FIFO não guarda temperatura)
+void mpu6050_frame_to_data(const mpu6050_frame_t *frame, mpu6050_data_t *data);
+
+//Converte um frame bruto para mm/s² e m°/s com as escalas MPU6050_*_MULT, sem ponto flutuante
+void mpu6050_frame_to_fixed(const mpu6050_frame_t *frame, mpu6050_fixed_t *fixed);
+
+#ifdef __cplusplus
+}
+#endif
 
-#endif // MPU6050_H
\ No newline at end of file
+#endif // MPU6050_H
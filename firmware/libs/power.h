@@ -0,0 +1,63 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Espera de baixo consumo entre as rajadas do sensor
+// O pino INT do MPU6050 (pulso de dados prontos, mpu6050_enable_data_ready_int) vai para um GPIO com
+// interrupção na borda de subida. A rotina de interrupção só conta os pulsos e, a cada
+// frames_per_event, marca o sensor como pronto: uma amostra no modo por registrador ou uma rajada
+// da FIFO no modelo de janelas (o MPU6050 não tem interrupção de nível da FIFO)
+// power_sleep_until dorme em WFE com SLEEPDEEP: no RP2040 os clocks dos periféricos que o firmware
+// não usa (ADC, PIO, PWM, RTC, SPI, UART) ficam desligados enquanto os dois cores dormem. Acorda no
+// alarme do timer (próxima tarefa) ou em qualquer interrupção, e só volta quando o prazo chegou ou
+// o sensor está pronto
+// O modo dormant (osciladores parados) não serve aqui: pararia o timer do escalonador e a USB
+// No host o pino é simulado (host_gpio_attach_source) e os pulsos chegam enquanto o core espera
+
+// Tempo dormindo de um core; só o próprio core escreve (load + store, sem read-modify-write no M0+)
+// e os totais de 32 bits dão a volta (o relatório usa diferenças, janelas de até ~71 min)
+typedef struct {
+    atomic_uint sleep_us;        // total dormindo em power_sleep_until
+    atomic_uint sleeps;          // esperas que chegaram a dormir
+    atomic_uint sensor_wakeups;  // esperas encerradas pelo sensor
+} power_meter_t;
+
+// Estado do relatório anterior (power_report mostra só o intervalo desde ele)
+typedef struct {
+    uint64_t at_us;
+    uint32_t sleep_us, sleeps, sensor_wakeups;
+} power_window_t;
+
+// Liga o gating de clocks do sono e a interrupção do sensor em int_gpio, no core que chama (é ele
+// que acorda com o pulso); frames_per_event >= 1
+void power_init(unsigned int int_gpio, uint32_t frames_per_event);
+
+// true se o sensor tem dados desde o último power_sensor_ack
+bool power_sensor_pending(void);
+
+// Chame antes de ler o sensor: um pulso que chega durante a leitura marca o próximo evento
+void power_sensor_ack(void);
+
+// Dorme até until_us (time_us_64) ou, com wake_on_sensor (só no core da interrupção), até o sensor
+// ficar pronto
+void power_sleep_until(power_meter_t *m, uint64_t until_us, bool wake_on_sensor);
+
+// Começa a janela do primeiro relatório a partir dos totais atuais do medidor
+void power_window_start(power_window_t *w, const power_meter_t *m);
+
+// Imprime a fração do tempo dormindo desde o relatório anterior, as esperas, as acordadas pelo
+// sensor e, por classificação, o tempo ativo (em us e ciclos do clk_sys) e o tempo dormindo
+void power_report(const power_meter_t *m, power_window_t *w, const char *name, uint32_t classifications);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POWER_H
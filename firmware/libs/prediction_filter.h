@@ -0,0 +1,95 @@
+#ifndef PREDICTION_FILTER_H
+#define PREDICTION_FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Pós-processamento das saídas do tflm_infer: o nível mostrado só muda quando a troca se sustenta
+//   1. média móvel exponencial dos scores (PREDICTION_EMA_ALPHA)
+//   2. voto da maioria entre os últimos PREDICTION_VOTE_WINDOW argmax da média
+//   3. histerese: o nível vencedor do voto só substitui o atual se a sua média passar a do atual
+//      por PREDICTION_HYSTERESIS e ficar acima de PREDICTION_MIN_CONFIDENCE (gate de confiança)
+// O(1) por previsão: o voto mantém a contagem por classe e só troca o voto que sai da janela
+// Com alpha 1, janela 1, histerese 0 e confiança mínima 0 o filtro devolve o argmax cru
+//
+// Duty cycle adaptativo: a cada PREDICTION_STABLE_RUNS previsões seguidas em que o argmax da média
+// é o nível atual com média >= PREDICTION_STABLE_CONFIDENCE, o passo dobra (até
+// PREDICTION_MAX_STRIDE); qualquer outra previsão volta o passo para 1. O firmware roda o modelo
+// em uma a cada prediction_filter_stride amostras/janelas. prediction_filter_settled diz se as
+// últimas PREDICTION_STABLE_RUNS previsões foram firmes (o detector de mudança só pula inferências assim)
+
+#ifndef PREDICTION_NUM_CLASSES
+#define PREDICTION_NUM_CLASSES 4
+#endif
+#ifdef MOTOR_WINDOW_FEATURES
+// Cada previsão do modelo de janelas já resume WINDOW_SIZE amostras: suavização mais leve e passo
+// máximo menor (uma previsão a cada 100 ms, o passo 8 atrasaria a troca de nível em segundos)
+#ifndef PREDICTION_EMA_ALPHA
+#define PREDICTION_EMA_ALPHA 0.5f
+#endif
+#ifndef PREDICTION_VOTE_WINDOW
+#define PREDICTION_VOTE_WINDOW 3
+#endif
+#ifndef PREDICTION_MAX_STRIDE
+#define PREDICTION_MAX_STRIDE 4
+#endif
+#endif
+#ifndef PREDICTION_EMA_ALPHA
+#define PREDICTION_EMA_ALPHA 0.3f
+#endif
+#ifndef PREDICTION_VOTE_WINDOW
+#define PREDICTION_VOTE_WINDOW 5
+#endif
+#ifndef PREDICTION_HYSTERESIS
+#define PREDICTION_HYSTERESIS 0.1f
+#endif
+#ifndef PREDICTION_MIN_CONFIDENCE
+#define PREDICTION_MIN_CONFIDENCE 0.5f
+#endif
+#ifndef PREDICTION_STABLE_CONFIDENCE
+#define PREDICTION_STABLE_CONFIDENCE 0.9f
+#endif
+#ifndef PREDICTION_STABLE_RUNS
+#define PREDICTION_STABLE_RUNS 8
+#endif
+// 1 desliga o duty cycle
+#ifndef PREDICTION_MAX_STRIDE
+#define PREDICTION_MAX_STRIDE 8
+#endif
+
+typedef struct {
+    float ema[PREDICTION_NUM_CLASSES];
+    bool primed;                                 // ema já recebeu a primeira previsão
+    uint8_t votes[PREDICTION_VOTE_WINDOW];       // anel dos últimos argmax da média
+    uint8_t vote_counts[PREDICTION_NUM_CLASSES];
+    uint32_t vote_pos, vote_fill;
+    int level;                                   // nível estável (-1 antes da primeira previsão)
+    float confidence;                            // média do nível estável
+    uint32_t stable_runs;
+    uint32_t stride;                             // 1..PREDICTION_MAX_STRIDE
+    bool settled;                                // PREDICTION_STABLE_RUNS previsões firmes desde a última dúvida
+} prediction_filter_t;
+
+void prediction_filter_init(prediction_filter_t *f);
+
+// Acrescenta os scores de uma inferência e devolve o nível estável (f->confidence é a sua média)
+int prediction_filter_update(prediction_filter_t *f, const float scores[PREDICTION_NUM_CLASSES]);
+
+// Amostras/janelas por inferência no momento
+static inline uint32_t prediction_filter_stride(const prediction_filter_t *f) {
+    return f->stride;
+}
+
+static inline bool prediction_filter_settled(const prediction_filter_t *f) {
+    return f->settled;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PREDICTION_FILTER_H
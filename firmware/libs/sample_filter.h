@@ -0,0 +1,49 @@
+#ifndef SAMPLE_FILTER_H
+#define SAMPLE_FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sample_filter_coeffs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Filtro anti-aliasing + decimação entre o sensor e o modelo, em ponto fixo
+// O sensor é lido SAMPLE_FILTER_DECIMATION vezes mais rápido que a taxa do modelo e cada canal
+// (contagens brutas do MPU6050) passa por:
+//   - uma cascata de SAMPLE_FILTER_SECTIONS biquads (Butterworth passa-baixa, coeficientes Q14,
+//     forma direta I com acumulador int32 e saturação em int16), a cada entrada
+//   - um FIR passa-baixa de SAMPLE_FILTER_TAPS coeficientes Q15, avaliado só uma vez a cada
+//     SAMPLE_FILTER_DECIMATION entradas (o decimador polifásico: as saídas descartadas nem são
+//     calculadas)
+// Trabalho por entrada O(seções + taps / decimação), estado todo estático no sample_filter_t
+// Os coeficientes vêm de sample_filter_coeffs.h (tools/sample_filter.py, seção 7 do notebook); a
+// mesma conta em Python filtra os CSVs do treino, então o modelo vê o mesmo sinal do firmware
+// O gerador garante ganho DC 1 nos inteiros e que os acumuladores cabem em 32 bits
+
+#define SAMPLE_FILTER_CHANNELS 6 // Accel X/Y/Z, Gyro X/Y/Z (ordem do mpu6050_frame_t)
+
+typedef struct {
+    int16_t iir[SAMPLE_FILTER_CHANNELS][SAMPLE_FILTER_SECTIONS][4]; // x[n-1], x[n-2], y[n-1], y[n-2]
+    // Histórico do FIR gravado duas vezes (pos e pos + TAPS): as últimas TAPS amostras ficam
+    // sempre contíguas, sem módulo no produto interno
+    int16_t history[SAMPLE_FILTER_CHANNELS][2 * SAMPLE_FILTER_TAPS];
+    uint16_t pos;    // próxima posição do histórico
+    uint16_t phase;  // entradas desde a última saída
+    bool primed;     // estado preenchido com a primeira amostra
+} sample_filter_t;
+
+// Zera o filtro; a primeira amostra preenche todo o estado (regime, sem o transitório da gravidade)
+void sample_filter_init(sample_filter_t *f);
+
+// Uma amostra na taxa do sensor; true a cada SAMPLE_FILTER_DECIMATION entradas, com a amostra
+// filtrada na taxa do modelo em out (pode ser o próprio in)
+bool sample_filter_push(sample_filter_t *f, const int16_t in[SAMPLE_FILTER_CHANNELS],
+                        int16_t out[SAMPLE_FILTER_CHANNELS]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAMPLE_FILTER_H
@@ -0,0 +1,23 @@
+// Sample Filter Coefficients - anti-alias + decimation between the MPU6050 and the model
+// Auto-generated file - Do not edit manually (tools/sample_filter.py, notebook section 7)
+
+#ifndef SAMPLE_FILTER_COEFFS_H
+#define SAMPLE_FILTER_COEFFS_H
+
+// Sensor at 500 Hz, model at 100 Hz, low-pass cutoff 40 Hz
+#define SAMPLE_FILTER_DECIMATION 5
+#define SAMPLE_FILTER_OUTPUT_HZ 100
+#define SAMPLE_FILTER_CUTOFF_HZ 40
+
+// Butterworth biquads {b0, b1, b2, a1, a2} in Q14 (a0 = 1), unity DC gain
+#define SAMPLE_FILTER_SECTIONS 2
+#define SAMPLE_FILTER_BIQUADS { \
+    {856, 1710, 856, -24245, 11283}, \
+    {701, 1403, 701, -19871, 6292} \
+}
+
+// FIR low-pass taps in Q15 (sum = 32768), evaluated once per SAMPLE_FILTER_DECIMATION inputs
+#define SAMPLE_FILTER_TAPS 15
+#define SAMPLE_FILTER_FIR {-49, 31, 348, 1158, 2499, 4082, 5377, 5876, 5377, 4082, 2499, 1158, 348, 31, -49}
+
+#endif // SAMPLE_FILTER_COEFFS_H
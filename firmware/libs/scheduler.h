@@ -0,0 +1,69 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Escalonador cooperativo de tarefas periódicas (um por core)
+// Cada tarefa é liberada a cada period_us e deve terminar até deadline_us depois da liberação;
+// entre as tarefas liberadas roda a de prazo mais próximo (EDF), sempre até o fim (sem preempção)
+// Sem tarefa liberada o core dorme até a próxima liberação (sleep_us: alarme do timer + WFE no RP2040)
+// Terminar depois do prazo conta como perda de prazo; liberações que passaram enquanto a tarefa
+// atrasada ainda não tinha rodado são puladas (não acumulam) e também contam como perdidas
+// Tarefas por evento (ready): liberadas assim que ready() devolve true (ex: interrupção do sensor),
+// com o prazo contado daí; period_us vira o tempo máximo sem evento, contado da última execução
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+    uint32_t period_us;
+    uint32_t deadline_us;  // relativo à liberação; 0 = o próprio período
+    bool (*ready)(void);   // opcional: evento que libera a tarefa antes do período
+
+    // Preenchidos pelo escalonador
+    uint64_t release_us;   // próxima liberação (time_us_64)
+    uint32_t runs;         // execuções desde o último scheduler_reset_stats
+    uint32_t misses;       // prazos perdidos desde o último scheduler_reset_stats
+    uint32_t max_us;       // maior tempo de execução
+    uint64_t busy_us;      // tempo total de execução
+} scheduler_task_t;
+
+typedef struct {
+    scheduler_task_t *tasks;
+    size_t count;
+    uint64_t stats_start_us; // início da janela de estatísticas
+    // Espera sem tarefa liberada até until_us (time_us_64); pode voltar antes (ex: evento de uma
+    // tarefa). NULL: sleep_us
+    void (*idle)(uint64_t until_us);
+} scheduler_t;
+
+// tasks precisa continuar válido; a primeira liberação de cada tarefa é um período depois
+// (a tarefa de relatório não mede uma janela vazia e as tarefas não saem todas juntas)
+// idle começa NULL
+void scheduler_init(scheduler_t *s, scheduler_task_t *tasks, size_t count);
+
+// Roda a tarefa liberada de prazo mais próximo ou dorme até a próxima liberação
+void scheduler_step(scheduler_t *s);
+
+// scheduler_step para sempre
+void scheduler_run(scheduler_t *s);
+
+// Fração do tempo desde o último scheduler_reset_stats gasta nas tarefas (0..1)
+float scheduler_cpu_load(const scheduler_t *s);
+
+// Imprime execuções, prazos perdidos, pior tempo por tarefa e a carga da CPU
+void scheduler_print_stats(const scheduler_t *s);
+
+// Zera as estatísticas e começa uma nova janela
+void scheduler_reset_stats(scheduler_t *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCHEDULER_H
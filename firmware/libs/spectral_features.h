@@ -0,0 +1,51 @@
+#ifndef SPECTRAL_FEATURES_H
+#define SPECTRAL_FEATURES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Energia por banda de frequência das últimas SPECTRAL_FFT_SIZE amostras de cada eixo
+// As amostras ficam em Q15 (a mesma escala das contagens brutas do MPU6050), a média da janela
+// é removida e a FFT real em ponto fixo (fft_q15.h) é agrupada em SPECTRAL_BANDS bandas iguais
+// A mesma conta está em tools/spectral_features.py, usado pelo notebook para treinar o modelo
+
+#define SPECTRAL_FFT_SIZE 64    // amostras por janela (potência de 2, até FFT_Q15_MAX_SIZE)
+#define SPECTRAL_BANDS 4        // bandas por eixo (divide os bins 1..SPECTRAL_FFT_SIZE/2)
+#define SPECTRAL_AXES 6         // Accel X/Y/Z, Gyro X/Y/Z (mesma ordem do in_features)
+#define SPECTRAL_NUM_FEATURES (SPECTRAL_AXES * SPECTRAL_BANDS)
+
+// Unidade física -> Q15: mesmas sensibilidades do mpu6050.c (±2g e ±250°/s)
+#define SPECTRAL_ACCEL_TO_Q15 1670.13252f  // 16384 LSB/g / 9.81 m/s²
+#define SPECTRAL_GYRO_TO_Q15 131.0f        // 131 LSB/(°/s)
+
+typedef struct {
+    int16_t samples[SPECTRAL_AXES][SPECTRAL_FFT_SIZE];  // ring buffer em Q15
+    uint16_t head;   // próxima posição a ser escrita (a mais antiga quando a janela está cheia)
+    uint16_t count;  // amostras na janela (satura em SPECTRAL_FFT_SIZE)
+} spectral_features_t;
+
+// Zera a janela
+void spectral_features_init(spectral_features_t *s);
+
+// Adiciona uma amostra [Accel_X, Accel_Y, Accel_Z, Gyro_X, Gyro_Y, Gyro_Z] (O(1), a FFT só roda no compute)
+void spectral_features_push(spectral_features_t *s, const float sample[SPECTRAL_AXES]);
+
+// O mesmo direto das contagens do MPU6050 (mpu6050_frame_t, já em Q15), sem ponto flutuante
+void spectral_features_push_counts(spectral_features_t *s, const int16_t counts[SPECTRAL_AXES]);
+
+// true quando a janela já tem SPECTRAL_FFT_SIZE amostras
+bool spectral_features_ready(const spectral_features_t *s);
+
+// Energia de cada banda na unidade física ao quadrado, agrupada por eixo: out[eixo * SPECTRAL_BANDS + banda]
+// (banda 0 = frequências mais baixas, sem o DC)
+void spectral_features_compute(const spectral_features_t *s, float out[SPECTRAL_NUM_FEATURES]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPECTRAL_FEATURES_H
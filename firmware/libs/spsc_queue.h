@@ -0,0 +1,42 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Fila sem trava de um produtor e um consumidor (ex: core 1 -> core 0, ou duas threads no host)
+// Itens de tamanho fixo copiados para um vetor fornecido pelo chamador; head só é escrito pelo
+// produtor e tail só pelo consumidor, com acquire/release para publicar o conteúdo do item
+// Só usa loads/stores atômicos de 32 bits, então funciona no Cortex-M0+ (sem LDREX/STREX)
+
+typedef struct {
+    uint8_t *items;
+    size_t item_size;
+    uint32_t capacity;     // potência de 2
+    atomic_uint head;      // próximo slot a ser escrito (produtor)
+    atomic_uint tail;      // próximo slot a ser lido (consumidor)
+} spsc_queue_t;
+
+// storage precisa ter capacity * item_size bytes; capacity precisa ser potência de 2
+void spsc_queue_init(spsc_queue_t *q, void *storage, size_t item_size, uint32_t capacity);
+
+// Produtor: copia o item para a fila; false se estiver cheia (o item não entra)
+bool spsc_queue_push(spsc_queue_t *q, const void *item);
+
+// Consumidor: copia o item mais antigo para item; false se estiver vazia
+bool spsc_queue_pop(spsc_queue_t *q, void *item);
+
+// Itens na fila (aproximado se chamado enquanto a outra ponta mexe nela)
+uint32_t spsc_queue_count(spsc_queue_t *q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPSC_QUEUE_H
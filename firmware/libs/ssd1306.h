@@ -13,6 +13,13 @@ typedef struct {
     uint16_t bufsize;
     uint8_t *ram_buffer;
     uint8_t port_buffer[2];
+    // Região alterada desde o último ssd1306_send_data (dirty_col0 > dirty_col1: nada a enviar)
+    uint8_t dirty_col0, dirty_col1;
+    uint8_t dirty_page0, dirty_page1;
+    // Envio por DMA (ssd1306_enable_dma): cópia da região alterada em palavras do IC_DATA_CMD,
+    // transmitida em segundo plano enquanto o ram_buffer já recebe o próximo quadro
+    uint16_t *dma_cmds;
+    bool dma_active;
 } ssd1306_t;
 
 // Inicialização e configuração
@@ -22,7 +29,24 @@ void ssd1306_config(ssd1306_t *ssd);
 
 // Comunicação I2C
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+// Envia só o retângulo de páginas/colunas alterado pelas funções de desenho
 void ssd1306_send_data(ssd1306_t *ssd);
+// Marca a tela inteira para reenvio (ex: depois de reconfigurar ou resetar o painel)
+void ssd1306_invalidate(ssd1306_t *ssd);
+
+// Buffer duplo com envio por DMA (i2c_dma.h): o ram_buffer é o buffer de desenho e o
+// ssd1306_send_data_async copia a região alterada para o buffer de envio, que o DMA transmite
+// sem ocupar a CPU. No build host o envio é síncrono (os quadros continuam sendo capturados)
+// Retorna false se não conseguiu alocar o buffer de envio (o display segue síncrono)
+bool ssd1306_enable_dma(ssd1306_t *ssd);
+// Inicia o envio da região alterada e retorna sem esperar. Se o envio anterior ainda está no
+// barramento não faz nada e retorna false: a região continua pendente para a próxima chamada
+// Sem ssd1306_enable_dma é o ssd1306_send_data
+bool ssd1306_send_data_async(ssd1306_t *ssd);
+// true enquanto um envio assíncrono está no barramento
+bool ssd1306_send_busy(ssd1306_t *ssd);
+// Espera o envio assíncrono em andamento, se houver (as funções síncronas já chamam)
+void ssd1306_send_wait(ssd1306_t *ssd);
 
 // Funções de desenho básicas
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
@@ -0,0 +1,75 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "mpu6050.h"
+#include "scheduler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Telemetria binária pela USB (stdio), no lugar dos printf com %f
+// Cada mensagem vira um quadro: tipo, sequência, carimbo de tempo (time_us_32), carga útil e
+// CRC-16/CCITT, codificado em COBS e delimitado por 0x00 antes e depois. O 0x00 inicial
+// ressincroniza o leitor depois de texto solto (printf de boot ou de erro) no mesmo fluxo
+// Todos os campos são little-endian; tools/telemetry_decode.py decodifica o fluxo
+//
+// Carga útil por tipo:
+//   HELLO      u8 versão, u16 taxa de amostragem (Hz), u8 classes, u8 motores
+//   SAMPLES    u8 n, n x (i16 acel[3], i16 giro[3]) em contagens do MPU6050 (16384 LSB/g, 131 LSB/°/s),
+//              u8 motor; o carimbo é o da última amostra do lote
+//   PREDICTION i8 nível estável (prediction_filter.h), u32 duração da inferência (us), u8 n,
+//              n x u16 score cru do modelo em Q16 (score * 65535), u8 motor
+//   STATUS     u16 carga da CPU (0,01%), u32 amostras/janelas descartadas, u8 n,
+//              n x (u16 execuções, u16 prazos perdidos, u32 pior tempo em us, u8 m, m bytes do nome)
+// Versão 2 acrescentou os campos de motor no fim das cargas (MOTOR_SENSOR_COUNT sensores por nó);
+// um leitor da versão 1 só ignora o byte a mais
+
+#define TELEMETRY_VERSION 2
+
+// Maior carga útil de um quadro (um lote de até 20 amostras); com o cabeçalho e o CRC o quadro
+// fica abaixo de 254 bytes e o COBS acrescenta um byte só
+#define TELEMETRY_MAX_PAYLOAD 242
+#define TELEMETRY_MAX_SAMPLES ((TELEMETRY_MAX_PAYLOAD - 2) / MPU6050_FIFO_FRAME_BYTES)
+// Nomes de tarefa maiores são cortados no STATUS
+#define TELEMETRY_MAX_TASK_NAME 15
+
+typedef enum {
+    TELEMETRY_MSG_HELLO = 0,
+    TELEMETRY_MSG_SAMPLES = 1,
+    TELEMETRY_MSG_PREDICTION = 2,
+    TELEMETRY_MSG_STATUS = 3,
+    TELEMETRY_MSG_COUNT
+} telemetry_msg_t;
+
+// Verbosidade: cada nível inclui os anteriores
+typedef enum {
+    TELEMETRY_OFF = 0,          // nada é enviado (as funções retornam sem montar o quadro)
+    TELEMETRY_STATUS = 1,       // HELLO + STATUS do escalonador
+    TELEMETRY_PREDICTIONS = 2,  // + cada inferência com os scores
+    TELEMETRY_RAW = 3           // + todas as amostras brutas do sensor
+} telemetry_level_t;
+
+// Define a verbosidade e envia o HELLO (nada se level == TELEMETRY_OFF)
+void telemetry_init(telemetry_level_t level, uint16_t sample_rate_hz, uint8_t num_classes, uint8_t num_motors);
+
+telemetry_level_t telemetry_level(void);
+
+// Amostras brutas (TELEMETRY_RAW); lotes maiores que TELEMETRY_MAX_SAMPLES saem em vários quadros
+// Pode ser chamada de outro core que as demais: cada tipo tem a sua sequência e o quadro
+// inteiro sai numa escrita só
+void telemetry_send_samples(uint8_t motor, const mpu6050_frame_t *frames, int n);
+
+// Resultado de uma inferência do motor dado (TELEMETRY_PREDICTIONS); scores em 0..1
+void telemetry_send_prediction(uint8_t motor, int level, const float *scores, int num_scores, uint32_t infer_us);
+
+// Estatísticas do escalonador desde o último scheduler_reset_stats (TELEMETRY_STATUS)
+void telemetry_send_status(const scheduler_t *s, uint32_t dropped);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TELEMETRY_H
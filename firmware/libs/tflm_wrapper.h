@@ -1,6 +1,28 @@
 #ifndef TFLM_WRAPPER_H_
 #define TFLM_WRAPPER_H_
 
+#include <stdint.h>
+
+//Features de entrada do modelo: a amostra do MPU6050 (6, ou só os canais de MOTOR_SENSOR_CHANNELS
+//com MOTOR_CHANNEL_MODEL) ou, com o modelo de janelas
+//(MOTOR_WINDOW_FEATURES), as WINDOW_NUM_FEATURES de window_features_compute
+//seguidas, com MOTOR_SPECTRAL_FEATURES, das SPECTRAL_NUM_FEATURES de spectral_features_compute
+#ifdef MOTOR_WINDOW_FEATURES
+#include "window_features.h"
+#ifdef MOTOR_SPECTRAL_FEATURES
+#include "spectral_features.h"
+#define TFLM_NUM_FEATURES (WINDOW_NUM_FEATURES + SPECTRAL_NUM_FEATURES)
+#else
+#define TFLM_NUM_FEATURES WINDOW_NUM_FEATURES
+#endif
+#elif defined(MOTOR_CHANNEL_MODEL)
+//modelo de canais reduzidos: uma feature por canal de MOTOR_SENSOR_CHANNELS (motor_channel_model.h)
+#include "mpu6050.h"
+#define TFLM_NUM_FEATURES MPU6050_CHANNEL_COUNT(MOTOR_SENSOR_CHANNELS)
+#else
+#define TFLM_NUM_FEATURES 6
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -10,11 +32,67 @@ int tflm_init_model(void);
 
 //Executa inferência no modelo de classificação de motor
 //in_features: array com 6 features [Accel_X, Accel_Y, Accel_Z, Gyro_X, Gyro_Y, Gyro_Z]
+//(ou as features da janela com MOTOR_WINDOW_FEATURES)
 //out_scores: array de saída com 4 probabilidades [Level 0, Level 1, Level 2, Level 3]
-int tflm_infer(const float in_features[6], float out_scores[4]);
+int tflm_infer(const float in_features[TFLM_NUM_FEATURES], float out_scores[4]);
+
+#ifndef MOTOR_WINDOW_FEATURES
+//Executa inferência direto das contagens de um frame do MPU6050 (mpu6050_frame_t, ±2g e ±250°/s)
+//Com MOTOR_CHANNEL_MODEL só os canais de MOTOR_SENSOR_CHANNELS entram no modelo
+//No modelo int8 a entrada é quantizada só com inteiros (as escalas do sensor vêm embutidas em
+//ponto fixo); nos modelos float as contagens viram m/s² e °/s antes do forward
+int tflm_infer_frame(const int16_t accel[3], const int16_t gyro[3], float out_scores[4]);
+#endif
+
+//Executa inferência em n amostras de uma vez (ex: um burst do acelerometro)
+//in: n * TFLM_NUM_FEATURES features (amostra i em in[i * TFLM_NUM_FEATURES]), out: n * 4 probabilidades (amostra i em out[i * 4])
+//no TFLM cada Invoke processa MOTOR_MODEL_BATCH amostras se o modelo foi exportado com batch fixo
+int tflm_infer_batch(const float* in, float* out, int n);
+
+//Bytes do tensor_arena realmente usados depois do AllocateTensors (0 se nao iniciado)
+//com modelos extras registrados e o total de todos eles (a arena e uma so)
+unsigned int tflm_arena_used_bytes(void);
+
+//Registro de modelos: alem do modelo do motor (TFLM_MAIN_MODEL, o das funcoes acima) cabem ate
+//TFLM_MAX_MODELS - 1 modelos extras na flash (ex: um modelo de falha/anomalia), cada um com o seu
+//MicroInterpreter sobre o mesmo tensor_arena
+//O planejamento da arena sai uma vez so no tflm_init_model: os buffers persistentes de cada
+//modelo se acumulam no fim da arena e as ativacoes (o trecho nao persistente) sao compartilhadas,
+//do tamanho das do maior modelo. Por isso os modelos rodam um de cada vez e a entrada/saida de um
+//modelo nao sobrevive ao Invoke de outro (as funcoes copiam as duas dentro da mesma chamada)
+//No motor denso (dense_engine.cpp) so o modelo do motor existe: nao ha interpretador para um
+//flatbuffer qualquer e o tflm_register_model sempre falha
+#define TFLM_MAX_MODELS 4
+#define TFLM_MAIN_MODEL 0
+
+typedef int tflm_model_handle;
+
+//Registra um modelo .tflite (array gerado como o motor_model.h) antes do tflm_init_model
+//O modelo tem que usar as mesmas ops do modelo do motor (FullyConnected, Relu, Softmax, Reshape),
+//entrada [batch, num_inputs] e saida [batch, num_outputs] float ou int8. O scaler_params.h nao e
+//aplicado: a entrada vai como veio (scaler embutido nos pesos ou ja normalizada por quem chama)
+//Retorna o handle ou -1 (registro cheio, ja iniciado ou motor denso)
+//O tflm_init_model falha (-4) se os tensores de algum modelo nao comportam num_inputs/num_outputs
+tflm_model_handle tflm_register_model(const unsigned char* data, int num_inputs, int num_outputs);
+
+//Executa n amostras no modelo h, como o tflm_infer_batch (in: n * num_inputs features,
+//out: n * num_outputs saidas); TFLM_MAIN_MODEL e o proprio tflm_infer_batch
+int tflm_model_infer(tflm_model_handle h, const float* in, float* out, int n);
+
+//Bytes que o modelo h somou na arena no tflm_init_model (0 se o handle nao existe): os buffers
+//persistentes dele, mais o quanto as ativacoes dele passaram das dos modelos alocados antes
+unsigned int tflm_model_arena_bytes(tflm_model_handle h);
 
 #ifdef __cplusplus
 }
+
+namespace tflite {
+class MicroProfilerInterface;
+}
+
+//Define o profiler passado pro MicroInterpreter (chamar antes de tflm_init_model)
+//usado pelos benchmarks pra medir o tempo de cada operador
+void tflm_set_profiler(tflite::MicroProfilerInterface* profiler);
 #endif
 
 #endif  //TFLM_WRAPPER_H_
@@ -0,0 +1,64 @@
+#ifndef WINDOW_FEATURES_H
+#define WINDOW_FEATURES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Extrator de features em janela deslizante para o modelo de janelas (motor_window_model.h)
+// Guarda as últimas WINDOW_SIZE amostras de cada eixo num ring buffer e mantém, a cada nova
+// amostra, RMS, pico a pico, variância e taxa de cruzamento da média em O(1)
+// A mesma conta está em tools/window_features.py, usado pelo notebook para treinar o modelo
+
+#define WINDOW_SIZE 32          // amostras por janela
+#define WINDOW_AXES 6           // Accel X/Y/Z, Gyro X/Y/Z (mesma ordem do in_features)
+#define WINDOW_STATS 4          // por eixo: RMS, pico a pico, variância, taxa de cruzamento
+#define WINDOW_NUM_FEATURES (WINDOW_AXES * WINDOW_STATS)
+
+// As amostras são guardadas como inteiros em milésimos da unidade (mesma resolução dos CSVs),
+// então as somas deslizantes são exatas e não acumulam erro de arredondamento
+#define WINDOW_FIXED_SCALE 1000
+
+typedef struct {
+    int32_t values[WINDOW_SIZE];   // amostras em milésimos, indexadas pela posição do ring
+    int64_t sum;                   // soma das amostras da janela
+    int64_t sum_sq;                // soma dos quadrados
+    uint8_t max_q[WINDOW_SIZE];    // deque monotônico (posições) com o máximo na frente
+    uint8_t min_q[WINDOW_SIZE];    // deque monotônico (posições) com o mínimo na frente
+    uint8_t max_head, max_len;
+    uint8_t min_head, min_len;
+    uint8_t crossed[WINDOW_SIZE];  // 1 se a amostra cruzou a média em relação à anterior
+    uint8_t crossings;             // soma de crossed[]
+    bool above;                    // lado da média da última amostra
+} window_axis_t;
+
+typedef struct {
+    window_axis_t axis[WINDOW_AXES];
+    uint8_t head;   // próxima posição a ser escrita (a mais antiga quando a janela está cheia)
+    uint8_t count;  // amostras na janela (satura em WINDOW_SIZE)
+} window_features_t;
+
+// Zera a janela
+void window_features_init(window_features_t *w);
+
+// Adiciona uma amostra [Accel_X, Accel_Y, Accel_Z, Gyro_X, Gyro_Y, Gyro_Z] e descarta a mais antiga
+void window_features_push(window_features_t *w, const float sample[WINDOW_AXES]);
+
+// O mesmo com a amostra já em milésimos (mm/s² e m°/s do mpu6050_frame_to_fixed), sem ponto flutuante
+void window_features_push_fixed(window_features_t *w, const int32_t sample[WINDOW_AXES]);
+
+// true quando a janela já tem WINDOW_SIZE amostras
+bool window_features_ready(const window_features_t *w);
+
+// Features da janela atual, agrupadas por eixo: out[eixo * WINDOW_STATS + {0: RMS, 1: pico a pico,
+// 2: variância, 3: taxa de cruzamento da média}]
+void window_features_compute(const window_features_t *w, float out[WINDOW_NUM_FEATURES]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WINDOW_FEATURES_H
@@ -0,0 +1,71 @@
+#include "change_detector.h"
+#include <string.h>
+
+// Variância mínima de cada canal (piso de ruído ao quadrado)
+static const float noise_floor[CHANGE_DETECT_CHANNELS] = {
+    CHANGE_DETECT_ACCEL_FLOOR * CHANGE_DETECT_ACCEL_FLOOR,
+    CHANGE_DETECT_ACCEL_FLOOR * CHANGE_DETECT_ACCEL_FLOOR,
+    CHANGE_DETECT_ACCEL_FLOOR * CHANGE_DETECT_ACCEL_FLOOR,
+    CHANGE_DETECT_GYRO_FLOOR * CHANGE_DETECT_GYRO_FLOOR,
+    CHANGE_DETECT_GYRO_FLOOR * CHANGE_DETECT_GYRO_FLOOR,
+    CHANGE_DETECT_GYRO_FLOOR * CHANGE_DETECT_GYRO_FLOOR,
+};
+
+void change_detector_init(change_detector_t *d) {
+    memset(d, 0, sizeof(*d));
+}
+
+static void set_reference(change_detector_t *d) {
+    memcpy(d->ref_mean, d->mean, sizeof(d->ref_mean));
+    memcpy(d->ref_var, d->var, sizeof(d->ref_var));
+    d->since_ref = 0;
+    d->drifted = false;
+}
+
+// true se as estatísticas atuais se afastaram da referência em algum canal
+static bool drifted(const change_detector_t *d) {
+    for (int c = 0; c < CHANGE_DETECT_CHANNELS; c++) {
+        float ref = d->ref_var[c] + noise_floor[c];
+        float cur = d->var[c] + noise_floor[c];
+        float dm = d->mean[c] - d->ref_mean[c];
+        // Comparações sem raiz nem divisão: dm² contra limiar² * variância da referência
+        if (dm * dm > CHANGE_DETECT_MEAN_THRESHOLD * CHANGE_DETECT_MEAN_THRESHOLD * ref) return true;
+        if (cur > (1.0f + CHANGE_DETECT_VAR_THRESHOLD) * ref) return true;
+        if (ref > (1.0f + CHANGE_DETECT_VAR_THRESHOLD) * cur) return true;
+    }
+    return false;
+}
+
+void change_detector_push(change_detector_t *d, const float sample[CHANGE_DETECT_CHANNELS]) {
+    // Nas primeiras amostras o peso é 1/n (média comum), depois fica em alpha
+    d->samples++;
+    float alpha = CHANGE_DETECT_ALPHA;
+    if ((float)d->samples * CHANGE_DETECT_ALPHA < 1.0f) alpha = 1.0f / (float)d->samples;
+
+    for (int c = 0; c < CHANGE_DETECT_CHANNELS; c++) {
+        float delta = sample[c] - d->mean[c];
+        d->mean[c] += alpha * delta;
+        d->var[c] = (1.0f - alpha) * (d->var[c] + alpha * delta * delta);
+    }
+
+    if (!d->armed) return;
+    d->since_ref++;
+    if (!d->drifted && drifted(d)) d->drifted = true;
+}
+
+change_t change_detector_check(change_detector_t *d) {
+    change_t change = CHANGE_NONE;
+    if (!d->armed) {
+        // Médias ainda aquecendo: a primeira referência sai quando cobrem ~1/alpha amostras
+        if ((float)d->samples * CHANGE_DETECT_ALPHA < 1.0f) return CHANGE_NONE;
+        d->armed = true;
+        change = CHANGE_REFRESH;
+    } else if (d->drifted) {
+        change = CHANGE_DRIFT;
+    } else if (d->since_ref >= CHANGE_DETECT_MAX_SKIP) {
+        change = CHANGE_REFRESH;
+    }
+
+    if (change != CHANGE_NONE) set_reference(d);
+    return change;
+}
@@ -0,0 +1,152 @@
+//implementacao da api do tflm_wrapper.h usando o motor denso (sem MicroInterpreter)
+//os pesos vem de motor_model_dense.h, gerado no build a partir de motor_model.h
+//(ou de motor_window_model.h com MOTOR_WINDOW_FEATURES, motor_channel_model.h com MOTOR_CHANNEL_MODEL)
+//por tools/dense_export.py (float ou int8, dependendo de MOTOR_MODEL_INT8)
+#include "pico/stdlib.h"
+
+#include "dense_engine.h"
+#include "motor_model_dense.h"
+#include "tflm_wrapper.h" //header da api
+#ifndef MOTOR_WINDOW_FEATURES
+#include "mpu6050.h" //escalas em ponto fixo do tflm_infer_frame
+#ifndef MOTOR_SENSOR_CHANNELS
+#define MOTOR_SENSOR_CHANNELS MPU6050_CH_ALL
+#endif
+#if defined(MOTOR_DENSE_INT8) && MOTOR_SENSOR_CHANNELS != MPU6050_CH_ALL
+#error "o modelo int8 do motor denso usa os 6 canais do MPU6050"
+#endif
+#endif
+
+#if !defined(MOTOR_DENSE_INT8) && !defined(MOTOR_MODEL_SCALER_FOLDED)
+#ifdef MOTOR_WINDOW_FEATURES
+#error "motor_window_model.h precisa ser exportado com o scaler embutido (MOTOR_MODEL_SCALER_FOLDED)"
+#endif
+#ifdef MOTOR_CHANNEL_MODEL
+#error "motor_channel_model.h precisa ser exportado com o scaler embutido (MOTOR_MODEL_SCALER_FOLDED)"
+#endif
+#include "scaler_params.h"
+static_assert(sizeof(scaler_mean) / sizeof(scaler_mean[0]) == TFLM_NUM_FEATURES,
+              "scaler_params.h tem outro numero de features (TFLM_NUM_FEATURES)");
+#endif
+
+static_assert(motor_dense::kInputs == TFLM_NUM_FEATURES, "modelo com numero de features diferente do tflm_infer");
+static_assert(motor_dense::kOutputs == 4, "tflm_infer espera 4 classes");
+
+static bool initialized = false;
+
+int tflm_init_model(void) {
+    //nao tem arena nem interpretador, os pesos ja estao prontos na flash
+    initialized = true;
+    return 0;
+}
+
+unsigned int tflm_arena_used_bytes(void) {
+    //so as ativacoes intermediarias, que ficam na pilha durante o forward
+    return initialized ? motor_dense::kActivationBytes : 0;
+}
+
+//uma amostra pelo forward do motor denso (sem checagem, quem chama ja validou)
+static inline void infer_one(const float in_features[TFLM_NUM_FEATURES], float out_scores[4]) {
+#ifdef MOTOR_DENSE_INT8
+    //modelo int8: a normalizacao ja esta embutida na quantizacao da entrada
+    motor_dense::forward_raw(in_features, out_scores);
+#elif defined(MOTOR_MODEL_SCALER_FOLDED)
+    //scaler embutido na primeira camada: features brutas direto no forward
+    motor_dense::forward(in_features, out_scores);
+#else
+    float normalized[TFLM_NUM_FEATURES];
+
+    //mesma normalizacao (standard scaler) do tflm_wrapper.cpp
+    for (int i = 0; i < TFLM_NUM_FEATURES; i++) {
+        normalized[i] = (in_features[i] - scaler_mean[i]) / scaler_scale[i];
+    }
+
+    motor_dense::forward(normalized, out_scores);
+#endif
+}
+
+int tflm_infer(const float in_features[TFLM_NUM_FEATURES], float out_scores[4]) {
+    if (!initialized) return -1; //seguranca
+
+    infer_one(in_features, out_scores);
+    return 0;
+}
+
+#ifndef MOTOR_WINDOW_FEATURES
+//contagem do MPU6050 -> unidade das features (m/s² e °/s), pelas mesmas escalas do mpu6050_frame_to_fixed
+constexpr float kAccelPerLsb = (float)MPU6050_ACCEL_MMS2_MULT / (1000.0f * (1 << MPU6050_ACCEL_MMS2_SHIFT));
+constexpr float kGyroPerLsb = (float)MPU6050_GYRO_MDPS_MULT / (1000.0f * (1 << MPU6050_GYRO_MDPS_SHIFT));
+
+#ifdef MOTOR_DENSE_INT8
+//quantizacao da entrada direto das contagens: input_mult ja multiplicado pela escala do sensor e
+//o +0.5 do arredondamento no offset, tudo em Q16 calculado na compilacao (nada de float no infer)
+using motor_dense::input_mult;
+using motor_dense::input_offset;
+constexpr int32_t frame_mult[6] = {
+    dense::to_q16(input_mult[0] * kAccelPerLsb), dense::to_q16(input_mult[1] * kAccelPerLsb),
+    dense::to_q16(input_mult[2] * kAccelPerLsb), dense::to_q16(input_mult[3] * kGyroPerLsb),
+    dense::to_q16(input_mult[4] * kGyroPerLsb), dense::to_q16(input_mult[5] * kGyroPerLsb)};
+constexpr int32_t frame_offset[6] = {
+    dense::to_q16(input_offset[0] + 0.5f), dense::to_q16(input_offset[1] + 0.5f),
+    dense::to_q16(input_offset[2] + 0.5f), dense::to_q16(input_offset[3] + 0.5f),
+    dense::to_q16(input_offset[4] + 0.5f), dense::to_q16(input_offset[5] + 0.5f)};
+
+//contagem * mult + offset tem que caber em 32 bits para qualquer contagem de 16 bits
+constexpr bool fits_int32(int i) {
+    return i == 6 || ((int64_t)32768 * (frame_mult[i] < 0 ? -frame_mult[i] : frame_mult[i]) +
+                          (frame_offset[i] < 0 ? -frame_offset[i] : frame_offset[i]) < ((int64_t)1 << 31) &&
+                      fits_int32(i + 1));
+}
+static_assert(fits_int32(0), "escala da entrada int8 grande demais para o caminho inteiro do tflm_infer_frame");
+#endif
+
+int tflm_infer_frame(const int16_t accel[3], const int16_t gyro[3], float out_scores[4]) {
+    if (!initialized) return -1; //seguranca
+
+#ifdef MOTOR_DENSE_INT8
+    const int16_t raw[6] = {accel[0], accel[1], accel[2], gyro[0], gyro[1], gyro[2]};
+    int8_t x[6];
+    dense::quantize_input_fixed<6>(frame_mult, frame_offset, raw, x);
+    motor_dense::forward_q(x, out_scores);
+#else
+    //modelo float: as contagens dos canais do modelo viram unidades fisicas e seguem o caminho do tflm_infer
+    int16_t raw[TFLM_NUM_FEATURES];
+    mpu6050_gather_channels(MOTOR_SENSOR_CHANNELS, accel, gyro, raw);
+    float in_features[TFLM_NUM_FEATURES];
+    for (int i = 0; i < TFLM_NUM_FEATURES; i++) {
+        in_features[i] = raw[i] * (mpu6050_channel_index(MOTOR_SENSOR_CHANNELS, i) < 3 ? kAccelPerLsb : kGyroPerLsb);
+    }
+    infer_one(in_features, out_scores);
+#endif
+    return 0;
+}
+#endif
+
+int tflm_infer_batch(const float* in, float* out, int n) {
+    if (!initialized) return -1; //seguranca
+    if (n < 0 || (n > 0 && (!in || !out))) return -3;
+
+    //sem interpretador pra reentrar: o laco fica aqui e o forward e inlinado
+    for (int i = 0; i < n; i++) {
+        infer_one(in + i * TFLM_NUM_FEATURES, out + i * 4);
+    }
+    return 0;
+}
+
+tflm_model_handle tflm_register_model(const unsigned char* data, int num_inputs, int num_outputs) {
+    //os pesos do motor denso sao compilados junto (motor_model_dense.h): um flatbuffer registrado
+    //em tempo de execucao precisaria do MicroInterpreter
+    (void)data;
+    (void)num_inputs;
+    (void)num_outputs;
+    return -1;
+}
+
+unsigned int tflm_model_arena_bytes(tflm_model_handle h) {
+    return h == TFLM_MAIN_MODEL ? tflm_arena_used_bytes() : 0;
+}
+
+int tflm_model_infer(tflm_model_handle h, const float* in, float* out, int n) {
+    if (h != TFLM_MAIN_MODEL) return -1;
+    return tflm_infer_batch(in, out, n);
+}
@@ -0,0 +1,85 @@
+#include "fft_q15.h"
+
+// sin(2 * pi * k / FFT_Q15_MAX_SIZE) em Q15 para k = 0..FFT_Q15_MAX_SIZE / 4
+// Gerada por: python3 tools/spectral_features.py --twiddle
+static const int16_t quarter_sine[FFT_Q15_MAX_SIZE / 4 + 1] = {
+    0, 804, 1608, 2411, 3212, 4011, 4808, 5602, 6393, 7180, 7962, 8740, 9512,
+    10279, 11039, 11793, 12540, 13279, 14010, 14733, 15447, 16151, 16846, 17531, 18205, 18868,
+    19520, 20160, 20788, 21403, 22006, 22595, 23170, 23732, 24279, 24812, 25330, 25833, 26320,
+    26791, 27246, 27684, 28106, 28511, 28899, 29269, 29622, 29957, 30274, 30572, 30853, 31114,
+    31357, 31581, 31786, 31972, 32138, 32286, 32413, 32522, 32610, 32679, 32729, 32758, 32767
+};
+
+// cos/sin de 2 * pi * m / FFT_Q15_MAX_SIZE para m em [0, FFT_Q15_MAX_SIZE / 2] (meia volta basta)
+static inline void twiddle(int m, int32_t *c, int32_t *s) {
+    const int quarter = FFT_Q15_MAX_SIZE / 4;
+    if (m <= quarter) {
+        *c = quarter_sine[quarter - m];
+        *s = quarter_sine[m];
+    } else {
+        *c = -quarter_sine[m - quarter];
+        *s = quarter_sine[2 * quarter - m];
+    }
+}
+
+static inline int16_t saturate_q15(int32_t v) {
+    return (int16_t)(v < -32768 ? -32768 : (v > 32767 ? 32767 : v));
+}
+
+void fft_q15_complex(int16_t *data, int n) {
+    // Permutação bit-reversa
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) {
+            int16_t tr = data[2 * i], ti = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = tr;
+            data[2 * j + 1] = ti;
+        }
+    }
+
+    // Borboletas DIT: t = w * x[b], x[a] = (x[a] + t) / 2, x[b] = (x[a] - t) / 2
+    for (int len = 2; len <= n; len <<= 1) {
+        const int half = len >> 1;
+        const int step = FFT_Q15_MAX_SIZE / len;
+        for (int j = 0; j < half; j++) {
+            int32_t c, s;
+            twiddle(j * step, &c, &s);  // w = cos - i sin
+            for (int i = j; i < n; i += len) {
+                int16_t *a = data + 2 * i;
+                int16_t *b = data + 2 * (i + half);
+                int32_t tr = ((int32_t)c * b[0] + (int32_t)s * b[1] + (1 << 14)) >> 15;
+                int32_t ti = ((int32_t)c * b[1] - (int32_t)s * b[0] + (1 << 14)) >> 15;
+                int32_t ar = a[0], ai = a[1];
+                a[0] = saturate_q15((ar + tr) >> 1);
+                a[1] = saturate_q15((ai + ti) >> 1);
+                b[0] = saturate_q15((ar - tr) >> 1);
+                b[1] = saturate_q15((ai - ti) >> 1);
+            }
+        }
+    }
+}
+
+void fft_q15_real(int16_t *data, int n, int32_t *bins) {
+    // As amostras pares/ímpares viram a parte real/imaginária de um sinal complexo de n/2 pontos
+    const int half = n >> 1;
+    fft_q15_complex(data, half);
+
+    // Separa os espectros par (Fe) e ímpar (Fo) e junta: X[k] = Fe[k] + W^k * Fo[k]
+    const int step = FFT_Q15_MAX_SIZE / n;
+    for (int k = 0; k <= half; k++) {
+        const int16_t *zk = data + 2 * (k % half);
+        const int16_t *zm = data + 2 * ((half - k) % half);
+        int32_t fe_r = ((int32_t)zk[0] + zm[0]) >> 1;
+        int32_t fe_i = ((int32_t)zk[1] - zm[1]) >> 1;
+        int32_t fo_r = ((int32_t)zk[1] + zm[1]) >> 1;
+        int32_t fo_i = ((int32_t)zm[0] - zk[0]) >> 1;
+        int32_t c, s;
+        twiddle(k * step, &c, &s);
+        bins[2 * k] = fe_r + ((c * fo_r + s * fo_i + (1 << 14)) >> 15);
+        bins[2 * k + 1] = fe_i + ((c * fo_i - s * fo_r + (1 << 14)) >> 15);
+    }
+}
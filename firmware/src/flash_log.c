@@ -0,0 +1,226 @@
+#include "flash_log.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+
+typedef struct {
+    flash_log_header_t header;
+    flash_log_record_t records[FLASH_LOG_RECORDS_PER_SECTOR];
+} log_sector_t;
+
+_Static_assert(sizeof(flash_log_record_t) == 16, "flash_log_record_t precisa ter 16 bytes");
+_Static_assert(sizeof(log_sector_t) == FLASH_LOG_SECTOR_BYTES, "o setor do log precisa ter 4 KB");
+_Static_assert(FLASH_LOG_SECTOR_BYTES == FLASH_SECTOR_SIZE, "setor do log diferente do setor da flash");
+_Static_assert(FLASH_LOG_SIZE % FLASH_SECTOR_SIZE == 0, "FLASH_LOG_SIZE precisa ser múltiplo do setor");
+
+#define LOG_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_LOG_SIZE)
+#define LOG_SECTORS (FLASH_LOG_SIZE / FLASH_SECTOR_SIZE)
+#define PAGES_PER_SECTOR (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
+
+// Espera máxima para o outro core parar enquanto a flash está ocupada
+#define LOCKOUT_TIMEOUT_MS 100
+
+static bool enabled;
+static uint16_t sample_rate_hz;
+
+// Buffers de setor: full[i] diz quem é o dono (0: append; senão o service, com full[i] registros);
+// a troca usa acquire/release
+static log_sector_t sectors[2];
+static atomic_uint full[2];
+
+// Lado do append (records e dropped só são escritos por ele; sem read-modify-write atômico no M0+)
+static unsigned fill_buffer;
+static unsigned fill_count;
+static atomic_uint records, dropped;
+
+static void count(atomic_uint *counter) {
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+// Previsão e rótulo dos próximos registros, num só valor atômico (nível | confiança << 8 | rótulo << 16)
+static atomic_uint stamp;
+
+// Lado do service: setor da região em gravação e a etapa (0: apagar, 1..15: páginas 1..15,
+// 16: página 0, com o cabeçalho); um setor parcial pula as páginas sem registros
+static unsigned flush_buffer;
+static unsigned flush_step;
+static uint32_t write_sector;
+static uint32_t next_seq;
+static uint32_t sectors_written, errors;
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+// Fim do programa na flash (símbolo do linker do Pico SDK)
+extern char __flash_binary_end;
+#endif
+
+static const flash_log_header_t *stored_header(uint32_t sector) {
+    return (const flash_log_header_t *)(XIP_BASE + LOG_OFFSET + sector * FLASH_SECTOR_SIZE);
+}
+
+static bool header_valid(const flash_log_header_t *h) {
+    return h->magic == FLASH_LOG_MAGIC && h->seq_inv == ~h->seq &&
+           h->count <= FLASH_LOG_RECORDS_PER_SECTOR;
+}
+
+static unsigned pack_stamp(int level, unsigned confidence, int label) {
+    return (uint8_t)(int8_t)level | (confidence & 0xFF) << 8 | (unsigned)(uint8_t)(int8_t)label << 16;
+}
+
+bool flash_log_init(uint16_t rate_hz) {
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+    if ((uintptr_t)&__flash_binary_end - XIP_BASE > LOG_OFFSET) {
+        printf("Flash log: o programa invade a regiao do log, log desligado\n");
+        enabled = false;
+        return false;
+    }
+#endif
+    sample_rate_hz = rate_hz;
+
+    // Continua depois do setor de maior sequência (setores sem cabeçalho válido são ignorados)
+    bool found = false;
+    uint32_t newest = 0, newest_seq = 0;
+    for (uint32_t s = 0; s < LOG_SECTORS; s++) {
+        const flash_log_header_t *h = stored_header(s);
+        if (!header_valid(h)) continue;
+        if (!found || (int32_t)(h->seq - newest_seq) > 0) {
+            newest = s;
+            newest_seq = h->seq;
+            found = true;
+        }
+    }
+    write_sector = found ? (newest + 1) % LOG_SECTORS : 0;
+    next_seq = found ? newest_seq + 1 : 0;
+
+    atomic_init(&full[0], 0);
+    atomic_init(&full[1], 0);
+    atomic_init(&records, 0);
+    atomic_init(&dropped, 0);
+    atomic_init(&stamp, pack_stamp(-1, 0, -1));
+    fill_buffer = fill_count = 0;
+    flush_buffer = flush_step = 0;
+    sectors_written = errors = 0;
+    enabled = true;
+    return true;
+}
+
+// Entrega ao service o buffer em montagem com fill_count registros
+static void hand_over(void) {
+    // release: o service só vê o buffer depois dos registros
+    atomic_store_explicit(&full[fill_buffer], fill_count, memory_order_release);
+    fill_buffer ^= 1;
+    fill_count = 0;
+}
+
+void flash_log_set_label(int label) {
+    unsigned s = atomic_load_explicit(&stamp, memory_order_relaxed);
+    // Um setor não mistura rótulos: o que já entrou com o rótulo anterior vai para a flash
+    if ((int8_t)(s >> 16) != (int8_t)label) flash_log_flush();
+    atomic_store_explicit(&stamp, (s & 0xFFFF) | pack_stamp(0, 0, label), memory_order_relaxed);
+}
+
+void flash_log_set_prediction(int level, float confidence) {
+    unsigned conf = confidence <= 0.0f ? 0 : confidence >= 1.0f ? 255 : (unsigned)(confidence * 255.0f + 0.5f);
+    unsigned s = atomic_load_explicit(&stamp, memory_order_relaxed);
+    atomic_store_explicit(&stamp, (s & 0xFF0000) | (pack_stamp(level, conf, 0) & 0xFFFF), memory_order_relaxed);
+}
+
+bool flash_log_append(const mpu6050_frame_t *frame) {
+    if (!enabled) return false;
+    // O service ainda não terminou o buffer que seria o próximo: a amostra se perde
+    if (atomic_load_explicit(&full[fill_buffer], memory_order_acquire)) {
+        count(&dropped);
+        return false;
+    }
+
+    unsigned s = atomic_load_explicit(&stamp, memory_order_relaxed);
+    flash_log_record_t *r = &sectors[fill_buffer].records[fill_count];
+    memcpy(r->accel, frame->accel, sizeof(r->accel));
+    memcpy(r->gyro, frame->gyro, sizeof(r->gyro));
+    r->predicted = (int8_t)(s & 0xFF);
+    r->confidence = (uint8_t)(s >> 8);
+    r->label = (int8_t)(s >> 16);
+    r->reserved = 0xFF;
+    count(&records);
+
+    if (++fill_count == FLASH_LOG_RECORDS_PER_SECTOR) hand_over();
+    return true;
+}
+
+bool flash_log_flush(void) {
+    if (!enabled || fill_count == 0) return false;
+    hand_over();
+    return true;
+}
+
+typedef struct {
+    uint32_t offset;
+    const uint8_t *data;  // NULL: apagar o setor
+} flash_op_t;
+
+// Roda com as interrupções desligadas e o outro core parado (flash_safe_execute)
+static void run_flash_op(void *param) {
+    const flash_op_t *op = (const flash_op_t *)param;
+    if (op->data) {
+        flash_range_program(op->offset, op->data, FLASH_PAGE_SIZE);
+    } else {
+        flash_range_erase(op->offset, FLASH_SECTOR_SIZE);
+    }
+}
+
+bool flash_log_service(void) {
+    unsigned queued = enabled ? atomic_load_explicit(&full[flush_buffer], memory_order_acquire) : 0;
+    if (queued == 0) return false;
+
+    // Páginas 1.. sem nenhum registro ficam apagadas (0xFF): o cabeçalho diz quantos valem
+    unsigned used_pages = (sizeof(flash_log_header_t) + queued * sizeof(flash_log_record_t) + FLASH_PAGE_SIZE - 1) /
+                          FLASH_PAGE_SIZE;
+    if (flush_step >= used_pages && flush_step < PAGES_PER_SECTOR) flush_step = PAGES_PER_SECTOR;
+
+    log_sector_t *sector = &sectors[flush_buffer];
+    uint32_t offset = LOG_OFFSET + write_sector * FLASH_SECTOR_SIZE;
+    flash_op_t op = {offset, NULL};
+    if (flush_step == 0) {
+        // Apaga o setor inteiro (o antigo conteúdo da volta anterior some aqui)
+    } else if (flush_step < PAGES_PER_SECTOR) {
+        op.offset = offset + flush_step * FLASH_PAGE_SIZE;
+        op.data = (const uint8_t *)sector + flush_step * FLASH_PAGE_SIZE;
+    } else {
+        // Cabeçalho por último: até aqui o setor não é válido para o flash_log_init/dump
+        sector->header.magic = FLASH_LOG_MAGIC;
+        sector->header.seq = next_seq;
+        sector->header.seq_inv = ~next_seq;
+        sector->header.count = (uint16_t)queued;
+        sector->header.rate_hz = sample_rate_hz;
+        op.data = (const uint8_t *)sector;
+    }
+
+    if (flash_safe_execute(run_flash_op, &op, LOCKOUT_TIMEOUT_MS) != PICO_OK) {
+        errors++;
+        return true;
+    }
+
+    if (++flush_step > PAGES_PER_SECTOR) {
+        flush_step = 0;
+        write_sector = (write_sector + 1) % LOG_SECTORS;
+        next_seq++;
+        sectors_written++;
+        // release: o append só reaproveita o buffer depois que a gravação terminou
+        atomic_store_explicit(&full[flush_buffer], 0, memory_order_release);
+        flush_buffer ^= 1;
+    }
+    return true;
+}
+
+flash_log_stats_t flash_log_get_stats(void) {
+    flash_log_stats_t s = {
+        .records = atomic_load_explicit(&records, memory_order_relaxed),
+        .dropped = atomic_load_explicit(&dropped, memory_order_relaxed),
+        .sectors = sectors_written,
+        .errors = errors,
+        .seq = next_seq,
+    };
+    return s;
+}
@@ -0,0 +1,137 @@
+#include "i2c_dma.h"
+#include "hardware/dma.h"
+#include "pico/stdlib.h"
+
+typedef struct {
+    int tx_chan, rx_chan;
+    bool claimed;
+    bool active;
+    bool writing; // i2c_dma_write_start: só o canal de TX, termina quando o controlador esvazia
+    size_t len;
+    // Um comando por byte do IC_DATA_CMD: o registrador e len leituras
+    uint32_t cmds[I2C_DMA_MAX_LEN + 1];
+} i2c_dma_port_t;
+
+static i2c_dma_port_t ports[2];
+
+_Static_assert(I2C_DMA_CMD_STOP == I2C_IC_DATA_CMD_STOP_BITS, "bit de STOP do IC_DATA_CMD");
+_Static_assert(I2C_DMA_CMD_RESTART == I2C_IC_DATA_CMD_RESTART_BITS, "bit de RESTART do IC_DATA_CMD");
+
+static i2c_dma_port_t *port_of(i2c_inst_t *i2c) {
+    return &ports[i2c_hw_index(i2c)];
+}
+
+void i2c_dma_init(i2c_inst_t *i2c) {
+    i2c_dma_port_t *p = port_of(i2c);
+    if (p->claimed) return;
+    p->tx_chan = dma_claim_unused_channel(true);
+    p->rx_chan = dma_claim_unused_channel(true);
+    p->claimed = true;
+}
+
+static bool aborted(i2c_inst_t *i2c) {
+    return i2c_get_hw(i2c)->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+}
+
+bool i2c_dma_read_start(i2c_inst_t *i2c, uint8_t addr, uint8_t reg, uint8_t *dst, size_t len) {
+    i2c_dma_port_t *p = port_of(i2c);
+    if (!p->claimed || p->active || len == 0 || len > I2C_DMA_MAX_LEN) return false;
+
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    hw->enable = 0;
+    hw->tar = addr;
+    hw->enable = 1;
+    (void)hw->clr_tx_abrt; // um abort antigo não pode encerrar esta transferência
+
+    // Escrita do registrador, RESTART na primeira leitura e STOP na última
+    p->cmds[0] = reg;
+    for (size_t i = 1; i <= len; i++) {
+        p->cmds[i] = I2C_IC_DATA_CMD_CMD_BITS;
+    }
+    p->cmds[1] |= I2C_IC_DATA_CMD_RESTART_BITS;
+    p->cmds[len] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    // RX primeiro, para já estar armado quando o primeiro byte chegar
+    dma_channel_config c = dma_channel_get_default_config(p->rx_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, i2c_get_dreq(i2c, false));
+    dma_channel_configure(p->rx_chan, &c, dst, &hw->data_cmd, len, true);
+
+    c = dma_channel_get_default_config(p->tx_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(i2c, true));
+    dma_channel_configure(p->tx_chan, &c, &hw->data_cmd, p->cmds, len + 1, true);
+
+    p->active = true;
+    p->writing = false;
+    p->len = len;
+    return true;
+}
+
+bool i2c_dma_write_start(i2c_inst_t *i2c, uint8_t addr, const uint16_t *cmds, size_t count) {
+    i2c_dma_port_t *p = port_of(i2c);
+    if (!p->claimed || p->active || count == 0) return false;
+
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    hw->enable = 0;
+    hw->tar = addr;
+    hw->enable = 1;
+    (void)hw->clr_tx_abrt;
+
+    // Escrita de 16 bits no IC_DATA_CMD: o barramento replica a meia palavra, e os bits 16-31
+    // do registrador são reservados
+    dma_channel_config c = dma_channel_get_default_config(p->tx_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(i2c, true));
+    dma_channel_configure(p->tx_chan, &c, &hw->data_cmd, cmds, count, true);
+
+    p->active = true;
+    p->writing = true;
+    p->len = count;
+    return true;
+}
+
+bool i2c_dma_busy(i2c_inst_t *i2c) {
+    i2c_dma_port_t *p = port_of(i2c);
+    // Sem ACK o controlador aborta e o canal de RX nunca termina
+    if (!p->active || aborted(i2c)) return false;
+    if (!p->writing) return dma_channel_is_busy(p->rx_chan);
+
+    // Escrita: o DMA termina quando a última palavra entra no FIFO de TX, mas o barramento só
+    // fica livre quando o FIFO esvazia e o controlador sai de atividade (depois do STOP)
+    uint32_t status = i2c_get_hw(i2c)->status;
+    return dma_channel_is_busy(p->tx_chan) || !(status & I2C_IC_STATUS_TFE_BITS) ||
+           (status & I2C_IC_STATUS_MST_ACTIVITY_BITS);
+}
+
+// Espera a transferência (leitura ou escrita) e trata um abort
+static int finish(i2c_inst_t *i2c) {
+    i2c_dma_port_t *p = port_of(i2c);
+    if (!p->active) return PICO_ERROR_GENERIC;
+    while (i2c_dma_busy(i2c)) {
+        tight_loop_contents();
+    }
+    p->active = false;
+
+    if (aborted(i2c)) {
+        dma_channel_abort(p->tx_chan);
+        dma_channel_abort(p->rx_chan);
+        (void)i2c_get_hw(i2c)->clr_tx_abrt;
+        return PICO_ERROR_GENERIC;
+    }
+    return (int)p->len;
+}
+
+int i2c_dma_read_finish(i2c_inst_t *i2c) {
+    return finish(i2c);
+}
+
+int i2c_dma_write_finish(i2c_inst_t *i2c) {
+    return finish(i2c);
+}
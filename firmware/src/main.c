@@ -6,6 +6,24 @@
 #include "ssd1306.h"
 #include "tflm_wrapper.h"
 #include "scaler_params.h"
+#include "scheduler.h"
+#include "spsc_queue.h"
+#include "telemetry.h"
+#include "prediction_filter.h"
+#include "change_detector.h"
+#ifdef MOTOR_DUAL_CORE
+#include "pico/multicore.h"
+#endif
+#ifdef MOTOR_FLASH_LOG
+#include "flash_log.h"
+#include "pico/flash.h"
+#endif
+#ifdef MOTOR_SENSOR_IRQ
+#include "power.h"
+#endif
+#ifdef MOTOR_SENSOR_FILTER
+#include "sample_filter.h"
+#endif
 
 // --- HARDWARE SETTINGS ---
 
@@ -20,29 +38,286 @@
 #define I2C_DISPLAY_SCL 15
 #define OLED_ADDR 0x3C
 
-// Update configuration
-#define UPDATE_TIME_MS 1000 // Update screen every 1s
+#ifdef MOTOR_SENSOR_IRQ
+// MPU6050 INT pin: one data-ready pulse per sample; the cores sleep until it fires
+#define SENSOR_INT_GPIO 2
+#endif
+
+// Motors monitored by this node, one MPU6050 each (MOTOR_SENSOR_COUNT CMake option, 1..4)
+#ifndef MOTOR_SENSOR_COUNT
+#define MOTOR_SENSOR_COUNT 1
+#endif
+// Sensor of each motor: AD0 low/high on the sensor bus, then on the display bus
+#define SENSOR_SLOTS {{I2C_SENSOR_PORT, MPU6050_ADDR}, {I2C_SENSOR_PORT, MPU6050_ADDR_ALT}, \
+                      {I2C_DISPLAY_PORT, MPU6050_ADDR}, {I2C_DISPLAY_PORT, MPU6050_ADDR_ALT}}
+#if MOTOR_SENSOR_COUNT < 1 || MOTOR_SENSOR_COUNT > 4
+#error "MOTOR_SENSOR_COUNT must be 1..4 (two addresses on each of the two I2C buses)"
+#endif
+
+#ifdef MOTOR_WINDOW_FEATURES
+// Window model: sample period of the sliding window (must match the rate data/nivel*.csv was captured at)
+#define WINDOW_SAMPLE_MS 10
+// The MPU6050 samples into its FIFO on its own; drain it every WINDOW_POLL_MS in DMA bursts of
+// up to FIFO_BURST_FRAMES frames (the 1024-byte FIFO holds 85 frames, 850 ms at 100 Hz)
+#define WINDOW_POLL_MS 100
+#define FIFO_BURST_FRAMES 16
+#endif
+
+#ifdef MOTOR_DUAL_CORE
+// Completed windows in flight from core 1 to core 0 (power of 2)
+#define WINDOW_QUEUE_DEPTH 4
+#endif
+
+#ifdef MOTOR_SENSOR_FILTER
+// Oversampling: the sensor runs SAMPLE_FILTER_DECIMATION times faster than the model and the
+// fixed-point anti-alias/decimation filter (sample_filter.c) hands one sample per model period on.
+// The sensor DLPF only has to stop aliasing at the oversampled rate. With the window model the
+// FIFO fills that much faster too (85 frames in 170 ms at 500 Hz), still more than one WINDOW_POLL_MS
+#define SENSOR_OVERSAMPLE SAMPLE_FILTER_DECIMATION
+#define SENSOR_DLPF       MPU6050_DLPF_184HZ
+#else
+#define SENSOR_OVERSAMPLE 1
+#endif
+
+// Task periods of the cooperative scheduler (scheduler.h): sensing, inference, display and
+// telemetry run at independent rates instead of one fixed sleep
+#ifdef MOTOR_WINDOW_FEATURES
+#define SENSOR_PERIOD_MS   WINDOW_POLL_MS // drain the FIFO (the sensor samples on its own clock)
+#define SENSOR_DEADLINE_MS WINDOW_POLL_MS
+#define SENSOR_READ_US     (SENSOR_PERIOD_MS * 1000)
+#define SENSOR_DEADLINE_US (SENSOR_DEADLINE_MS * 1000)
+#define MODEL_SAMPLE_MS    WINDOW_SAMPLE_MS
+#else
+#define SENSOR_PERIOD_MS   10 // one model sample per period, the 100 Hz of data/nivel*.csv
+#define SENSOR_DEADLINE_MS 2  // sampling jitter budget
+// One register read per period, or SENSOR_OVERSAMPLE of them with the decimation filter
+#define SENSOR_READ_US     (SENSOR_PERIOD_MS * 1000 / SENSOR_OVERSAMPLE)
+#define SENSOR_DEADLINE_US (SENSOR_DEADLINE_MS * 1000 < SENSOR_READ_US ? SENSOR_DEADLINE_MS * 1000 : SENSOR_READ_US)
+#define MODEL_SAMPLE_MS    SENSOR_PERIOD_MS
+// Samples read since the last inference run (power of 2, >= INFER_PERIOD_MS / SENSOR_PERIOD_MS)
+#define SAMPLE_QUEUE_DEPTH 8
+#endif
+#if defined(MOTOR_SENSOR_FILTER) && SAMPLE_FILTER_OUTPUT_HZ * MODEL_SAMPLE_MS != 1000
+#error "sample_filter_coeffs.h decimates to another rate than the model sample period"
+#endif
+#ifdef MOTOR_SENSOR_IRQ
+// Sensing is driven by the INT pulses (every sample, or every poll's worth of FIFO frames); the
+// period is only the fallback if pulses stop (INT not wired)
+#ifdef MOTOR_WINDOW_FEATURES
+#define SENSOR_FRAMES_PER_WAKE (WINDOW_POLL_MS / WINDOW_SAMPLE_MS * SENSOR_OVERSAMPLE)
+#else
+#define SENSOR_FRAMES_PER_WAKE 1
+#endif
+#define SENSOR_TIMEOUT_MS (2 * SENSOR_READ_US / 1000)
+#endif
+#define INFER_PERIOD_MS     50
+#define DISPLAY_PERIOD_MS   250
+// With several motors the display shows one page per motor, DISPLAY_PAGE_MS each
+#define DISPLAY_PAGE_MS     2000
+#define TELEMETRY_PERIOD_MS 1000
+
+#ifdef MOTOR_FLASH_LOG
+// One flash operation (a sector erase or a page program) per run, so logging never stalls the
+// other tasks for more than one erase; a 4 KB sector takes 17 runs
+#define LOGGER_PERIOD_MS 20
+// Level the motor is known to run at while logging (-1: unlabeled, set by MOTOR_FLASH_LOG_LABEL)
+#ifndef FLASH_LOG_LABEL
+#define FLASH_LOG_LABEL -1
+#endif
+#endif
+
+// Binary telemetry verbosity (telemetry.h, set by the MOTOR_TELEMETRY CMake option);
+// TELEMETRY_OFF keeps the readable printf report
+#ifndef MOTOR_TELEMETRY_LEVEL
+#define MOTOR_TELEMETRY_LEVEL TELEMETRY_OFF
+#endif
 
 // --- GLOBAL VARIABLES ---
 
 static ssd1306_t oled_display;
-static mpu6050_data_t sensor_data;
-static int predicted_level = -1; // -1 indicates no prediction yet
-static float confidence = 0.0f;
+
+// Everything kept per monitored motor: its sensor and the state of its prediction
+typedef struct {
+    mpu6050_t sensor;
+    // Raw scores go through the smoothing/hysteresis stage before the display, telemetry and log see them
+    prediction_filter_t filter;
+    uint32_t inputs_since_infer;
+    int predicted_level; // -1 indicates no prediction yet
+    float confidence;
+#ifdef MOTOR_CHANGE_DETECT
+    // Raw-signal change detector: once the prediction has settled, the model only runs when the
+    // sample statistics drift away from the reference or the reference expires
+    change_detector_t detector;
+#endif
+#ifdef MOTOR_SENSOR_FILTER
+    // Anti-alias + decimation from the sensor rate down to the model rate (integers only)
+    sample_filter_t sample_filter;
+#endif
+#ifndef MOTOR_WINDOW_FEATURES
+    mpu6050_frame_t last_frame; // latest sample, converted to physical units only for the text report
+#endif
+} motor_t;
+
+static motor_t motors[MOTOR_SENSOR_COUNT];
+
+#ifdef MOTOR_SENSOR_IRQ
+// Sleep accounting per core, reported per classification by the telemetry task
+static power_meter_t core0_power;
+static power_window_t core0_window;
+#ifdef MOTOR_DUAL_CORE
+static power_meter_t core1_power;
+static power_window_t core1_window;
+#endif
+static uint32_t classified; // classifications since the last report
+
+// Scheduler idle hook: sleep until the next release (or the sensor, when this core owns it)
+void core0_idle(uint64_t until_us) {
+#ifdef MOTOR_DUAL_CORE
+    power_sleep_until(&core0_power, until_us, false);
+#else
+    power_sleep_until(&core0_power, until_us, true);
+#endif
+}
+#endif
 
 // --- SYSTEM FUNCTIONS ---
 
-// Find the index of the maximum value in a float array
-int argmax(const float* array, int size) {
-    if (size <= 0) return -1;
-    int max_index = 0;
-    for (int i = 1; i < size; ++i) {
-        if (array[i] > array[max_index]) {
-            max_index = i;
+#ifdef MOTOR_CHANGE_DETECT
+// Inferences run (by cause) and stride-due inferences skipped because nothing changed, all motors
+static uint32_t infer_drift, infer_refresh, infer_stride, infer_skipped;
+#endif
+
+// What the change detector of a motor saw since its last check (always CHANGE_NONE without MOTOR_CHANGE_DETECT)
+change_t detect_change(motor_t *m) {
+#ifdef MOTOR_CHANGE_DETECT
+    return change_detector_check(&m->detector);
+#else
+    (void)m;
+    return CHANGE_NONE;
+#endif
+}
+
+// Adaptive duty cycle: true once every prediction_filter_stride samples (or windows); the stride
+// grows while the prediction is stable and drops back to 1 as soon as it is not
+// A detected change classifies right away; a settled prediction over a steady signal skips the model
+// Each motor has its own stride: a steady motor is classified less often than one that is changing
+bool infer_due(motor_t *m, change_t change) {
+#ifdef MOTOR_CHANGE_DETECT
+    if (change != CHANGE_NONE) {
+        if (change == CHANGE_DRIFT) infer_drift++;
+        else infer_refresh++;
+        m->inputs_since_infer = 0;
+        return true;
+    }
+#else
+    (void)change;
+#endif
+    if (++m->inputs_since_infer < prediction_filter_stride(&m->filter)) return false;
+    m->inputs_since_infer = 0;
+#ifdef MOTOR_CHANGE_DETECT
+    if (prediction_filter_settled(&m->filter)) {
+        infer_skipped++;
+        return false;
+    }
+    infer_stride++;
+#endif
+    return true;
+}
+
+// Inferences that returned an error: their scores are not published and the previous prediction stays
+static uint32_t infer_errors;
+
+// Smooth the raw scores of one inference of motor k and publish the result
+void publish_prediction(int k, const float out_scores[4], uint32_t infer_us) {
+    motor_t *m = &motors[k];
+#ifdef MOTOR_SENSOR_IRQ
+    classified++;
+#endif
+
+    m->predicted_level = prediction_filter_update(&m->filter, out_scores);
+    m->confidence = m->filter.confidence;
+    telemetry_send_prediction((uint8_t)k, m->predicted_level, out_scores, 4, infer_us);
+#ifdef MOTOR_FLASH_LOG
+    // Stamped on the next logged samples
+    flash_log_set_prediction(m->predicted_level, m->confidence);
+#endif
+}
+
+#ifdef MOTOR_WINDOW_FEATURES
+// Run the model on the window features and publish the smoothed result
+void classify(const float in_features[TFLM_NUM_FEATURES]) {
+    float out_scores[4];
+    uint32_t start = time_us_32();
+    if (tflm_infer(in_features, out_scores) != 0) {
+        infer_errors++;
+        return;
+    }
+    publish_prediction(0, out_scores, time_us_32() - start);
+}
+#else
+// One model-rate sample of every motor, read back to back by the sensor task
+typedef struct {
+    mpu6050_frame_t frames[MOTOR_SENSOR_COUNT];
+} sensor_tick_t;
+
+#if MOTOR_SENSOR_COUNT == 1
+// Run the model straight on the raw counts: with the int8 engine the input is quantized with
+// integers only, so a sample reaches the model without any float conversion
+void classify(const sensor_tick_t *tick, const int *due, int n) {
+    (void)due;
+    (void)n;
+    float out_scores[4];
+    uint32_t start = time_us_32();
+    if (tflm_infer_frame(tick->frames[0].accel, tick->frames[0].gyro, out_scores) != 0) {
+        infer_errors++;
+        return;
+    }
+    publish_prediction(0, out_scores, time_us_32() - start);
+}
+#else
+// Several motors: the due samples of one tick go through the model together in one
+// tflm_infer_batch call (one Invoke per MOTOR_MODEL_BATCH rows with a batched model) instead of
+// one inference per motor; every motor is reported with the time of the whole batch
+void classify(const sensor_tick_t *tick, const int *due, int n) {
+    float in[MOTOR_SENSOR_COUNT * TFLM_NUM_FEATURES];
+    float out[MOTOR_SENSOR_COUNT * 4];
+    for (int i = 0; i < n; i++) {
+        mpu6050_data_t data;
+        mpu6050_frame_to_data(&tick->frames[due[i]], &data);
+        const float sample[6] = {data.accel_x, data.accel_y, data.accel_z, data.gyro_x, data.gyro_y, data.gyro_z};
+#ifdef MOTOR_CHANNEL_MODEL
+        // Only the channels the reduced model was trained on, in mpu6050_frame_t order
+        for (int f = 0; f < TFLM_NUM_FEATURES; f++) {
+            in[i * TFLM_NUM_FEATURES + f] = sample[mpu6050_channel_index(MOTOR_SENSOR_CHANNELS, f)];
         }
+#else
+        memcpy(&in[i * TFLM_NUM_FEATURES], sample, sizeof(sample));
+#endif
+    }
+    uint32_t start = time_us_32();
+    if (tflm_infer_batch(in, out, n) != 0) {
+        infer_errors += (uint32_t)n;
+        return;
+    }
+    uint32_t infer_us = time_us_32() - start;
+    for (int i = 0; i < n; i++) publish_prediction(due[i], &out[i * 4], infer_us);
+}
+#endif
+#endif
+
+#ifdef MOTOR_SENSOR_FILTER
+// Filter one frame of motor m read at the sensor rate; true once per model period, with the
+// decimated frame in out
+bool decimate_frame(motor_t *m, const mpu6050_frame_t *in, mpu6050_frame_t *out) {
+    int16_t x[SAMPLE_FILTER_CHANNELS] = {in->accel[0], in->accel[1], in->accel[2], in->gyro[0], in->gyro[1], in->gyro[2]};
+    if (!sample_filter_push(&m->sample_filter, x, x)) return false;
+    for (int k = 0; k < 3; k++) {
+        out->accel[k] = x[k];
+        out->gyro[k] = x[3 + k];
     }
-    return max_index;
+    return true;
 }
+#endif
 
 // Initialize I2C buses and devices
 void setup_hardware(void) {
@@ -52,7 +327,6 @@ void setup_hardware(void) {
     gpio_set_function(I2C_SENSOR_SCL, GPIO_FUNC_I2C);
     gpio_pull_up(I2C_SENSOR_SDA);
     gpio_pull_up(I2C_SENSOR_SCL);
-    mpu6050_init(I2C_SENSOR_PORT);
 
     // 2. Configure OLED Display I2C (400kHz)
     i2c_init(I2C_DISPLAY_PORT, 400 * 1000);
@@ -60,34 +334,400 @@ void setup_hardware(void) {
     gpio_set_function(I2C_DISPLAY_SCL, GPIO_FUNC_I2C);
     gpio_pull_up(I2C_DISPLAY_SDA);
     gpio_pull_up(I2C_DISPLAY_SCL);
+
     ssd1306_init(&oled_display, 128, 64, false, OLED_ADDR, I2C_DISPLAY_PORT);
     ssd1306_config(&oled_display);
+    // Frames go out by DMA in the background (synchronous on the host build)
+    ssd1306_enable_dma(&oled_display);
+
+    // 3. One MPU6050 per motor (motors 2 and 3 sit on the display bus)
+    static const struct {
+        i2c_inst_t *port;
+        uint8_t addr;
+    } slots[] = SENSOR_SLOTS;
+    for (int k = 0; k < MOTOR_SENSOR_COUNT; k++) mpu6050_init(&motors[k].sensor, slots[k].port, slots[k].addr);
+}
+
+// Redraw one text line of the display if its text changed: clear the band [top, top + height)
+// and draw the new text. The driver only sends the pixels that actually changed
+static void update_line(char *shown, const char *text, uint8_t x, uint8_t y, uint8_t top, uint8_t height) {
+    if (strcmp(shown, text) == 0) return;
+    ssd1306_rect(&oled_display, top, 0, 128, height, false, true);
+    ssd1306_draw_string(&oled_display, text, x, y, false);
+    strcpy(shown, text);
 }
 
 // Function to display data on the OLED screen
 void update_display(void) {
-    char line[32];
+    // Static layout is drawn once; the text lines remember what is on screen
+    static bool layout_drawn = false;
+    static char shown_title[16], shown_level[16], shown_conf[16];
+    char line[16];
 
-    ssd1306_fill(&oled_display, false);
+    if (!layout_drawn) {
+        ssd1306_fill(&oled_display, false);
+        ssd1306_hline(&oled_display, 0, 127, 18, true);
+        layout_drawn = true;
+    }
 
-    // Title
-    ssd1306_draw_string(&oled_display, "MOTOR LEVEL", 28, 5, false);
-    ssd1306_hline(&oled_display, 0, 127, 18, true);
+    // Title; with several motors the pages rotate, one motor every DISPLAY_PAGE_MS
+#if MOTOR_SENSOR_COUNT > 1
+    const int page = (int)(time_us_64() / 1000 / DISPLAY_PAGE_MS % MOTOR_SENSOR_COUNT);
+    snprintf(line, sizeof(line), "MOTOR %d", page);
+    update_line(shown_title, line, 36, 5, 0, 16);
+#else
+    const int page = 0;
+    update_line(shown_title, "MOTOR LEVEL", 28, 5, 0, 16);
+#endif
+    const motor_t *m = &motors[page];
 
     // Display predicted level
-    if (predicted_level != -1) {
-        snprintf(line, sizeof(line), "Nivel: %d", predicted_level);
-        ssd1306_draw_string(&oled_display, line, 35, 30, false);
+    if (m->predicted_level != -1) {
+        snprintf(line, sizeof(line), "Nivel: %d", m->predicted_level);
+        update_line(shown_level, line, 35, 30, 24, 20);
 
-        snprintf(line, sizeof(line), "Acc: %.1f%%", confidence * 100.0f);
-        ssd1306_draw_string(&oled_display, line, 30, 45, false);
+        snprintf(line, sizeof(line), "Acc: %.1f%%", m->confidence * 100.0f);
+        update_line(shown_conf, line, 30, 45, 44, 12);
     } else {
-        ssd1306_draw_string(&oled_display, "Aguardando...", 15, 35, false);
+        update_line(shown_level, "Aguardando...", 15, 35, 24, 20);
+        update_line(shown_conf, "", 30, 45, 44, 12);
     }
 
-    ssd1306_send_data(&oled_display);
+    // Never waits: if the previous frame is still on the bus, the changes go out next time
+    ssd1306_send_data_async(&oled_display);
 }
 
+#ifdef MOTOR_WINDOW_FEATURES
+// Window model: every sample goes into the sliding window (features are updated
+// incrementally, the window is never recomputed)
+// (one motor only: MOTOR_SENSOR_COUNT > 1 is per-sample, see CMakeLists.txt)
+static window_features_t window;
+#ifdef MOTOR_SPECTRAL_FEATURES
+// Band energies: the push only stores the Q15 sample, the FFT runs once per classification
+static spectral_features_t spectrum;
+#endif
+
+void reset_windows(void) {
+    window_features_init(&window);
+#ifdef MOTOR_SPECTRAL_FEATURES
+    spectral_features_init(&spectrum);
+#endif
+#ifdef MOTOR_SENSOR_FILTER
+    sample_filter_init(&motors[0].sample_filter);
+#endif
+}
+
+// Push a burst of FIFO frames into the window, oldest first
+void push_frames(const mpu6050_frame_t *frames, int n) {
+#ifdef MOTOR_SENSOR_FILTER
+    // Decimate first: telemetry, the log and the window all see the model rate
+    mpu6050_frame_t decimated[FIFO_BURST_FRAMES];
+    int kept = 0;
+    for (int i = 0; i < n; i++) kept += decimate_frame(&motors[0], &frames[i], &decimated[kept]);
+    frames = decimated;
+    n = kept;
+#endif
+    telemetry_send_samples(0, frames, n);
+#ifdef MOTOR_FLASH_LOG
+    for (int i = 0; i < n; i++) flash_log_append(&frames[i]);
+#endif
+
+    for (int i = 0; i < n; i++) {
+        // Integer path: the window takes thousandths (mm/s², m°/s) and the spectrum the raw counts,
+        // which already are its Q15 samples, so no float is touched per sample
+        mpu6050_fixed_t fixed;
+        mpu6050_frame_to_fixed(&frames[i], &fixed);
+        const int32_t sample[6] = {fixed.accel_mms2[0], fixed.accel_mms2[1], fixed.accel_mms2[2],
+                                   fixed.gyro_mdps[0], fixed.gyro_mdps[1], fixed.gyro_mdps[2]};
+        window_features_push_fixed(&window, sample);
+#ifdef MOTOR_SPECTRAL_FEATURES
+        const int16_t counts[6] = {frames[i].accel[0], frames[i].accel[1], frames[i].accel[2],
+                                   frames[i].gyro[0], frames[i].gyro[1], frames[i].gyro[2]};
+        spectral_features_push_counts(&spectrum, counts);
+#endif
+#ifdef MOTOR_CHANGE_DETECT
+        // The detector works in physical units (its noise floors are in m/s² and °/s)
+        mpu6050_data_t data;
+        mpu6050_frame_to_data(&frames[i], &data);
+        float physical[6] = {data.accel_x, data.accel_y, data.accel_z, data.gyro_x, data.gyro_y, data.gyro_z};
+        change_detector_push(&motors[0].detector, physical);
+#endif
+    }
+}
+
+// Model inputs of the latest window; false while the window is not full yet
+bool compute_window(float in_features[TFLM_NUM_FEATURES]) {
+#ifdef MOTOR_SPECTRAL_FEATURES
+    if (!window_features_ready(&window) || !spectral_features_ready(&spectrum)) return false;
+#else
+    if (!window_features_ready(&window)) return false;
+#endif
+
+    window_features_compute(&window, in_features);
+#ifdef MOTOR_SPECTRAL_FEATURES
+    spectral_features_compute(&spectrum, in_features + WINDOW_NUM_FEATURES);
+#endif
+    return true;
+}
+
+// Classify the latest window once it is full
+void classify_window(void) {
+    float in_features[TFLM_NUM_FEATURES];
+    if (compute_window(in_features)) classify(in_features);
+}
+
+// One poll of the sensor FIFO: start the DMA burst into one buffer and, while it lands, push the
+// burst received on the previous poll and hand it to on_burst (double buffer)
+// Returns true if the burst was full, i.e. the FIFO still has a backlog to drain without sleeping
+bool acquire_poll(void (*on_burst)(void)) {
+    static mpu6050_frame_t frames[2][FIFO_BURST_FRAMES];
+    static int cur = 0, prev_n = 0;
+
+    mpu6050_t *sensor = &motors[0].sensor;
+    int n = mpu6050_fifo_read_start(sensor, frames[cur], FIFO_BURST_FRAMES);
+
+    if (prev_n > 0) {
+        push_frames(frames[cur ^ 1], prev_n);
+        on_burst();
+    }
+
+    if (n > 0) n = mpu6050_fifo_read_finish(sensor);
+    if (n < 0) {
+        // Overflow (or no ACK): samples were lost, so the windows would mix data across a gap
+        printf("MPU6050 FIFO overflow, restarting the window\n");
+        reset_windows();
+#ifdef MOTOR_FLASH_LOG
+        // The contiguous burst ends here: its partial sector goes to flash before the gap
+        flash_log_flush();
+#endif
+        n = 0;
+    }
+    prev_n = n;
+    cur ^= 1;
+    return n == FIFO_BURST_FRAMES;
+}
+
+#ifdef MOTOR_DUAL_CORE
+// Dual-core pipeline: core 1 owns the sensor (FIFO, DMA, feature extraction) and hands every
+// completed window to core 0 through the queue; core 0 only classifies and drives the display,
+// so sampling never waits for an inference or a display refresh
+typedef struct {
+    float features[TFLM_NUM_FEATURES];
+    change_t change; // what the change detector (core 1) saw up to this window
+} window_msg_t;
+
+static window_msg_t window_queue_storage[WINDOW_QUEUE_DEPTH];
+static spsc_queue_t window_queue;
+static volatile uint32_t windows_dropped; // windows core 0 was too slow to take (queue full)
+
+// Core 1: compute the window of the burst just pushed and send it to core 0
+void publish_window(void) {
+    window_msg_t msg;
+    if (!compute_window(msg.features)) return;
+    msg.change = detect_change(&motors[0]);
+    if (!spsc_queue_push(&window_queue, &msg)) windows_dropped++;
+}
+
+void core1_entry(void) {
+#ifdef MOTOR_FLASH_LOG
+    // Core 0 pauses this core while it erases/programs the flash (XIP is off meanwhile)
+    flash_safe_execute_core_init();
+#endif
+#ifdef MOTOR_SENSOR_IRQ
+    // GPIO interrupts go to the core that registers the callback: the INT pulses wake this one
+    power_init(SENSOR_INT_GPIO, SENSOR_FRAMES_PER_WAKE);
+#endif
+    while (1) {
+#ifdef MOTOR_SENSOR_IRQ
+        power_sensor_ack();
+#endif
+        if (acquire_poll(publish_window)) continue;
+#ifdef MOTOR_SENSOR_IRQ
+        // Sleep until the FIFO holds another poll's worth of frames
+        power_sleep_until(&core1_power, time_us_64() + SENSOR_TIMEOUT_MS * 1000, true);
+#else
+        sleep_ms(WINDOW_POLL_MS);
+#endif
+    }
+}
+#endif
+#endif
+
+// --- TASKS ---
+
+#ifdef MOTOR_WINDOW_FEATURES
+#ifdef MOTOR_DUAL_CORE
+// Core 0: classify the windows core 1 published since the last run (every stride-th one)
+void infer_task(void) {
+    window_msg_t msg;
+    while (spsc_queue_pop(&window_queue, &msg)) {
+        if (infer_due(&motors[0], msg.change)) classify(msg.features);
+    }
+}
+#else
+static bool window_updated; // a burst was pushed since the last classification
+
+void mark_window_updated(void) {
+    window_updated = true;
+}
+
+// Drain the FIFO, including any backlog of full bursts
+void sensor_task(void) {
+#ifdef MOTOR_SENSOR_IRQ
+    power_sensor_ack();
+#endif
+    while (acquire_poll(mark_window_updated)) {
+    }
+}
+
+// Classify the latest window if new samples arrived
+void infer_task(void) {
+    if (!window_updated) return;
+    window_updated = false;
+    if (infer_due(&motors[0], detect_change(&motors[0]))) classify_window();
+}
+#endif
+#else
+// Per-sample model: the sensor task reads one raw sample of every motor per period (round robin
+// over the sensors) and queues the tick; the inference task converts the ticks queued since its
+// last run and classifies, in one pass per tick, the motors infer_due picks
+static sensor_tick_t sample_queue_storage[SAMPLE_QUEUE_DEPTH];
+static spsc_queue_t sample_queue;
+static uint32_t samples_dropped; // ticks the inference task was too slow to take (queue full)
+
+void sensor_task(void) {
+    sensor_tick_t tick;
+    bool decimated = true;
+#ifdef MOTOR_SENSOR_IRQ
+    power_sensor_ack();
+#endif
+    for (int k = 0; k < MOTOR_SENSOR_COUNT; k++) {
+        motor_t *m = &motors[k];
+        // Sensors on the display bus wait for a display frame still going out by DMA
+        if (m->sensor.i2c == I2C_DISPLAY_PORT) ssd1306_send_wait(&oled_display);
+        mpu6050_read_frame(&m->sensor, &tick.frames[k]);
+#ifdef MOTOR_SENSOR_FILTER
+        // Every filter is pushed once per read, so all of them decimate on the same read
+        decimated = decimate_frame(m, &tick.frames[k], &tick.frames[k]);
+#endif
+    }
+    if (!decimated) return;
+    for (int k = 0; k < MOTOR_SENSOR_COUNT; k++) telemetry_send_samples((uint8_t)k, &tick.frames[k], 1);
+    if (!spsc_queue_push(&sample_queue, &tick)) samples_dropped++;
+}
+
+void infer_task(void) {
+    sensor_tick_t tick;
+    while (spsc_queue_pop(&sample_queue, &tick)) {
+#ifdef MOTOR_FLASH_LOG
+        // Every sample is logged, classified or not (single motor only)
+        flash_log_append(&tick.frames[0]);
+#endif
+        int due[MOTOR_SENSOR_COUNT], n = 0;
+        for (int k = 0; k < MOTOR_SENSOR_COUNT; k++) {
+            motor_t *m = &motors[k];
+            m->last_frame = tick.frames[k];
+#ifdef MOTOR_CHANGE_DETECT
+            // The detector works in physical units (its noise floors are in m/s² and °/s)
+            mpu6050_data_t data;
+            mpu6050_frame_to_data(&tick.frames[k], &data);
+            float sample[6] = {data.accel_x, data.accel_y, data.accel_z, data.gyro_x, data.gyro_y, data.gyro_z};
+            change_detector_push(&m->detector, sample);
+#endif
+            if (infer_due(m, detect_change(m))) due[n++] = k;
+        }
+
+        // Run inference (normalization is handled inside the wrapper) and smooth the scores
+        if (n > 0) classify(&tick, due, n);
+    }
+}
+#endif
+
+void display_task(void) {
+    update_display();
+}
+
+#ifdef MOTOR_FLASH_LOG
+void logger_task(void) {
+    flash_log_service();
+}
+#endif
+
+static scheduler_t scheduler;
+
+// Prediction plus the scheduler report (deadline misses and CPU load of the last period)
+void telemetry_task(void) {
+    if (telemetry_level() != TELEMETRY_OFF) {
+        // Binary: predictions and samples already went out as they happened, only the report is left
+#if defined(MOTOR_DUAL_CORE)
+        telemetry_send_status(&scheduler, windows_dropped);
+#elif defined(MOTOR_WINDOW_FEATURES)
+        telemetry_send_status(&scheduler, 0);
+#else
+        telemetry_send_status(&scheduler, samples_dropped);
+#endif
+        scheduler_reset_stats(&scheduler);
+        return;
+    }
+
+#if defined(MOTOR_DUAL_CORE)
+    printf("Prediction: %d (Confidence: %.1f%%, %lu windows dropped)\n", motors[0].predicted_level,
+           motors[0].confidence * 100.0f, (unsigned long)windows_dropped);
+#elif defined(MOTOR_WINDOW_FEATURES)
+    printf("Prediction: %d (Confidence: %.1f%%)\n", motors[0].predicted_level, motors[0].confidence * 100.0f);
+#elif MOTOR_SENSOR_COUNT > 1
+    for (int k = 0; k < MOTOR_SENSOR_COUNT; k++) {
+        printf("Motor %d prediction: %d (Confidence: %.1f%%)\n", k, motors[k].predicted_level,
+               motors[k].confidence * 100.0f);
+    }
+    printf("%lu ticks dropped\n", (unsigned long)samples_dropped);
+#else
+    mpu6050_data_t sensor_data;
+    mpu6050_frame_to_data(&motors[0].last_frame, &sensor_data);
+    printf("Raw -> Acc(%.2f, %.2f, %.2f) Gyr(%.2f, %.2f, %.2f)\n",
+           sensor_data.accel_x, sensor_data.accel_y, sensor_data.accel_z,
+           sensor_data.gyro_x, sensor_data.gyro_y, sensor_data.gyro_z);
+    printf("Prediction: %d (Confidence: %.1f%%, %lu samples dropped)\n", motors[0].predicted_level,
+           motors[0].confidence * 100.0f, (unsigned long)samples_dropped);
+#endif
+#ifdef MOTOR_CHANGE_DETECT
+    uint32_t due = infer_stride + infer_skipped;
+    printf("Change detector: %lu drift + %lu refresh + %lu stride inferences, %lu skipped (%.1f%% of due)\n",
+           (unsigned long)infer_drift, (unsigned long)infer_refresh, (unsigned long)infer_stride,
+           (unsigned long)infer_skipped, due ? 100.0f * infer_skipped / due : 0.0f);
+#endif
+    if (infer_errors) printf("%lu inferences failed\n", (unsigned long)infer_errors);
+#ifdef MOTOR_FLASH_LOG
+    flash_log_stats_t log = flash_log_get_stats();
+    printf("Flash log: %lu records, %lu dropped, %lu sectors written\n", (unsigned long)log.records,
+           (unsigned long)log.dropped, (unsigned long)log.sectors);
+#endif
+#ifdef MOTOR_SENSOR_IRQ
+    power_report(&core0_power, &core0_window, "core0", classified);
+#ifdef MOTOR_DUAL_CORE
+    power_report(&core1_power, &core1_window, "core1", classified);
+#endif
+    classified = 0;
+#endif
+    scheduler_print_stats(&scheduler);
+    scheduler_reset_stats(&scheduler);
+}
+
+static scheduler_task_t tasks[] = {
+#if defined(MOTOR_SENSOR_IRQ) && !defined(MOTOR_DUAL_CORE)
+    {.name = "sensor", .run = sensor_task, .period_us = SENSOR_TIMEOUT_MS * 1000, .deadline_us = SENSOR_DEADLINE_US,
+     .ready = power_sensor_pending},
+#elif !defined(MOTOR_DUAL_CORE)
+    {.name = "sensor", .run = sensor_task, .period_us = SENSOR_READ_US, .deadline_us = SENSOR_DEADLINE_US},
+#endif
+    {.name = "infer", .run = infer_task, .period_us = INFER_PERIOD_MS * 1000},
+    {.name = "display", .run = display_task, .period_us = DISPLAY_PERIOD_MS * 1000},
+    {.name = "telemetry", .run = telemetry_task, .period_us = TELEMETRY_PERIOD_MS * 1000},
+#ifdef MOTOR_FLASH_LOG
+    {.name = "logger", .run = logger_task, .period_us = LOGGER_PERIOD_MS * 1000},
+#endif
+};
+
 // --- MAIN ---
 
 int main(void) {
@@ -109,43 +749,83 @@ int main(void) {
     }
 
     printf("--- Starting Inference Loop ---\n");
+    for (int k = 0; k < MOTOR_SENSOR_COUNT; k++) {
+        motors[k].predicted_level = -1;
+        prediction_filter_init(&motors[k].filter);
+#ifdef MOTOR_CHANGE_DETECT
+        change_detector_init(&motors[k].detector);
+#endif
+#if defined(MOTOR_SENSOR_FILTER) && !defined(MOTOR_WINDOW_FEATURES)
+        sample_filter_init(&motors[k].sample_filter);
+#endif
+    }
 
-    // Main loop
-    while (1) {
-        // Read raw sensor data
-        mpu6050_read_data(&sensor_data);
-
-        // Prepare features for the model (raw data)
-        float in_features[6] = {
-            sensor_data.accel_x,
-            sensor_data.accel_y,
-            sensor_data.accel_z,
-            sensor_data.gyro_x,
-            sensor_data.gyro_y,
-            sensor_data.gyro_z
-        };
-
-        printf("Raw -> Acc(%.2f, %.2f, %.2f) Gyr(%.2f, %.2f, %.2f)\n",
-               in_features[0], in_features[1], in_features[2],
-               in_features[3], in_features[4], in_features[5]);
+#ifdef MOTOR_WINDOW_FEATURES
+    reset_windows();
 
-        // Run inference (normalization is handled inside tflm_infer)
-        float out_scores[4];
-        tflm_infer(in_features, out_scores);
+#ifdef MOTOR_SENSOR_FILTER
+    // Oversampled FIFO; the frames are decimated back to the window rate before the window
+    uint32_t fifo_hz = mpu6050_fifo_start(&motors[0].sensor, 1000 / WINDOW_SAMPLE_MS * SENSOR_OVERSAMPLE, SENSOR_DLPF);
+    uint32_t rate_hz = fifo_hz / SENSOR_OVERSAMPLE;
+    printf("MPU6050 FIFO: %lu Hz, decimated by %d to %lu Hz\n", (unsigned long)fifo_hz, SENSOR_OVERSAMPLE,
+           (unsigned long)rate_hz);
+#else
+    // Sample rate divider + 44 Hz DLPF (below the 50 Hz Nyquist limit of the 100 Hz window rate)
+    uint32_t rate_hz = mpu6050_fifo_start(&motors[0].sensor, 1000 / WINDOW_SAMPLE_MS, MPU6050_DLPF_44HZ);
+    printf("MPU6050 FIFO: %lu Hz\n", (unsigned long)rate_hz);
+#endif
+#else
+    uint32_t rate_hz = 1000 / SENSOR_PERIOD_MS;
+#ifdef MOTOR_SENSOR_FILTER
+    printf("Sensor read at %lu Hz, decimated by %d\n", (unsigned long)(rate_hz * SENSOR_OVERSAMPLE), SENSOR_OVERSAMPLE);
+#endif
+#ifdef MOTOR_CHANNEL_MODEL
+    // Reduced-channel model: read only the axes it was trained on (fewer bytes per sample on the bus)
+    for (int k = 0; k < MOTOR_SENSOR_COUNT; k++) mpu6050_set_channels(&motors[k].sensor, MOTOR_SENSOR_CHANNELS);
+    printf("MPU6050 channels 0x%02x: %u bytes per sample\n", mpu6050_channels(&motors[0].sensor),
+           mpu6050_sample_bytes(&motors[0].sensor));
+#endif
+#endif
 
-        printf("Scores -> L0: %.3f, L1: %.3f, L2: %.3f, L3: %.3f\n",
-               out_scores[0], out_scores[1], out_scores[2], out_scores[3]);
+    // From here on the report goes out as binary frames, unless the level is TELEMETRY_OFF
+    telemetry_init(MOTOR_TELEMETRY_LEVEL, (uint16_t)rate_hz, 4, MOTOR_SENSOR_COUNT);
 
-        // Get the predicted level
-        predicted_level = argmax(out_scores, 4);
-        confidence = out_scores[predicted_level];
+#ifdef MOTOR_SENSOR_IRQ
+#ifndef MOTOR_WINDOW_FEATURES
+#ifdef MOTOR_SENSOR_FILTER
+    // The sensor paces the oversampled reads
+    mpu6050_set_sample_rate(&motors[0].sensor, rate_hz * SENSOR_OVERSAMPLE, SENSOR_DLPF);
+#else
+    // The sensor paces the samples: 100 Hz with the default 260 Hz DLPF the CSVs were captured with
+    mpu6050_set_sample_rate(&motors[0].sensor, rate_hz, MPU6050_DLPF_260HZ);
+#endif
+#endif
+    mpu6050_enable_data_ready_int(&motors[0].sensor, true);
+    power_window_start(&core0_window, &core0_power);
+#ifdef MOTOR_DUAL_CORE
+    power_window_start(&core1_window, &core1_power);
+#else
+    power_init(SENSOR_INT_GPIO, SENSOR_FRAMES_PER_WAKE);
+#endif
+#endif
 
-        printf("Prediction: %d (Confidence: %.1f%%)\n\n", predicted_level, confidence * 100.0f);
+#ifdef MOTOR_FLASH_LOG
+    // Resumes after the newest sector already in flash
+    if (flash_log_init((uint16_t)rate_hz)) flash_log_set_label(FLASH_LOG_LABEL);
+#endif
 
-        // Update the display
-        update_display();
+#ifdef MOTOR_WINDOW_FEATURES
+#ifdef MOTOR_DUAL_CORE
+    spsc_queue_init(&window_queue, window_queue_storage, sizeof(window_queue_storage[0]), WINDOW_QUEUE_DEPTH);
+    multicore_launch_core1(core1_entry);
+#endif
+#else
+    spsc_queue_init(&sample_queue, sample_queue_storage, sizeof(sample_queue_storage[0]), SAMPLE_QUEUE_DEPTH);
+#endif
 
-        // Wait before the next reading
-        sleep_ms(UPDATE_TIME_MS);
-    }
+    scheduler_init(&scheduler, tasks, sizeof(tasks) / sizeof(tasks[0]));
+#ifdef MOTOR_SENSOR_IRQ
+    scheduler.idle = core0_idle;
+#endif
+    scheduler_run(&scheduler);
 }
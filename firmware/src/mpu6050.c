@@ -1,15 +1,33 @@
 #include "mpu6050.h"
+#include "i2c_dma.h"
 #include "pico/stdlib.h"
 #include <stdio.h>
 
-// Endereço I2C padrão do MPU6050
-static const uint8_t MPU6050_ADDR = 0x68;
+// mpu6050_fifo_read lê os bytes da FIFO direto no vetor de frames
+_Static_assert(sizeof(mpu6050_frame_t) == MPU6050_FIFO_FRAME_BYTES, "mpu6050_frame_t precisa ter o layout do frame da FIFO");
 
 // Registradores do MPU6050
 static const uint8_t REG_PWR_MGMT_1 = 0x6B;
 static const uint8_t REG_ACCEL_XOUT_H = 0x3B;
 static const uint8_t REG_GYRO_XOUT_H = 0x43;
 static const uint8_t REG_TEMP_OUT_H = 0x41;
+static const uint8_t REG_SMPLRT_DIV = 0x19;
+static const uint8_t REG_CONFIG = 0x1A;
+static const uint8_t REG_FIFO_EN = 0x23;
+static const uint8_t REG_INT_PIN_CFG = 0x37;
+static const uint8_t REG_INT_ENABLE = 0x38;
+static const uint8_t REG_INT_STATUS = 0x3A;
+static const uint8_t REG_USER_CTRL = 0x6A;
+static const uint8_t REG_FIFO_COUNT_H = 0x72;
+static const uint8_t REG_FIFO_R_W = 0x74;
+
+// Bits usados da FIFO
+static const uint8_t FIFO_EN_ACCEL = 0x08;       // os 3 eixos da aceleração (6 bytes)
+static const uint8_t FIFO_EN_XG = 0x40;          // eixo X do giroscópio (2 bytes); YG = 0x20, ZG = 0x10
+static const uint8_t USER_CTRL_FIFO_EN = 0x40;
+static const uint8_t USER_CTRL_FIFO_RESET = 0x04;
+static const uint8_t INT_STATUS_FIFO_OFLOW = 0x10;
+static const uint8_t INT_ENABLE_DATA_RDY = 0x01;
 
 // Fatores de sensibilidade (para a configuração padrão)
 // Aceleração: ±2g -> 16384 LSB/g
@@ -19,60 +37,260 @@ static const float ACCEL_SENSITIVITY = 16384.0;
 static const float GYRO_SENSITIVITY = 131.0;
 static const float GRAVITY_MS2 = 9.81;
 
-// Ponteiro para a instância I2C usada
-static i2c_inst_t *i2c_port;
+// Deslocamento de cada canal a partir de ACCEL_XOUT_H (a temperatura ocupa os bytes 6 e 7)
+static const uint8_t channel_offset[6] = {0, 2, 4, 8, 10, 12};
 
 /**
  * @brief Reseta o MPU6050 e o tira do modo de suspensão.
  * Função interna chamada por mpu6050_init.
  */
-static void mpu6050_reset() {
+static void mpu6050_reset(mpu6050_t *dev) {
     uint8_t buf[] = {REG_PWR_MGMT_1, 0x80};
-    i2c_write_blocking(i2c_port, MPU6050_ADDR, buf, 2, false);
+    i2c_write_blocking(dev->i2c, dev->addr, buf, 2, false);
     sleep_ms(100); // Aguarda o reset
 
     buf[1] = 0x00; // Acorda o dispositivo
-    i2c_write_blocking(i2c_port, MPU6050_ADDR, buf, 2, false);
+    i2c_write_blocking(dev->i2c, dev->addr, buf, 2, false);
     sleep_ms(10); // Aguarda estabilização
 }
 
+// Escreve um registrador
+static void write_reg(mpu6050_t *dev, uint8_t reg, uint8_t value) {
+    uint8_t buf[] = {reg, value};
+    i2c_write_blocking(dev->i2c, dev->addr, buf, 2, false);
+}
+
+// Lê len bytes a partir de reg (auto-incremento, exceto em FIFO_R_W que devolve a FIFO em sequência)
+static void read_regs(mpu6050_t *dev, uint8_t reg, uint8_t *dst, size_t len) {
+    i2c_write_blocking(dev->i2c, dev->addr, &reg, 1, true); // true para manter o controle do barramento
+    i2c_read_blocking(dev->i2c, dev->addr, dst, len, false);
+}
+
 // Implementação da função de inicialização
-void mpu6050_init(i2c_inst_t *i2c) {
-    i2c_port = i2c;
-    mpu6050_reset();
-    printf("MPU6050 inicializado com sucesso.\n");
+void mpu6050_init(mpu6050_t *dev, i2c_inst_t *i2c, uint8_t addr) {
+    dev->i2c = i2c;
+    dev->addr = addr;
+    dev->last_temp_raw = 0;
+    dev->pending_frames = NULL;
+    dev->pending_count = 0;
+    mpu6050_set_channels(dev, MPU6050_CH_ALL);
+    i2c_dma_init(i2c);  // uma vez por porta, os outros sensores da porta reaproveitam os canais
+    mpu6050_reset(dev);
+    printf("MPU6050 0x%02x inicializado com sucesso.\n", addr);
+}
+
+// Lê numa rajada o trecho dos registradores de dados que cobre os canais escolhidos
+// (aceleração, temperatura e giroscópio com todos) e devolve a temperatura bruta
+static int16_t read_sample(mpu6050_t *dev, mpu6050_frame_t *frame) {
+    uint8_t buffer[14] = {0};
+
+    // O MPU6050 auto-incrementa o endereço, então o trecho sai de uma vez
+    read_regs(dev, REG_ACCEL_XOUT_H + dev->span_first, buffer + dev->span_first, dev->span_len);
+
+    // Extrai e combina os bytes dos canais escolhidos (os outros ficam em 0)
+    for (int c = 0; c < 6; c++) {
+        const uint8_t *b = buffer + channel_offset[c];
+        int16_t v = (dev->channel_mask & (1u << c)) ? (int16_t)((b[0] << 8) | b[1]) : 0;
+        if (c < 3) frame->accel[c] = v;
+        else frame->gyro[c - 3] = v;
+    }
+    // A temperatura só é atualizada se o trecho passou por ela
+    if (dev->span_first <= 6 && dev->span_first + dev->span_len >= 8) {
+        dev->last_temp_raw = (int16_t)((buffer[6] << 8) | buffer[7]);
+    }
+    return dev->last_temp_raw;
 }
 
 // Implementação da função de leitura e conversão de dados
-void mpu6050_read_data(mpu6050_data_t *data) {
-    uint8_t buffer[14];
-    
-    // Inicia a leitura a partir do registrador de aceleração (0x3B)
-    // O MPU6050 auto-incrementa o endereço, então podemos ler tudo de uma vez
-    uint8_t start_reg = REG_ACCEL_XOUT_H;
-    i2c_write_blocking(i2c_port, MPU6050_ADDR, &start_reg, 1, true); // true para manter o controle do barramento
-    i2c_read_blocking(i2c_port, MPU6050_ADDR, buffer, 14, false);
-
-    // 1. Extrai e combina os bytes para formar os valores brutos (int16_t)
-    int16_t raw_ax = (buffer[0] << 8) | buffer[1];
-    int16_t raw_ay = (buffer[2] << 8) | buffer[3];
-    int16_t raw_az = (buffer[4] << 8) | buffer[5];
-    int16_t raw_temp = (buffer[6] << 8) | buffer[7];
-    int16_t raw_gx = (buffer[8] << 8) | buffer[9];
-    int16_t raw_gy = (buffer[10] << 8) | buffer[11];
-    int16_t raw_gz = (buffer[12] << 8) | buffer[13];
+void mpu6050_read_data(mpu6050_t *dev, mpu6050_data_t *data) {
+    // 1. Lê os valores brutos
+    mpu6050_frame_t frame;
+    int16_t raw_temp = read_sample(dev, &frame);
 
     // 2. Converte os valores brutos para unidades físicas
+    mpu6050_frame_to_data(&frame, data);
+
+    // Temperatura: usa a fórmula do datasheet com correção de calibração (em inteiros, sem double)
+    data->temp_c = (float)mpu6050_temp_centi_c(raw_temp) / 100.0f;
+}
+
+void mpu6050_read_frame(mpu6050_t *dev, mpu6050_frame_t *frame) {
+    read_sample(dev, frame);
+}
+
+int16_t mpu6050_last_temp_raw(const mpu6050_t *dev) {
+    return dev->last_temp_raw;
+}
+
+void mpu6050_set_channels(mpu6050_t *dev, uint8_t channels) {
+    uint8_t mask = channels & MPU6050_CH_ALL;
+    if (!mask) mask = MPU6050_CH_ALL;
+
+    int first = -1, last = 0;
+    for (int c = 0; c < 6; c++) {
+        if (!(mask & (1u << c))) continue;
+        if (first < 0) first = channel_offset[c];
+        last = channel_offset[c] + 2;
+    }
+    dev->channel_mask = mask;
+    dev->span_first = (uint8_t)first;
+    dev->span_len = (uint8_t)(last - first);
+    dev->fifo_frame_bytes = (uint8_t)(((mask & MPU6050_CH_ACCEL) ? 6 : 0) +
+                                      2 * MPU6050_CHANNEL_COUNT(mask & MPU6050_CH_GYRO));
+}
+
+uint8_t mpu6050_channels(const mpu6050_t *dev) {
+    return dev->channel_mask;
+}
+
+unsigned int mpu6050_sample_bytes(const mpu6050_t *dev) {
+    return dev->span_len;
+}
+
+unsigned int mpu6050_fifo_frame_bytes(const mpu6050_t *dev) {
+    return dev->fifo_frame_bytes;
+}
+
+// FIFO_EN dos canais escolhidos
+static uint8_t fifo_enable_bits(const mpu6050_t *dev) {
+    uint8_t en = (dev->channel_mask & MPU6050_CH_ACCEL) ? FIFO_EN_ACCEL : 0;
+    for (int g = 0; g < 3; g++) {
+        if (dev->channel_mask & (MPU6050_CH_GYRO_X << g)) en |= (uint8_t)(FIFO_EN_XG >> g);
+    }
+    return en;
+}
+
+void mpu6050_frame_to_data(const mpu6050_frame_t *frame, mpu6050_data_t *data) {
     // Aceleração: LSB -> g -> m/s²
-    data->accel_x = (raw_ax / ACCEL_SENSITIVITY) * GRAVITY_MS2;
-    data->accel_y = (raw_ay / ACCEL_SENSITIVITY) * GRAVITY_MS2;
-    data->accel_z = (raw_az / ACCEL_SENSITIVITY) * GRAVITY_MS2;
+    data->accel_x = (frame->accel[0] / ACCEL_SENSITIVITY) * GRAVITY_MS2;
+    data->accel_y = (frame->accel[1] / ACCEL_SENSITIVITY) * GRAVITY_MS2;
+    data->accel_z = (frame->accel[2] / ACCEL_SENSITIVITY) * GRAVITY_MS2;
 
     // Giroscópio: LSB -> °/s
-    data->gyro_x = raw_gx / GYRO_SENSITIVITY;
-    data->gyro_y = raw_gy / GYRO_SENSITIVITY;
-    data->gyro_z = raw_gz / GYRO_SENSITIVITY;
+    data->gyro_x = frame->gyro[0] / GYRO_SENSITIVITY;
+    data->gyro_y = frame->gyro[1] / GYRO_SENSITIVITY;
+    data->gyro_z = frame->gyro[2] / GYRO_SENSITIVITY;
+}
+
+// Contagem * mult >> shift com arredondamento (o deslocamento aritmético arredonda para baixo)
+static inline int32_t scale_fixed(int16_t raw, int32_t mult, int shift) {
+    return (raw * mult + (1 << (shift - 1))) >> shift;
+}
+
+void mpu6050_frame_to_fixed(const mpu6050_frame_t *frame, mpu6050_fixed_t *fixed) {
+    for (int i = 0; i < 3; i++) {
+        fixed->accel_mms2[i] = scale_fixed(frame->accel[i], MPU6050_ACCEL_MMS2_MULT, MPU6050_ACCEL_MMS2_SHIFT);
+        fixed->gyro_mdps[i] = scale_fixed(frame->gyro[i], MPU6050_GYRO_MDPS_MULT, MPU6050_GYRO_MDPS_SHIFT);
+    }
+}
+
+uint32_t mpu6050_set_sample_rate(mpu6050_t *dev, uint32_t rate_hz, mpu6050_dlpf_t dlpf) {
+    // Taxa de saída do giroscópio: 8 kHz sem filtro, 1 kHz com o DLPF ligado
+    // Taxa de amostragem = base / (1 + SMPLRT_DIV); o acelerômetro para em 1 kHz (repete amostras acima disso)
+    const uint32_t base_hz = dlpf == MPU6050_DLPF_260HZ ? 8000 : 1000;
+    if (rate_hz == 0) rate_hz = 1;
+    uint32_t div = base_hz / rate_hz;
+    div = div == 0 ? 0 : div - 1;
+    if (div > 255) div = 255;
+
+    write_reg(dev, REG_CONFIG, (uint8_t)dlpf);
+    write_reg(dev, REG_SMPLRT_DIV, (uint8_t)div);
+    return base_hz / (1 + div);
+}
+
+void mpu6050_enable_data_ready_int(mpu6050_t *dev, bool enable) {
+    // INT_PIN_CFG 0: ativo em nível alto, push-pull, pulso de 50 us (sem latch, nada a limpar)
+    write_reg(dev, REG_INT_PIN_CFG, 0x00);
+    write_reg(dev, REG_INT_ENABLE, enable ? INT_ENABLE_DATA_RDY : 0x00);
+}
+
+// --- Modo FIFO ---
+
+uint32_t mpu6050_fifo_start(mpu6050_t *dev, uint32_t rate_hz, mpu6050_dlpf_t dlpf) {
+    write_reg(dev, REG_USER_CTRL, 0x00);  // para a FIFO enquanto reconfigura
+    uint32_t actual_hz = mpu6050_set_sample_rate(dev, rate_hz, dlpf);
+    write_reg(dev, REG_FIFO_EN, fifo_enable_bits(dev));
+    write_reg(dev, REG_USER_CTRL, USER_CTRL_FIFO_RESET);
+    uint8_t status;
+    read_regs(dev, REG_INT_STATUS, &status, 1);  // limpa um overflow antigo
+    write_reg(dev, REG_USER_CTRL, USER_CTRL_FIFO_EN);
+
+    return actual_hz;
+}
 
-   // Temperatura: usa a fórmula do datasheet com correção de calibração
-    data->temp_c = (raw_temp / 340.0) + 36.53 - 24.0;
-}
\ No newline at end of file
+void mpu6050_fifo_stop(mpu6050_t *dev) {
+    write_reg(dev, REG_USER_CTRL, 0x00);
+    write_reg(dev, REG_FIFO_EN, 0x00);
+    write_reg(dev, REG_USER_CTRL, USER_CTRL_FIFO_RESET);
+}
+
+int mpu6050_fifo_read_start(mpu6050_t *dev, mpu6050_frame_t *frames, int max_frames) {
+    if (dev->pending_frames) return 0;  // uma leitura por vez: a porta está ocupada pelo DMA
+
+    // INT_STATUS é limpo na leitura: com overflow a FIFO sobrescreveu dados e o alinhamento
+    // dos frames se perdeu, então só resta zerar
+    uint8_t status;
+    read_regs(dev, REG_INT_STATUS, &status, 1);
+    if (status & INT_STATUS_FIFO_OFLOW) {
+        write_reg(dev, REG_USER_CTRL, USER_CTRL_FIFO_EN | USER_CTRL_FIFO_RESET);
+        return -1;
+    }
+
+    uint8_t count_buf[2];
+    read_regs(dev, REG_FIFO_COUNT_H, count_buf, 2);
+    const int frame_bytes = dev->fifo_frame_bytes;
+    int available = ((count_buf[0] << 8) | count_buf[1]) / frame_bytes;
+    int n = available < max_frames ? available : max_frames;
+    if (n > I2C_DMA_MAX_LEN / frame_bytes) n = I2C_DMA_MAX_LEN / frame_bytes;
+    if (n <= 0) return 0;
+
+    // Com todos os canais, mpu6050_frame_t tem o mesmo layout do frame da FIFO (6 x int16); com
+    // menos, os frames chegam empacotados no começo do vetor. O DMA escreve direto no vetor de
+    // saída numa única transação e o finish desempacota e troca a ordem dos bytes
+    if (!i2c_dma_read_start(dev->i2c, dev->addr, REG_FIFO_R_W, (uint8_t *)frames, (size_t)n * frame_bytes)) {
+        return 0;
+    }
+    dev->pending_frames = frames;
+    dev->pending_count = n;
+    return n;
+}
+
+bool mpu6050_fifo_read_busy(const mpu6050_t *dev) {
+    return dev->pending_frames && i2c_dma_busy(dev->i2c);
+}
+
+int mpu6050_fifo_read_finish(mpu6050_t *dev) {
+    if (!dev->pending_frames) return 0;
+    mpu6050_frame_t *frames = dev->pending_frames;
+    int n = dev->pending_count;
+    dev->pending_frames = NULL;
+    if (i2c_dma_read_finish(dev->i2c) < 0) return -1;
+
+    // big-endian -> nativa, do último frame para o primeiro: o frame empacotado i começa em
+    // i * fifo_frame_bytes <= i * 12, então desempacotar não sobrescreve os frames ainda não lidos
+    const uint8_t *bytes = (const uint8_t *)frames;
+    const uint8_t mask = dev->channel_mask;
+    const bool accel = mask & MPU6050_CH_ACCEL;
+    for (int i = n - 1; i >= 0; i--) {
+        const uint8_t *b = bytes + i * dev->fifo_frame_bytes;
+        int16_t v[6] = {0};
+        int k = 0;
+        for (int c = 0; c < 6; c++) {
+            // A aceleração vem inteira se algum eixo foi escolhido; os outros eixos saem zerados
+            bool stored = c < 3 ? accel : (mask & (1u << c)) != 0;
+            if (!stored) continue;
+            if (mask & (1u << c)) v[c] = (int16_t)((b[k] << 8) | b[k + 1]);
+            k += 2;
+        }
+        for (int c = 0; c < 3; c++) {
+            frames[i].accel[c] = v[c];
+            frames[i].gyro[c] = v[3 + c];
+        }
+    }
+    return n;
+}
+
+int mpu6050_fifo_read(mpu6050_t *dev, mpu6050_frame_t *frames, int max_frames) {
+    int n = mpu6050_fifo_read_start(dev, frames, max_frames);
+    return n > 0 ? mpu6050_fifo_read_finish(dev) : n;
+}
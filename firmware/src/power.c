@@ -0,0 +1,122 @@
+#include "power.h"
+#include <stdio.h>
+#include "pico/stdlib.h"
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#include "hardware/clocks.h"
+#include "hardware/structs/scb.h"
+#endif
+
+// Pulsos por evento e pulsos desde o último evento (só a rotina de interrupção escreve frame_count)
+static uint32_t frames_per_wake = 1;
+static uint32_t frame_count;
+static atomic_bool sensor_ready;
+
+static void count(atomic_uint *counter, uint32_t n) {
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + n, memory_order_relaxed);
+}
+
+static void sensor_irq(unsigned int gpio, uint32_t events) {
+    (void)gpio;
+    (void)events;
+    if (++frame_count < frames_per_wake) return;
+    frame_count = 0;
+    atomic_store_explicit(&sensor_ready, true, memory_order_release);
+}
+
+// clk_sys do RP2040 em MHz (no host, o padrão de 125 MHz do Pico SDK)
+static uint32_t clk_sys_mhz(void) {
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+    return clock_get_hz(clk_sys) / 1000000u;
+#else
+    return 125;
+#endif
+}
+
+void power_init(unsigned int int_gpio, uint32_t frames_per_event) {
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+    // Clocks que continuam no sono: todos menos os periféricos que o firmware não usa
+    // (a USB, o timer, o I2C, o DMA e as SRAMs seguem ligados)
+    clocks_hw->sleep_en0 = ~(CLOCKS_SLEEP_EN0_CLK_ADC_ADC_BITS | CLOCKS_SLEEP_EN0_CLK_SYS_ADC_BITS |
+                             CLOCKS_SLEEP_EN0_CLK_SYS_JTAG_BITS | CLOCKS_SLEEP_EN0_CLK_SYS_PIO0_BITS |
+                             CLOCKS_SLEEP_EN0_CLK_SYS_PIO1_BITS | CLOCKS_SLEEP_EN0_CLK_SYS_PWM_BITS |
+                             CLOCKS_SLEEP_EN0_CLK_RTC_RTC_BITS | CLOCKS_SLEEP_EN0_CLK_SYS_RTC_BITS);
+    clocks_hw->sleep_en1 = ~(CLOCKS_SLEEP_EN1_CLK_SYS_SPI0_BITS | CLOCKS_SLEEP_EN1_CLK_PERI_SPI0_BITS |
+                             CLOCKS_SLEEP_EN1_CLK_SYS_SPI1_BITS | CLOCKS_SLEEP_EN1_CLK_PERI_SPI1_BITS |
+                             CLOCKS_SLEEP_EN1_CLK_SYS_TBMAN_BITS | CLOCKS_SLEEP_EN1_CLK_SYS_UART0_BITS |
+                             CLOCKS_SLEEP_EN1_CLK_PERI_UART0_BITS | CLOCKS_SLEEP_EN1_CLK_SYS_UART1_BITS |
+                             CLOCKS_SLEEP_EN1_CLK_PERI_UART1_BITS);
+#endif
+    frames_per_wake = frames_per_event ? frames_per_event : 1;
+    frame_count = 0;
+    atomic_init(&sensor_ready, false);
+
+    gpio_init(int_gpio);
+    gpio_set_dir(int_gpio, GPIO_IN);
+    gpio_pull_down(int_gpio);  // INT solto não gera pulsos (as tarefas caem no tempo máximo)
+    gpio_set_irq_enabled_with_callback(int_gpio, GPIO_IRQ_EDGE_RISE, true, sensor_irq);
+}
+
+bool power_sensor_pending(void) {
+    return atomic_load_explicit(&sensor_ready, memory_order_acquire);
+}
+
+void power_sensor_ack(void) {
+    atomic_store_explicit(&sensor_ready, false, memory_order_relaxed);
+}
+
+void power_sleep_until(power_meter_t *m, uint64_t until_us, bool wake_on_sensor) {
+    uint64_t start = time_us_64();
+    if (until_us <= start || (wake_on_sensor && power_sensor_pending())) return;
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+    scb_hw->scr |= M0PLUS_SCR_SLEEPDEEP_BITS;
+#endif
+    // Cada WFE volta em qualquer interrupção (USB, DMA do display...): dorme de novo até o prazo
+    // ou o sensor
+    while (!(wake_on_sensor && power_sensor_pending()) &&
+           !best_effort_wfe_or_timeout(from_us_since_boot(until_us))) {
+    }
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+    scb_hw->scr &= ~M0PLUS_SCR_SLEEPDEEP_BITS;
+#endif
+
+    count(&m->sleeps, 1);
+    if (wake_on_sensor && power_sensor_pending()) count(&m->sensor_wakeups, 1);
+    count(&m->sleep_us, (uint32_t)(time_us_64() - start));
+}
+
+void power_window_start(power_window_t *w, const power_meter_t *m) {
+    w->at_us = time_us_64();
+    w->sleep_us = atomic_load_explicit(&m->sleep_us, memory_order_relaxed);
+    w->sleeps = atomic_load_explicit(&m->sleeps, memory_order_relaxed);
+    w->sensor_wakeups = atomic_load_explicit(&m->sensor_wakeups, memory_order_relaxed);
+}
+
+void power_report(const power_meter_t *m, power_window_t *w, const char *name, uint32_t classifications) {
+    uint64_t now = time_us_64();
+    uint32_t sleep_total = atomic_load_explicit(&m->sleep_us, memory_order_relaxed);
+    uint32_t sleeps_total = atomic_load_explicit(&m->sleeps, memory_order_relaxed);
+    uint32_t wakeups_total = atomic_load_explicit(&m->sensor_wakeups, memory_order_relaxed);
+
+    // Diferenças em 32 bits: continuam certas quando os totais dão a volta
+    uint64_t elapsed = now - w->at_us;
+    uint32_t slept = sleep_total - w->sleep_us;
+    if (slept > elapsed) slept = (uint32_t)elapsed;  // a espera somada começou antes da janela
+    uint64_t active = elapsed - slept;
+
+    printf("Power %s: %.1f%% asleep, %lu sleeps, %lu sensor wakeups", name,
+           elapsed ? 100.0f * (float)slept / (float)elapsed : 0.0f, (unsigned long)(sleeps_total - w->sleeps),
+           (unsigned long)(wakeups_total - w->sensor_wakeups));
+    if (classifications) {
+        printf(" | per classification: %lu us active (%lu cycles), %lu us asleep",
+               (unsigned long)(active / classifications),
+               (unsigned long)(active * clk_sys_mhz() / classifications),
+               (unsigned long)(slept / classifications));
+    }
+    printf("\n");
+
+    w->at_us = now;
+    w->sleep_us = sleep_total;
+    w->sleeps = sleeps_total;
+    w->sensor_wakeups = wakeups_total;
+}
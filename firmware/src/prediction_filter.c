@@ -0,0 +1,74 @@
+#include "prediction_filter.h"
+#include <string.h>
+
+_Static_assert(PREDICTION_VOTE_WINDOW >= 1 && PREDICTION_VOTE_WINDOW <= 255, "PREDICTION_VOTE_WINDOW fora de 1..255");
+_Static_assert(PREDICTION_MAX_STRIDE >= 1, "PREDICTION_MAX_STRIDE precisa ser >= 1");
+
+static int argmax_f(const float *v, int n) {
+    int best = 0;
+    for (int i = 1; i < n; i++) {
+        if (v[i] > v[best]) best = i;
+    }
+    return best;
+}
+
+void prediction_filter_init(prediction_filter_t *f) {
+    memset(f, 0, sizeof(*f));
+    f->level = -1;
+    f->stride = 1;
+}
+
+// Troca o voto mais antigo pelo novo e devolve a classe com mais votos; no empate fica a atual
+static int vote(prediction_filter_t *f, int candidate) {
+    if (f->vote_fill == PREDICTION_VOTE_WINDOW) {
+        f->vote_counts[f->votes[f->vote_pos]]--;
+    } else {
+        f->vote_fill++;
+    }
+    f->votes[f->vote_pos] = (uint8_t)candidate;
+    f->vote_counts[candidate]++;
+    f->vote_pos = (f->vote_pos + 1) % PREDICTION_VOTE_WINDOW;
+
+    int winner = f->level >= 0 ? f->level : candidate;
+    for (int c = 0; c < PREDICTION_NUM_CLASSES; c++) {
+        if (f->vote_counts[c] > f->vote_counts[winner]) winner = c;
+    }
+    return winner;
+}
+
+int prediction_filter_update(prediction_filter_t *f, const float scores[PREDICTION_NUM_CLASSES]) {
+    // 1. Média móvel exponencial (a primeira previsão inicializa a média)
+    for (int c = 0; c < PREDICTION_NUM_CLASSES; c++) {
+        f->ema[c] = f->primed ? f->ema[c] + PREDICTION_EMA_ALPHA * (scores[c] - f->ema[c]) : scores[c];
+    }
+    f->primed = true;
+    int candidate = argmax_f(f->ema, PREDICTION_NUM_CLASSES);
+
+    // 2. Voto da maioria
+    int winner = vote(f, candidate);
+
+    // 3. Histerese + gate de confiança
+    if (f->level < 0) {
+        f->level = winner;
+    } else if (winner != f->level && f->ema[winner] >= PREDICTION_MIN_CONFIDENCE &&
+               f->ema[winner] >= f->ema[f->level] + PREDICTION_HYSTERESIS) {
+        f->level = winner;
+    }
+    f->confidence = f->ema[f->level];
+
+    // Duty cycle: passo maior enquanto a previsão é firme, volta a 1 na primeira dúvida
+    if (candidate == f->level && f->confidence >= PREDICTION_STABLE_CONFIDENCE) {
+        if (++f->stable_runs >= PREDICTION_STABLE_RUNS) {
+            f->stable_runs = 0;
+            f->settled = true;
+            if (f->stride < PREDICTION_MAX_STRIDE) {
+                f->stride = f->stride * 2 > PREDICTION_MAX_STRIDE ? PREDICTION_MAX_STRIDE : f->stride * 2;
+            }
+        }
+    } else {
+        f->stable_runs = 0;
+        f->stride = 1;
+        f->settled = false;
+    }
+    return f->level;
+}
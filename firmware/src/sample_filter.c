@@ -0,0 +1,68 @@
+#include "sample_filter.h"
+#include <string.h>
+
+static const int16_t biquads[SAMPLE_FILTER_SECTIONS][5] = SAMPLE_FILTER_BIQUADS;
+static const int16_t fir[SAMPLE_FILTER_TAPS] = SAMPLE_FILTER_FIR;
+
+static inline int16_t saturate16(int32_t v) {
+    return (int16_t)(v < -32768 ? -32768 : (v > 32767 ? 32767 : v));
+}
+
+void sample_filter_init(sample_filter_t *f) {
+    memset(f, 0, sizeof(*f));
+}
+
+// Entrada constante = saída constante (ganho DC 1): todo o estado recebe a primeira amostra
+static void prime(sample_filter_t *f, const int16_t in[SAMPLE_FILTER_CHANNELS]) {
+    for (int c = 0; c < SAMPLE_FILTER_CHANNELS; c++) {
+        for (int s = 0; s < SAMPLE_FILTER_SECTIONS; s++) {
+            for (int k = 0; k < 4; k++) f->iir[c][s][k] = in[c];
+        }
+        for (int t = 0; t < 2 * SAMPLE_FILTER_TAPS; t++) f->history[c][t] = in[c];
+    }
+    f->primed = true;
+}
+
+// Cascata de biquads de um canal (forma direta I)
+static int16_t biquad_cascade(int16_t state[SAMPLE_FILTER_SECTIONS][4], int16_t x) {
+    for (int s = 0; s < SAMPLE_FILTER_SECTIONS; s++) {
+        const int16_t *b = biquads[s];
+        int16_t *st = state[s];
+        // |acc| <= 32768 * soma dos |coeficientes| < 2^31 (conferido pelo gerador)
+        int32_t acc = (int32_t)b[0] * x + (int32_t)b[1] * st[0] + (int32_t)b[2] * st[1]
+                    - (int32_t)b[3] * st[2] - (int32_t)b[4] * st[3];
+        int16_t y = saturate16((acc + (1 << 13)) >> 14);
+        st[1] = st[0];
+        st[0] = x;
+        st[3] = st[2];
+        st[2] = y;
+        x = y;
+    }
+    return x;
+}
+
+bool sample_filter_push(sample_filter_t *f, const int16_t in[SAMPLE_FILTER_CHANNELS],
+                        int16_t out[SAMPLE_FILTER_CHANNELS]) {
+    if (!f->primed) prime(f, in);
+
+    for (int c = 0; c < SAMPLE_FILTER_CHANNELS; c++) {
+        int16_t y = biquad_cascade(f->iir[c], in[c]);
+        f->history[c][f->pos] = y;
+        f->history[c][f->pos + SAMPLE_FILTER_TAPS] = y;
+    }
+    // As últimas TAPS amostras ficam em history[pos + 1 .. pos + TAPS], da mais antiga para a mais nova
+    uint16_t newest = f->pos + SAMPLE_FILTER_TAPS;
+    f->pos = (uint16_t)(f->pos + 1 == SAMPLE_FILTER_TAPS ? 0 : f->pos + 1);
+
+    if (++f->phase < SAMPLE_FILTER_DECIMATION) return false;
+    f->phase = 0;
+
+    for (int c = 0; c < SAMPLE_FILTER_CHANNELS; c++) {
+        const int16_t *h = &f->history[c][newest];
+        int32_t acc = 0;
+        // fir[0] multiplica a amostra mais nova; |acc| < 2^31 (soma dos |taps| < 2^16)
+        for (int t = 0; t < SAMPLE_FILTER_TAPS; t++) acc += (int32_t)fir[t] * h[-t];
+        out[c] = saturate16((acc + (1 << 14)) >> 15);
+    }
+    return true;
+}
@@ -0,0 +1,110 @@
+#include "scheduler.h"
+#include <stdio.h>
+#include "pico/stdlib.h"
+
+static uint32_t deadline_of(const scheduler_task_t *t) {
+    return t->deadline_us ? t->deadline_us : t->period_us;
+}
+
+void scheduler_init(scheduler_t *s, scheduler_task_t *tasks, size_t count) {
+    s->tasks = tasks;
+    s->count = count;
+    s->idle = NULL;
+    uint64_t now = time_us_64();
+    for (size_t i = 0; i < count; i++) {
+        tasks[i].release_us = now + tasks[i].period_us;
+    }
+    scheduler_reset_stats(s);
+}
+
+void scheduler_step(scheduler_t *s) {
+    uint64_t now = time_us_64();
+    scheduler_task_t *next = NULL;
+    uint64_t next_deadline = UINT64_MAX;
+    uint64_t wake_us = UINT64_MAX;
+
+    for (size_t i = 0; i < s->count; i++) {
+        scheduler_task_t *t = &s->tasks[i];
+        if (t->release_us <= now || (t->ready && t->ready())) {
+            // Por evento: liberada agora (a menos que o tempo máximo sem evento já tenha vencido)
+            uint64_t release = t->release_us <= now ? t->release_us : now;
+            uint64_t deadline = release + deadline_of(t);
+            if (deadline < next_deadline) {
+                next = t;
+                next_deadline = deadline;
+            }
+        } else if (t->release_us < wake_us) {
+            wake_us = t->release_us;
+        }
+    }
+
+    if (next == NULL) {
+        if (wake_us == UINT64_MAX) return;
+        if (s->idle) {
+            s->idle(wake_us);
+        } else {
+            sleep_us(wake_us - now);
+        }
+        return;
+    }
+
+    uint64_t start = time_us_64();
+    next->run();
+    uint64_t end = time_us_64();
+
+    uint32_t elapsed = (uint32_t)(end - start);
+    next->runs++;
+    next->busy_us += elapsed;
+    if (elapsed > next->max_us) next->max_us = elapsed;
+    if (end > next_deadline) next->misses++;
+
+    if (next->ready) {
+        next->release_us = end + next->period_us;
+        return;
+    }
+
+    // Próxima liberação no mesmo ritmo; as que já passaram são puladas
+    next->release_us += next->period_us;
+    if (next->release_us + next->period_us <= end) {
+        uint64_t skipped = (end - next->release_us) / next->period_us;
+        next->release_us += skipped * next->period_us;
+        next->misses += (uint32_t)skipped;
+    }
+}
+
+void scheduler_run(scheduler_t *s) {
+    while (1) {
+        scheduler_step(s);
+    }
+}
+
+float scheduler_cpu_load(const scheduler_t *s) {
+    uint64_t elapsed = time_us_64() - s->stats_start_us;
+    if (elapsed == 0) return 0.0f;
+    uint64_t busy = 0;
+    for (size_t i = 0; i < s->count; i++) {
+        busy += s->tasks[i].busy_us;
+    }
+    return (float)busy / (float)elapsed;
+}
+
+void scheduler_print_stats(const scheduler_t *s) {
+    printf("CPU %.1f%% |", scheduler_cpu_load(s) * 100.0f);
+    for (size_t i = 0; i < s->count; i++) {
+        const scheduler_task_t *t = &s->tasks[i];
+        printf(" %s: %lu runs, %lu missed, max %lu us |", t->name, (unsigned long)t->runs,
+               (unsigned long)t->misses, (unsigned long)t->max_us);
+    }
+    printf("\n");
+}
+
+void scheduler_reset_stats(scheduler_t *s) {
+    for (size_t i = 0; i < s->count; i++) {
+        scheduler_task_t *t = &s->tasks[i];
+        t->runs = 0;
+        t->misses = 0;
+        t->max_us = 0;
+        t->busy_us = 0;
+    }
+    s->stats_start_us = time_us_64();
+}
@@ -0,0 +1,90 @@
+#include "spectral_features.h"
+#include "fft_q15.h"
+#include <math.h>
+#include <string.h>
+
+#if (SPECTRAL_FFT_SIZE & (SPECTRAL_FFT_SIZE - 1)) || SPECTRAL_FFT_SIZE < 4 || SPECTRAL_FFT_SIZE > FFT_Q15_MAX_SIZE
+#error "SPECTRAL_FFT_SIZE precisa ser potencia de 2 entre 4 e FFT_Q15_MAX_SIZE"
+#endif
+#if (SPECTRAL_FFT_SIZE / 2) % SPECTRAL_BANDS
+#error "SPECTRAL_BANDS precisa dividir SPECTRAL_FFT_SIZE / 2"
+#endif
+
+#define BINS_PER_BAND (SPECTRAL_FFT_SIZE / 2 / SPECTRAL_BANDS)
+
+static const float to_q15[SPECTRAL_AXES] = {
+    SPECTRAL_ACCEL_TO_Q15, SPECTRAL_ACCEL_TO_Q15, SPECTRAL_ACCEL_TO_Q15,
+    SPECTRAL_GYRO_TO_Q15, SPECTRAL_GYRO_TO_Q15, SPECTRAL_GYRO_TO_Q15
+};
+
+static int16_t saturate_q15(int32_t v) {
+    return (int16_t)(v < -32768 ? -32768 : (v > 32767 ? 32767 : v));
+}
+
+void spectral_features_init(spectral_features_t *s) {
+    memset(s, 0, sizeof(*s));
+}
+
+void spectral_features_push(spectral_features_t *s, const float sample[SPECTRAL_AXES]) {
+    for (int i = 0; i < SPECTRAL_AXES; i++) {
+        s->samples[i][s->head] = saturate_q15((int32_t)floorf(sample[i] * to_q15[i] + 0.5f));
+    }
+    s->head = (s->head + 1) % SPECTRAL_FFT_SIZE;
+    if (s->count < SPECTRAL_FFT_SIZE) s->count++;
+}
+
+void spectral_features_push_counts(spectral_features_t *s, const int16_t counts[SPECTRAL_AXES]) {
+    for (int i = 0; i < SPECTRAL_AXES; i++) {
+        s->samples[i][s->head] = counts[i];
+    }
+    s->head = (s->head + 1) % SPECTRAL_FFT_SIZE;
+    if (s->count < SPECTRAL_FFT_SIZE) s->count++;
+}
+
+bool spectral_features_ready(const spectral_features_t *s) {
+    return s->count == SPECTRAL_FFT_SIZE;
+}
+
+void spectral_features_compute(const spectral_features_t *s, float out[SPECTRAL_NUM_FEATURES]) {
+    int16_t frame[SPECTRAL_FFT_SIZE];
+    int32_t bins[SPECTRAL_FFT_SIZE + 2];
+
+    for (int i = 0; i < SPECTRAL_AXES; i++) {
+        // Janela em ordem de tempo (a mais antiga está em head) e média inteira
+        int32_t sum = 0;
+        for (int t = 0; t < SPECTRAL_FFT_SIZE; t++) {
+            frame[t] = s->samples[i][(s->head + t) % SPECTRAL_FFT_SIZE];
+            sum += frame[t];
+        }
+        // Divisão arredondando para baixo (igual ao // do Python)
+        int32_t mean = sum >= 0 ? sum / SPECTRAL_FFT_SIZE
+                                : -((-sum + SPECTRAL_FFT_SIZE - 1) / SPECTRAL_FFT_SIZE);
+        int32_t peak = 0;
+        for (int t = 0; t < SPECTRAL_FFT_SIZE; t++) {
+            frame[t] = saturate_q15((int32_t)frame[t] - mean);
+            int32_t mag = frame[t] < 0 ? -(int32_t)frame[t] : frame[t];
+            if (mag > peak) peak = mag;
+        }
+
+        // Ponto flutuante em bloco: a vibração usa poucas contagens e a FFT divide por 2 a cada
+        // estágio, então a janela é deslocada para a esquerda até o pico ocupar metade da escala
+        // (a outra metade é folga para as borboletas) e a energia é corrigida por 4^shift no final
+        int shift = 0;
+        while (peak && (peak << (shift + 1)) <= 16383) shift++;
+        for (int t = 0; t < SPECTRAL_FFT_SIZE; t++) {
+            frame[t] = (int16_t)(frame[t] * (1 << shift));
+        }
+
+        fft_q15_real(frame, SPECTRAL_FFT_SIZE, bins);
+
+        // Energia dos bins 1..N/2 (sem o DC): soma exata em int64, convertida para a unidade física ao quadrado
+        const float unit = 1.0f / (to_q15[i] * to_q15[i] * (float)(1u << (2 * shift)));
+        for (int b = 0; b < SPECTRAL_BANDS; b++) {
+            int64_t energy = 0;
+            for (int k = 1 + b * BINS_PER_BAND; k <= (b + 1) * BINS_PER_BAND; k++) {
+                energy += (int64_t)bins[2 * k] * bins[2 * k] + (int64_t)bins[2 * k + 1] * bins[2 * k + 1];
+            }
+            out[i * SPECTRAL_BANDS + b] = (float)energy * unit;
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#include "spsc_queue.h"
+#include <string.h>
+
+void spsc_queue_init(spsc_queue_t *q, void *storage, size_t item_size, uint32_t capacity) {
+    q->items = (uint8_t *)storage;
+    q->item_size = item_size;
+    q->capacity = capacity;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+}
+
+bool spsc_queue_push(spsc_queue_t *q, const void *item) {
+    // Índices crescem livremente (aritmética módulo 2^32); a posição é índice & (capacity - 1)
+    unsigned head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    if (head - tail == q->capacity) return false;
+
+    memcpy(q->items + (head & (q->capacity - 1)) * q->item_size, item, q->item_size);
+    // release: o consumidor só vê o novo head depois do conteúdo do item
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return true;
+}
+
+bool spsc_queue_pop(spsc_queue_t *q, void *item) {
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&q->head, memory_order_acquire);
+    if (head == tail) return false;
+
+    memcpy(item, q->items + (tail & (q->capacity - 1)) * q->item_size, q->item_size);
+    // release: o produtor só reaproveita o slot depois da cópia
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+uint32_t spsc_queue_count(spsc_queue_t *q) {
+    unsigned head = atomic_load_explicit(&q->head, memory_order_acquire);
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    return head - tail;
+}
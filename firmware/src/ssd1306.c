@@ -1,6 +1,8 @@
 #include "ssd1306.h"
 #include "font.h"
+#include "i2c_dma.h"
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include "hardware/i2c.h"
 
@@ -23,6 +25,31 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
     // Inicializa buffers
     ssd->ram_buffer[0] = 0x40; // Prefixo de dados
     ssd->port_buffer[0] = 0x00; // Prefixo de comando (Co=0, D/C=0)
+    ssd->dma_cmds = NULL;       // envio síncrono até o ssd1306_enable_dma
+    ssd->dma_active = false;
+
+    // A GDDRAM do painel tem lixo ao ligar: o primeiro envio é a tela inteira
+    ssd1306_invalidate(ssd);
+}
+
+void ssd1306_invalidate(ssd1306_t *ssd) {
+    ssd->dirty_col0 = 0;
+    ssd->dirty_col1 = ssd->width - 1;
+    ssd->dirty_page0 = 0;
+    ssd->dirty_page1 = ssd->pages - 1;
+}
+
+// Inclui o byte (coluna x, página) na região alterada
+static inline void mark_dirty(ssd1306_t *ssd, uint8_t x, uint8_t page) {
+    if (ssd->dirty_col0 > ssd->dirty_col1) {
+        ssd->dirty_col0 = ssd->dirty_col1 = x;
+        ssd->dirty_page0 = ssd->dirty_page1 = page;
+        return;
+    }
+    if (x < ssd->dirty_col0) ssd->dirty_col0 = x;
+    if (x > ssd->dirty_col1) ssd->dirty_col1 = x;
+    if (page < ssd->dirty_page0) ssd->dirty_page0 = page;
+    if (page > ssd->dirty_page1) ssd->dirty_page1 = page;
 }
 
 // Configura os parâmetros iniciais do display
@@ -56,39 +83,166 @@ void ssd1306_config(ssd1306_t *ssd) {
 
 // Envia um comando para o display via I2C
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+    ssd1306_send_wait(ssd); // a porta não aceita escrita bloqueante com o DMA ativo
     ssd->port_buffer[1] = command;
     i2c_write_blocking(ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false);
 }
 
-// Envia o buffer de dados para o display
+// Envia a região alterada do buffer para o display
+// A janela de colunas/páginas (0x21/0x22) limita a escrita ao retângulo; em endereçamento horizontal
+// o ponteiro do SSD1306 passa de uma página para a próxima sozinho. Com a largura inteira as páginas
+// são contíguas no ram_buffer e vão numa transação só; senão, uma transação por página
 void ssd1306_send_data(ssd1306_t *ssd) {
+    if (ssd->dirty_col0 > ssd->dirty_col1) return; // nada mudou
+
+    const uint8_t col0 = ssd->dirty_col0, col1 = ssd->dirty_col1;
+    const uint8_t page0 = ssd->dirty_page0, page1 = ssd->dirty_page1;
     ssd1306_command(ssd, 0x21); // Define endereço de coluna
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->width - 1);
+    ssd1306_command(ssd, col0);
+    ssd1306_command(ssd, col1);
     ssd1306_command(ssd, 0x22); // Define endereço de página
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->pages - 1);
-    i2c_write_blocking(ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false);
+    ssd1306_command(ssd, page0);
+    ssd1306_command(ssd, page1);
+
+    const bool full_width = col0 == 0 && col1 == ssd->width - 1;
+    const uint8_t run_pages = full_width ? page1 - page0 + 1 : 1;
+    const uint16_t run_len = (uint16_t)(col1 - col0 + 1) * run_pages;
+    for (uint8_t page = page0; page <= page1; page += run_pages) {
+        // O byte antes do trecho vira o prefixo de dados 0x40 durante a transação (sem cópia)
+        uint8_t *run = &ssd->ram_buffer[page * ssd->width + col0];
+        uint8_t saved = run[0];
+        run[0] = 0x40;
+        i2c_write_blocking(ssd->i2c_port, ssd->address, run, run_len + 1, false);
+        run[0] = saved;
+    }
+
+    ssd->dirty_col0 = 1;
+    ssd->dirty_col1 = 0;
+}
+
+// Escreve no byte (página, coluna x) do buffer os bits de mask com os valores de bits
+// Todas as funções de desenho passam por aqui: fora da tela é ignorado e só o que muda de fato
+// entra na região enviada pelo ssd1306_send_data
+static inline void write_byte(ssd1306_t *ssd, uint16_t page, uint16_t x, uint8_t mask, uint8_t bits) {
+    if (x >= ssd->width || page >= ssd->pages || mask == 0) return;
+    uint8_t *byte = &ssd->ram_buffer[page * ssd->width + x + 1];
+    uint8_t value = (uint8_t)((*byte & ~mask) | (bits & mask));
+    if (value != *byte) {
+        *byte = value;
+        mark_dirty(ssd, (uint8_t)x, (uint8_t)page);
+    }
+}
+
+// Preenche o retângulo [x0, x1] x [y0, y1] (inclusivo) página por página: em cada página as
+// linhas cobertas viram uma máscara de bits e cada coluna é um único read-modify-write
+static void fill_area(ssd1306_t *ssd, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, bool value) {
+    if (x1 >= ssd->width) x1 = ssd->width - 1;
+    if (y1 >= ssd->height) y1 = ssd->height - 1;
+    if (x0 > x1 || y0 > y1) return;
+    const uint8_t bits = value ? 0xFF : 0x00;
+    for (uint16_t page = y0 / 8; page <= y1 / 8; page++) {
+        uint8_t mask = 0xFF;
+        if (page == y0 / 8) mask &= (uint8_t)(0xFF << (y0 % 8));
+        if (page == y1 / 8) mask &= (uint8_t)(0xFF >> (7 - y1 % 8));
+        for (uint16_t x = x0; x <= x1; x++) write_byte(ssd, page, x, mask, bits);
+    }
+}
+
+// Copia n colunas de um glifo (bit 0 = linha y, altura até 8) para o buffer a partir de (x, y)
+// Com y fora do alinhamento de página cada coluna se divide entre duas páginas
+// opaque: apaga os pixels desligados da célula; senão só liga os pixels do glifo
+static void blit_columns(ssd1306_t *ssd, uint16_t x, uint16_t y, const uint8_t *cols, uint8_t n,
+                         uint8_t height, bool opaque) {
+    if (y >= ssd->height) return;
+    const uint16_t page = y / 8;
+    const uint8_t shift = y % 8;
+    const uint8_t rows = (uint8_t)((1u << height) - 1);
+    for (uint8_t c = 0; c < n; c++) {
+        uint16_t mask = (uint16_t)(opaque ? rows : cols[c] & rows) << shift;
+        uint16_t bits = (uint16_t)cols[c] << shift;
+        write_byte(ssd, page, x + c, (uint8_t)mask, (uint8_t)bits);
+        if (shift) write_byte(ssd, page + 1, x + c, (uint8_t)(mask >> 8), (uint8_t)(bits >> 8));
+    }
+}
+
+bool ssd1306_enable_dma(ssd1306_t *ssd) {
+    if (ssd->dma_cmds) return true;
+    // Comandos de janela (7 palavras) + prefixo de dados + a tela inteira
+    ssd->dma_cmds = calloc(ssd->bufsize + 7, sizeof(uint16_t));
+    if (ssd->dma_cmds == NULL) return false;
+    i2c_dma_init(ssd->i2c_port);
+    return true;
+}
+
+bool ssd1306_send_busy(ssd1306_t *ssd) {
+    return ssd->dma_active && i2c_dma_busy(ssd->i2c_port);
+}
+
+void ssd1306_send_wait(ssd1306_t *ssd) {
+    if (!ssd->dma_active) return;
+    ssd->dma_active = false;
+    // Sem ACK o painel pode ter ficado com parte do quadro: reenvia tudo na próxima vez
+    if (i2c_dma_write_finish(ssd->i2c_port) < 0) ssd1306_invalidate(ssd);
+}
+
+bool ssd1306_send_data_async(ssd1306_t *ssd) {
+    if (ssd->dma_cmds == NULL) {
+        ssd1306_send_data(ssd);
+        return true;
+    }
+    if (ssd1306_send_busy(ssd)) return false; // o quadro anterior ainda está no barramento
+    ssd1306_send_wait(ssd);
+    if (ssd->dirty_col0 > ssd->dirty_col1) return true; // nada mudou
+
+    // Duas transações na mesma lista: a janela de colunas/páginas (prefixo de comando 0x00) e os
+    // dados (prefixo 0x40). Aqui os dados são copiados, então a janela inteira vai numa transação só
+    const uint8_t col0 = ssd->dirty_col0, col1 = ssd->dirty_col1;
+    const uint8_t page0 = ssd->dirty_page0, page1 = ssd->dirty_page1;
+    uint16_t *cmd = ssd->dma_cmds;
+    *cmd++ = 0x00;
+    *cmd++ = 0x21; // Define endereço de coluna
+    *cmd++ = col0;
+    *cmd++ = col1;
+    *cmd++ = 0x22; // Define endereço de página
+    *cmd++ = page0;
+    *cmd++ = page1 | I2C_DMA_CMD_STOP;
+    *cmd++ = 0x40;
+    for (uint8_t page = page0; page <= page1; page++) {
+        const uint8_t *row = &ssd->ram_buffer[page * ssd->width + 1];
+        for (uint8_t col = col0; col <= col1; col++) {
+            *cmd++ = row[col];
+        }
+    }
+    cmd[-1] |= I2C_DMA_CMD_STOP;
+
+    if (!i2c_dma_write_start(ssd->i2c_port, ssd->address, ssd->dma_cmds, (size_t)(cmd - ssd->dma_cmds))) {
+        return false;
+    }
+    ssd->dma_active = true;
+    ssd->dirty_col0 = 1;
+    ssd->dirty_col1 = 0;
+    return true;
 }
 
 // Desenha um pixel no buffer
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-    if (x >= ssd->width || y >= ssd->height) return; // Verifica limites
-    uint16_t index = (y / 8) * ssd->width + x + 1;
-    uint8_t pixel = y % 8;
-    if (value) {
-        ssd->ram_buffer[index] |= (1 << pixel);
-    } else {
-        ssd->ram_buffer[index] &= ~(1 << pixel);
-    }
+    if (y >= ssd->height) return; // Verifica limites (x é verificado no write_byte)
+    write_byte(ssd, y / 8, x, (uint8_t)(1 << (y % 8)), value ? 0xFF : 0x00);
 }
 
-// Preenche a tela com pixels ligados ou desligados
+// Preenche a tela com pixels ligados ou desligados (memset por página)
 void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
+    const uint8_t bits = value ? 0xFF : 0x00;
+    for (uint8_t page = 0; page < ssd->pages; ++page) {
+        uint8_t *row = &ssd->ram_buffer[page * ssd->width + 1];
+        // Só o trecho da página que muda entra na região alterada
+        int first = 0, last = ssd->width - 1;
+        while (first <= last && row[first] == bits) first++;
+        while (last >= first && row[last] == bits) last--;
+        if (first > last) continue;
+        memset(row + first, bits, (size_t)(last - first + 1));
+        mark_dirty(ssd, (uint8_t)first, page);
+        mark_dirty(ssd, (uint8_t)last, page);
     }
 }
 
@@ -96,16 +250,15 @@ void ssd1306_fill(ssd1306_t *ssd, bool value) {
 void ssd1306_draw_small_number(ssd1306_t *ssd, char c, uint8_t x, uint8_t y) {
     if (c < '0' || c > '9') return; // Verifica se é um número válido
     uint16_t index = 568 + (c - '0') * 5; // Início dos números pequenos em font[568]
+    // A fonte guarda linhas (bit 4 = coluna 0): transpõe para colunas de 5 bits
+    uint8_t cols[5] = {0};
     for (uint8_t i = 0; i < 5; ++i) {
-        uint8_t line = font [
-
-index + i];
+        uint8_t line = font[index + i];
         for (uint8_t j = 0; j < 5; ++j) {
-            if ((line >> (4 - j)) & 0x01) {
-                ssd1306_pixel(ssd, x + j, y + i, true);
-            }
+            cols[j] |= (uint8_t)(((line >> (4 - j)) & 0x01) << i);
         }
     }
+    blit_columns(ssd, x, y, cols, 5, 5, false);
 }
 
 // Desenha um caractere
@@ -155,14 +308,20 @@ void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y, bool use_sm
         return; // Caractere não suportado
     }
 
-    // Renderiza caractere
-    for (uint8_t i = 0; i < 8; ++i) {
-        uint8_t line = font[index + i];
-        for (uint8_t j = 0; j < 8; ++j) {
-            bool pixel_value = rotate ? (line >> j) & 0x01 : (line >> j) & 0x01;
-            ssd1306_pixel(ssd, x + (rotate ? (7 - j) : i), y + (rotate ? i : j), pixel_value);
+    // Renderiza caractere: os bytes da fonte já são colunas (bit 0 = topo), como as páginas do
+    // SSD1306; os símbolos rotacionados guardam linhas e são transpostos antes
+    const uint8_t *cols = &font[index];
+    uint8_t rotated[8];
+    if (rotate) {
+        for (uint8_t col = 0; col < 8; ++col) {
+            rotated[col] = 0;
+            for (uint8_t i = 0; i < 8; ++i) {
+                rotated[col] |= (uint8_t)(((font[index + i] >> (7 - col)) & 0x01) << i);
+            }
         }
+        cols = rotated;
     }
+    blit_columns(ssd, x, y, cols, 8, 8, true);
 }
 
 // Desenha uma string
@@ -186,21 +345,16 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y,
 
 // Desenha um retângulo
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-    for (uint8_t x = left; x < left + width; ++x) {
-        ssd1306_pixel(ssd, x, top, value);
-        ssd1306_pixel(ssd, x, top + height - 1, value);
-    }
-    for (uint8_t y = top; y < top + height; ++y) {
-        ssd1306_pixel(ssd, left, y, value);
-        ssd1306_pixel(ssd, left + width - 1, y, value);
-    }
+    if (width == 0 || height == 0) return;
+    const uint16_t right = left + width - 1, bottom = top + height - 1;
     if (fill) {
-        for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-            for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-                ssd1306_pixel(ssd, x, y, value);
-            }
-        }
+        fill_area(ssd, left, top, right, bottom, value);
+        return;
     }
+    fill_area(ssd, left, top, right, top, value);
+    fill_area(ssd, left, bottom, right, bottom, value);
+    fill_area(ssd, left, top, left, bottom, value);
+    fill_area(ssd, right, top, right, bottom, value);
 }
 
 // Desenha uma linha (Bresenham)
@@ -220,14 +374,10 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0,
 
 // Desenha uma linha horizontal
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-    for (uint8_t x = x0; x <= x1; ++x) {
-        ssd1306_pixel(ssd, x, y, value);
-    }
+    fill_area(ssd, x0, y, x1, y, value);
 }
 
 // Desenha uma linha vertical
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-    for (uint8_t y = y0; y <= y1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-    }
-}
\ No newline at end of file
+    fill_area(ssd, x, y0, x, y1, value);
+}
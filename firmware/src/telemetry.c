@@ -0,0 +1,165 @@
+#include "telemetry.h"
+#include <string.h>
+#include "pico/stdlib.h"
+
+// Cabeçalho (tipo, sequência, carimbo) + carga útil + CRC, antes do COBS
+#define FRAME_HEADER_BYTES 6
+#define FRAME_RAW_MAX (FRAME_HEADER_BYTES + TELEMETRY_MAX_PAYLOAD + 2)
+// COBS de até 254 bytes acrescenta um byte; mais os dois delimitadores
+#define FRAME_WIRE_MAX (FRAME_RAW_MAX + 1 + 2)
+
+_Static_assert(FRAME_RAW_MAX < 254, "o quadro precisa caber num bloco COBS");
+
+static telemetry_level_t level = TELEMETRY_OFF;
+
+// Uma sequência por tipo: no pipeline de dois núcleos as amostras saem do core 1 e o resto do
+// core 0, então cada contador só é escrito por um core. O leitor usa os buracos para contar perdas
+static uint8_t seq[TELEMETRY_MSG_COUNT];
+
+// CRC-16/CCITT-FALSE (polinômio 0x1021, início 0xFFFF), bit a bit: os quadros são curtos
+static uint16_t crc16(const uint8_t *data, int len) {
+    uint16_t crc = 0xFFFF;
+    for (int i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// COBS: cada 0x00 vira o tamanho do trecho até o próximo zero; len < 254
+static int cobs_encode(const uint8_t *in, int len, uint8_t *out) {
+    int code_pos = 0, o = 1;
+    uint8_t code = 1;
+    for (int i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            out[code_pos] = code;
+            code_pos = o++;
+            code = 1;
+        } else {
+            out[o++] = in[i];
+            code++;
+        }
+    }
+    out[code_pos] = code;
+    return o;
+}
+
+static void put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t *p, uint32_t v) {
+    put_u16(p, (uint16_t)v);
+    put_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+// Monta o quadro em frame[FRAME_HEADER_BYTES..] já preenchido com len bytes de carga útil e envia
+static void send(telemetry_msg_t type, uint8_t *frame, int len) {
+    frame[0] = (uint8_t)type;
+    frame[1] = seq[type]++;
+    put_u32(frame + 2, time_us_32());
+    int raw_len = FRAME_HEADER_BYTES + len;
+    put_u16(frame + raw_len, crc16(frame, raw_len));
+    raw_len += 2;
+
+    uint8_t wire[FRAME_WIRE_MAX];
+    wire[0] = 0x00;
+    int n = 1 + cobs_encode(frame, raw_len, wire + 1);
+    wire[n++] = 0x00;
+
+    // Escrita única: o stdio serializa a chamada inteira entre os cores, sem tradução de \n
+    stdio_put_string((const char *)wire, n, false, false);
+}
+
+void telemetry_init(telemetry_level_t new_level, uint16_t sample_rate_hz, uint8_t num_classes, uint8_t num_motors) {
+    level = new_level;
+    if (level < TELEMETRY_STATUS) return;
+
+    uint8_t frame[FRAME_RAW_MAX];
+    uint8_t *p = frame + FRAME_HEADER_BYTES;
+    p[0] = TELEMETRY_VERSION;
+    put_u16(p + 1, sample_rate_hz);
+    p[3] = num_classes;
+    p[4] = num_motors;
+    send(TELEMETRY_MSG_HELLO, frame, 5);
+}
+
+telemetry_level_t telemetry_level(void) {
+    return level;
+}
+
+void telemetry_send_samples(uint8_t motor, const mpu6050_frame_t *frames, int n) {
+    if (level < TELEMETRY_RAW) return;
+
+    uint8_t frame[FRAME_RAW_MAX];
+    while (n > 0) {
+        int count = n < TELEMETRY_MAX_SAMPLES ? n : TELEMETRY_MAX_SAMPLES;
+        uint8_t *p = frame + FRAME_HEADER_BYTES;
+        *p++ = (uint8_t)count;
+        for (int i = 0; i < count; i++) {
+            for (int axis = 0; axis < 3; axis++, p += 2) put_u16(p, (uint16_t)frames[i].accel[axis]);
+            for (int axis = 0; axis < 3; axis++, p += 2) put_u16(p, (uint16_t)frames[i].gyro[axis]);
+        }
+        *p = motor;
+        send(TELEMETRY_MSG_SAMPLES, frame, 2 + count * MPU6050_FIFO_FRAME_BYTES);
+        frames += count;
+        n -= count;
+    }
+}
+
+void telemetry_send_prediction(uint8_t motor, int predicted, const float *scores, int num_scores, uint32_t infer_us) {
+    if (level < TELEMETRY_PREDICTIONS) return;
+
+    uint8_t frame[FRAME_RAW_MAX];
+    uint8_t *p = frame + FRAME_HEADER_BYTES;
+    const int max_scores = (TELEMETRY_MAX_PAYLOAD - 7) / 2;
+    if (num_scores > max_scores) num_scores = max_scores;
+    p[0] = (uint8_t)(int8_t)predicted;
+    put_u32(p + 1, infer_us);
+    p[5] = (uint8_t)num_scores;
+    for (int i = 0; i < num_scores; i++) {
+        // Q16 sem sinal em vez de float: o decodificador divide por 65535
+        float s = scores[i];
+        uint16_t q = s <= 0.0f ? 0 : s >= 1.0f ? 65535 : (uint16_t)(s * 65535.0f + 0.5f);
+        put_u16(p + 6 + 2 * i, q);
+    }
+    p[6 + 2 * num_scores] = motor;
+    send(TELEMETRY_MSG_PREDICTION, frame, 7 + 2 * num_scores);
+}
+
+void telemetry_send_status(const scheduler_t *s, uint32_t dropped) {
+    if (level < TELEMETRY_STATUS) return;
+
+    uint8_t frame[FRAME_RAW_MAX];
+    uint8_t *payload = frame + FRAME_HEADER_BYTES;
+
+    // Carga em centésimos de porcento sem passar por float (busy_us * 10000 / decorrido)
+    uint64_t elapsed = time_us_64() - s->stats_start_us;
+    uint64_t busy = 0;
+    for (size_t i = 0; i < s->count; i++) busy += s->tasks[i].busy_us;
+    uint64_t load = elapsed ? busy * 10000u / elapsed : 0;
+    put_u16(payload, load > 10000u ? 10000u : (uint16_t)load);
+    put_u32(payload + 2, dropped);
+
+    // O nome vai junto: o leitor pode se conectar depois do HELLO e a ordem muda com o build
+    uint8_t *p = payload + 7;
+    uint8_t count = 0;
+    for (size_t i = 0; i < s->count; i++) {
+        const scheduler_task_t *t = &s->tasks[i];
+        size_t name_len = strlen(t->name);
+        if (name_len > TELEMETRY_MAX_TASK_NAME) name_len = TELEMETRY_MAX_TASK_NAME;
+        if (p + 9 + name_len > payload + TELEMETRY_MAX_PAYLOAD) break;
+        put_u16(p, t->runs > 0xFFFF ? 0xFFFF : (uint16_t)t->runs);
+        put_u16(p + 2, t->misses > 0xFFFF ? 0xFFFF : (uint16_t)t->misses);
+        put_u32(p + 4, t->max_us);
+        p[8] = (uint8_t)name_len;
+        memcpy(p + 9, t->name, name_len);
+        p += 9 + name_len;
+        count++;
+    }
+    payload[6] = count;
+    send(TELEMETRY_MSG_STATUS, frame, (int)(p - payload));
+}
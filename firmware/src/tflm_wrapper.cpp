@@ -1,98 +1,437 @@
 #include <cstdio>
+#include <math.h>
+#include <new>
 #include "pico/stdlib.h"
 
 //bibliotecas do tflite micro
+#include "tensorflow/lite/micro/micro_allocator.h"
 #include "tensorflow/lite/micro/micro_interpreter.h"
 #include "tensorflow/lite/micro/micro_log.h"
 #include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
 #include "tensorflow/lite/schema/schema_generated.h"
 
 //arquivos gerados pelo notebook
+//com MOTOR_MODEL_INT8 usa o modelo quantizado inteiro (entrada/saida int8)
+#if defined(MOTOR_WINDOW_FEATURES)
+#include "motor_window_model.h"
+#define MOTOR_MODEL_DATA motor_window_model
+#elif defined(MOTOR_CHANNEL_MODEL)
+#include "motor_channel_model.h"
+#define MOTOR_MODEL_DATA motor_channel_model
+#elif defined(MOTOR_MODEL_INT8)
+#include "motor_model_int8.h"
+#define MOTOR_MODEL_DATA motor_model_int8
+#else
 #include "motor_model.h"
-#include "scaler_params.h" 
+#define MOTOR_MODEL_DATA motor_model
+#endif
 #include "tflm_wrapper.h" //header da api
+#ifndef MOTOR_WINDOW_FEATURES
+#include "mpu6050.h" //escalas em ponto fixo do tflm_infer_frame
+#ifndef MOTOR_SENSOR_CHANNELS
+#define MOTOR_SENSOR_CHANNELS MPU6050_CH_ALL
+#endif
+#endif
+
+//o modelo de canais tem que ter sido treinado com os canais que o firmware le
+#if defined(MOTOR_CHANNEL_MODEL) && MOTOR_MODEL_CHANNELS != MOTOR_SENSOR_CHANNELS
+#error "motor_channel_model.h foi treinado com outros canais (MOTOR_MODEL_CHANNELS)"
+#endif
+
+//o modelo de janelas tem que ter sido treinado com as mesmas janelas do firmware
+#ifdef MOTOR_WINDOW_FEATURES
+#if MOTOR_MODEL_WINDOW_SIZE != WINDOW_SIZE
+#error "motor_window_model.h foi treinado com outro WINDOW_SIZE (window_features.h)"
+#endif
+#if defined(MOTOR_SPECTRAL_FEATURES) != defined(MOTOR_MODEL_FFT_SIZE)
+#error "motor_window_model.h e MOTOR_SPECTRAL_FEATURES discordam (modelo com/sem bandas de frequencia)"
+#endif
+#if defined(MOTOR_SPECTRAL_FEATURES) && (MOTOR_MODEL_FFT_SIZE != SPECTRAL_FFT_SIZE || MOTOR_MODEL_SPECTRAL_BANDS != SPECTRAL_BANDS)
+#error "motor_window_model.h foi treinado com outro SPECTRAL_FFT_SIZE/SPECTRAL_BANDS (spectral_features.h)"
+#endif
+#endif
+
+//com o scaler embutido na hidden1 (MOTOR_MODEL_SCALER_FOLDED, tools/fold_scaler.py)
+//o modelo recebe as features brutas e o scaler_params.h nao e usado
+#ifndef MOTOR_MODEL_SCALER_FOLDED
+#ifdef MOTOR_WINDOW_FEATURES
+#error "motor_window_model.h precisa ser exportado com o scaler embutido (MOTOR_MODEL_SCALER_FOLDED)"
+#endif
+#ifdef MOTOR_CHANNEL_MODEL
+#error "motor_channel_model.h precisa ser exportado com o scaler embutido (MOTOR_MODEL_SCALER_FOLDED)"
+#endif
+#include "scaler_params.h"
+static_assert(sizeof(scaler_mean) / sizeof(scaler_mean[0]) == TFLM_NUM_FEATURES,
+              "scaler_params.h tem outro numero de features (TFLM_NUM_FEATURES)");
+#endif
 
 //area de memoria pro tflite, se der erro de alloc tem que aumentar aqui
+//(dividida por todos os modelos registrados: cada extra soma so os buffers persistentes dele)
 constexpr int kTensorArenaSize = 10 * 1024; 
 alignas(16) static uint8_t tensor_arena[kTensorArenaSize];
 
-static const tflite::Model* model = nullptr;
+//modelos registrados: o do motor no handle TFLM_MAIN_MODEL e os de tflm_register_model
+struct registered_model {
+    const unsigned char* data;
+    int num_inputs;
+    int num_outputs;
+    int batch_capacity; //amostras por Invoke (primeira dimensao da entrada)
+    unsigned int arena_bytes; //bytes que o AllocateTensors do modelo somou na arena
+    tflite::MicroInterpreter* interpreter;
+    TfLiteTensor* input;
+    TfLiteTensor* output;
+};
+static registered_model models[TFLM_MAX_MODELS];
+static int model_count = 1; //o handle 0 fica reservado pro modelo do motor
+
+//um alocador pra arena inteira e o espaco dos interpretadores (construidos no init, sem heap)
+static tflite::MicroAllocator* allocator = nullptr;
+alignas(tflite::MicroInterpreter) static uint8_t interpreter_storage[TFLM_MAX_MODELS][sizeof(tflite::MicroInterpreter)];
+
+//atalhos pro modelo do motor, usados pelo tflm_infer/tflm_infer_frame/tflm_infer_batch
 static tflite::MicroInterpreter* interpreter = nullptr;
 static TfLiteTensor* input_tensor = nullptr;
 static TfLiteTensor* output_tensor = nullptr;
+static tflite::MicroProfilerInterface* profiler = nullptr;
+
+//modelo int8: quantizacao da entrada com o scaler embutido, q = x * input_mult + input_offset
+//(calculado uma vez no init a partir dos parametros do tensor, sem divisao no infer)
+static float input_mult[TFLM_NUM_FEATURES];
+static float input_offset[TFLM_NUM_FEATURES];
+
+#ifndef MOTOR_WINDOW_FEATURES
+//contagem do MPU6050 -> unidade das features (m/s² e °/s), pelas mesmas escalas do mpu6050_frame_to_fixed
+constexpr float kAccelPerLsb = (float)MPU6050_ACCEL_MMS2_MULT / (1000.0f * (1 << MPU6050_ACCEL_MMS2_SHIFT));
+constexpr float kGyroPerLsb = (float)MPU6050_GYRO_MDPS_MULT / (1000.0f * (1 << MPU6050_GYRO_MDPS_SHIFT));
+
+//modelo int8: a mesma quantizacao direto das contagens, q = (contagem * frame_mult + frame_offset) >> 16
+//(Q16, com a escala do sensor e o +0.5 do arredondamento embutidos; so inteiros no tflm_infer_frame)
+static int32_t frame_mult[TFLM_NUM_FEATURES];
+static int32_t frame_offset[TFLM_NUM_FEATURES];
+//false se algum canal estouraria o int32 (|contagem| <= 32768): o tflm_infer_frame passa pelo float
+static bool frame_fixed;
+
+//unidade fisica por contagem de cada entrada (canais de MOTOR_SENSOR_CHANNELS, na ordem Acel_X..Giro_Z)
+static float input_per_lsb(int i) {
+    return mpu6050_channel_index(MOTOR_SENSOR_CHANNELS, i) < 3 ? kAccelPerLsb : kGyroPerLsb;
+}
+#endif
+
+//amostras por Invoke: 1 no modelo do notebook, MOTOR_MODEL_BATCH no exportado com tools/batch_model.py
+static int batch_capacity = 1;
 
 //resolver pra carregar as operacoes usadas no modelo
 //se mudar a arquitetura no python tem que atualizar aqui o numero de ops
 static tflite::MicroMutableOpResolver<4> resolver;
 
-int tflm_init_model(void) {
-    //carrega o modelo do array de bytes
-    model = tflite::GetModel(motor_model);
+tflm_model_handle tflm_register_model(const unsigned char* data, int num_inputs, int num_outputs) {
+    //depois do init o planejamento da arena ja foi feito
+    if (allocator || !data || num_inputs <= 0 || num_outputs <= 0) return -1;
+    if (model_count >= TFLM_MAX_MODELS) {
+        MicroPrintf("Erro: registro de modelos cheio (TFLM_MAX_MODELS)");
+        return -1;
+    }
+    registered_model& m = models[model_count];
+    m.data = data;
+    m.num_inputs = num_inputs;
+    m.num_outputs = num_outputs;
+    return model_count++;
+}
+
+//o tensor comporta rows linhas de cols elementos do tipo dele (so float ou int8)?
+static bool tensor_fits(const TfLiteTensor* t, int rows, int cols) {
+    size_t elem = t->type == kTfLiteInt8 ? sizeof(int8_t) : (t->type == kTfLiteFloat32 ? sizeof(float) : 0);
+    return elem != 0 && t->bytes >= (size_t)rows * (size_t)cols * elem;
+}
+
+//cria o interpretador do modelo h sobre o alocador compartilhado e aloca os tensores dele
+//os modelos sao alocados em ordem e antes de qualquer Invoke: o trecho das ativacoes cresce ate
+//o do maior modelo e nao muda mais
+static int init_model(tflm_model_handle h) {
+    registered_model& m = models[h];
+    const tflite::Model* model = tflite::GetModel(m.data);
     if (model == nullptr) {
-        MicroPrintf("Erro: model ta nulo");
+        MicroPrintf("Erro: model %d ta nulo", h);
         return -1;
     }
 
-    //registrando ops necessarias (dense, relu, softmax, reshape)
+    size_t before = allocator->used_bytes();
+    m.interpreter = new (interpreter_storage[h]) tflite::MicroInterpreter(model, resolver, allocator, nullptr, profiler);
+    if (m.interpreter->AllocateTensors() != kTfLiteOk) {
+        MicroPrintf("Erro no AllocateTensors do modelo %d, checar kTensorArenaSize", h);
+        return -2;
+    }
+
+    m.input = m.interpreter->input(0);
+    m.output = m.interpreter->output(0);
+
+    //validacao basica
+    if (!m.input || !m.output) {
+        MicroPrintf("Nao conseguiu pegar tensores de in/out do modelo %d", h);
+        return -3;
+    }
+
+    //primeira dimensao do tensor de entrada ([batch, features]) define quantas amostras cabem por Invoke
+    m.batch_capacity = 1;
+    if (m.input->dims->size == 2 && m.input->dims->data[1] == m.num_inputs) {
+        m.batch_capacity = m.input->dims->data[0];
+    }
+
+    //as copias de entrada/saida escrevem batch_capacity * num_inputs/num_outputs elementos: um modelo
+    //registrado com mais entradas/saidas do que os tensores tem passaria do fim deles
+    if (!tensor_fits(m.input, m.batch_capacity, m.num_inputs) ||
+        !tensor_fits(m.output, m.batch_capacity, m.num_outputs)) {
+        MicroPrintf("Erro: tensores do modelo %d nao comportam %d x %d entradas e %d saidas (float ou int8)", h,
+                    m.batch_capacity, m.num_inputs, m.num_outputs);
+        return -4;
+    }
+
+    m.arena_bytes = (unsigned int)(allocator->used_bytes() - before);
+    MicroPrintf("TFLM modelo %d: +%u bytes de arena", h, m.arena_bytes);
+    return 0;
+}
+
+int tflm_init_model(void) {
+    //registrando ops necessarias (dense, relu, softmax, reshape), as mesmas pra todos os modelos
     resolver.AddFullyConnected();
     resolver.AddRelu();
     resolver.AddSoftmax();
     resolver.AddReshape(); 
 
-    //instancia o interpretador estatico
-    static tflite::MicroInterpreter static_interpreter(
-        model, resolver, tensor_arena, kTensorArenaSize
-    );
-    interpreter = &static_interpreter;
-
-    //aloca memoria pros tensores
-    if (interpreter->AllocateTensors() != kTfLiteOk) {
-        MicroPrintf("Erro no AllocateTensors, checar kTensorArenaSize");
+    //um alocador so: todos os interpretadores dividem a mesma arena
+    allocator = tflite::MicroAllocator::Create(tensor_arena, kTensorArenaSize);
+    if (allocator == nullptr) {
+        MicroPrintf("Erro ao criar o MicroAllocator, checar kTensorArenaSize");
         return -2;
     }
 
-    input_tensor = interpreter->input(0);
-    output_tensor = interpreter->output(0);
+    //modelo do motor primeiro, depois os extras na ordem do registro
+    models[TFLM_MAIN_MODEL].data = MOTOR_MODEL_DATA;
+    models[TFLM_MAIN_MODEL].num_inputs = TFLM_NUM_FEATURES;
+    models[TFLM_MAIN_MODEL].num_outputs = 4;
+    for (int h = 0; h < model_count; h++) {
+        int ret = init_model(h);
+        if (ret != 0) return ret;
+    }
 
-    //validacao basica
-    if (!input_tensor || !output_tensor) {
-        MicroPrintf("Nao conseguiu pegar tensores de in/out");
-        return -3;
+    interpreter = models[TFLM_MAIN_MODEL].interpreter;
+    input_tensor = models[TFLM_MAIN_MODEL].input;
+    output_tensor = models[TFLM_MAIN_MODEL].output;
+    batch_capacity = models[TFLM_MAIN_MODEL].batch_capacity;
+
+    //pre-calcula a quantizacao da entrada: ((x - media) / desvio) / escala + zero_point
+    if (input_tensor->type == kTfLiteInt8) {
+        const float in_scale = input_tensor->params.scale;
+        const float in_zero_point = (float)input_tensor->params.zero_point;
+        for (int i = 0; i < TFLM_NUM_FEATURES; i++) {
+#ifdef MOTOR_MODEL_SCALER_FOLDED
+            input_mult[i] = 1.0f / in_scale;
+            input_offset[i] = in_zero_point;
+#else
+            input_mult[i] = 1.0f / (scaler_scale[i] * in_scale);
+            input_offset[i] = in_zero_point - scaler_mean[i] * input_mult[i];
+#endif
+        }
+#ifndef MOTOR_WINDOW_FEATURES
+        frame_fixed = true;
+        for (int i = 0; i < TFLM_NUM_FEATURES; i++) {
+            const float mult = floorf(input_mult[i] * input_per_lsb(i) * 65536.0f + 0.5f);
+            const float offset = floorf((input_offset[i] + 0.5f) * 65536.0f + 0.5f);
+            //contagem * frame_mult + frame_offset precisa caber no int32 pra qualquer contagem
+            if (32768.0 * fabsf(mult) + fabsf(offset) >= 2147483648.0) {
+                MicroPrintf("Entrada %d: escala int8 grande demais pro Q16, tflm_infer_frame usa o caminho float", i);
+                frame_fixed = false;
+                break;
+            }
+            frame_mult[i] = (int32_t)mult;
+            frame_offset[i] = (int32_t)offset;
+        }
+#endif
     }
 
-    MicroPrintf("TFLM iniciado. In dims: %d, Out dims: %d", input_tensor->dims->size, output_tensor->dims->size);
+    MicroPrintf("TFLM iniciado. In dims: %d, Out dims: %d, batch: %d, modelos: %d", input_tensor->dims->size,
+                output_tensor->dims->size, batch_capacity, model_count);
     return 0;
 }
 
-int tflm_infer(const float in_features[6], float out_scores[4]) {
+void tflm_set_profiler(tflite::MicroProfilerInterface* p) {
+    profiler = p;
+}
+
+unsigned int tflm_arena_used_bytes(void) {
+    if (!interpreter) return 0;
+    return interpreter->arena_used_bytes();
+}
+
+unsigned int tflm_model_arena_bytes(tflm_model_handle h) {
+    if (h < 0 || h >= model_count || !models[h].interpreter) return 0;
+    return models[h].arena_bytes;
+}
+
+//copia uma amostra pra linha `row` do tensor de entrada (normalizando ou quantizando)
+static void load_input(int row, const float in_features[TFLM_NUM_FEATURES]) {
+    if (input_tensor->type == kTfLiteInt8) {
+        //quantiza direto das features brutas (normalizacao embutida)
+        int8_t* dst = input_tensor->data.int8 + row * TFLM_NUM_FEATURES;
+        for (int i = 0; i < TFLM_NUM_FEATURES; i++) {
+            int32_t q = (int32_t)floorf(in_features[i] * input_mult[i] + input_offset[i] + 0.5f);
+            dst[i] = (int8_t)(q < -128 ? -128 : (q > 127 ? 127 : q));
+        }
+    } else {
+        float* dst = input_tensor->data.f + row * TFLM_NUM_FEATURES;
+#ifdef MOTOR_MODEL_SCALER_FOLDED
+        //scaler embutido nos pesos: as features brutas vao direto pro tensor
+        for (int i = 0; i < TFLM_NUM_FEATURES; i++) {
+            dst[i] = in_features[i];
+        }
+#else
+        //aplica a normalizacao (standard scaler) igual foi feito no python
+        //formula: (valor - media) / desvio
+        for (int i = 0; i < TFLM_NUM_FEATURES; i++) {
+            dst[i] = (in_features[i] - scaler_mean[i]) / scaler_scale[i];
+        }
+
+        //debug pra ver se a normalizacao ta batendo
+        //MicroPrintf("Input norm: %.2f %.2f %.2f...", dst[0], dst[1], dst[2]);
+#endif
+    }
+}
+
+//pega o resultado da linha `row` (probabilidades das 4 classes)
+static void store_output(int row, float out_scores[4]) {
+    if (output_tensor->type == kTfLiteInt8) {
+        const float out_scale = output_tensor->params.scale;
+        const int32_t out_zero_point = output_tensor->params.zero_point;
+        const int8_t* src = output_tensor->data.int8 + row * 4;
+        for (int i = 0; i < 4; i++) {
+            out_scores[i] = (float)(src[i] - out_zero_point) * out_scale;
+        }
+    } else {
+        const float* src = output_tensor->data.f + row * 4;
+        for (int i = 0; i < 4; i++) {
+            out_scores[i] = src[i];
+        }
+    }
+}
+
+int tflm_infer_batch(const float* in, float* out, int n) {
     if (!interpreter) return -1; //seguranca
+    if (n < 0 || (n > 0 && (!in || !out))) return -3;
+
+    //preenche ate batch_capacity linhas por Invoke; no ultimo bloco as linhas
+    //que sobram ficam com os dados anteriores e o resultado delas e ignorado
+    for (int done = 0; done < n; done += batch_capacity) {
+        int rows = n - done < batch_capacity ? n - done : batch_capacity;
+        for (int r = 0; r < rows; r++) {
+            load_input(r, in + (done + r) * TFLM_NUM_FEATURES);
+        }
+
+        //roda a inferencia
+        if (interpreter->Invoke() != kTfLiteOk) {
+            MicroPrintf("Erro ao rodar Invoke");
+            return -2;
+        }
 
-    float normalized[6];
-    
-    //aplica a normalizacao (standard scaler) igual foi feito no python
-    //formula: (valor - media) / desvio
-    for (int i = 0; i < 6; i++) {
-        normalized[i] = (in_features[i] - scaler_mean[i]) / scaler_scale[i];
+        for (int r = 0; r < rows; r++) {
+            store_output(r, out + (done + r) * 4);
+        }
     }
 
-    //debug pra ver se a normalizacao ta batendo
-    //MicroPrintf("Input norm: %.2f %.2f %.2f...", normalized[0], normalized[1], normalized[2]);
+    return 0;
+}
 
-    //copia pro tensor de entrada
-    for (int i = 0; i < 6; i++) {
-        input_tensor->data.f[i] = normalized[i];
+int tflm_infer(const float in_features[TFLM_NUM_FEATURES], float out_scores[4]) {
+    return tflm_infer_batch(in_features, out_scores, 1);
+}
+
+#ifndef MOTOR_WINDOW_FEATURES
+int tflm_infer_frame(const int16_t accel[3], const int16_t gyro[3], float out_scores[4]) {
+    if (!interpreter) return -1; //seguranca
+
+    //so os canais que entram no modelo (todos sem MOTOR_CHANNEL_MODEL)
+    int16_t raw[TFLM_NUM_FEATURES];
+    mpu6050_gather_channels(MOTOR_SENSOR_CHANNELS, accel, gyro, raw);
+    if (input_tensor->type == kTfLiteInt8 && frame_fixed) {
+        //quantiza direto das contagens, sem ponto flutuante
+        int8_t* dst = input_tensor->data.int8;
+        for (int i = 0; i < TFLM_NUM_FEATURES; i++) {
+            int32_t q = (raw[i] * frame_mult[i] + frame_offset[i]) >> 16;
+            dst[i] = (int8_t)(q < -128 ? -128 : (q > 127 ? 127 : q));
+        }
+    } else {
+        //modelo float (ou Q16 fora do int32): as contagens viram unidades fisicas e seguem o caminho do tflm_infer
+        float in_features[TFLM_NUM_FEATURES];
+        for (int i = 0; i < TFLM_NUM_FEATURES; i++) {
+            in_features[i] = raw[i] * input_per_lsb(i);
+        }
+        load_input(0, in_features);
     }
 
-    //roda a inferencia
     if (interpreter->Invoke() != kTfLiteOk) {
         MicroPrintf("Erro ao rodar Invoke");
         return -2;
     }
+    store_output(0, out_scores);
+    return 0;
+}
+#endif
 
-    //pega o resultado (probabilidades das 4 classes)
-    for (int i = 0; i < 4; i++) {
-        out_scores[i] = output_tensor->data.f[i];
+//modelos extras: entrada float copiada ou quantizada pela escala do tensor (scaler embutido nos pesos)
+static void load_model_input(const registered_model& m, int row, const float* in) {
+    if (m.input->type == kTfLiteInt8) {
+        const float inv_scale = 1.0f / m.input->params.scale;
+        const float zero_point = (float)m.input->params.zero_point;
+        int8_t* dst = m.input->data.int8 + row * m.num_inputs;
+        for (int i = 0; i < m.num_inputs; i++) {
+            int32_t q = (int32_t)floorf(in[i] * inv_scale + zero_point + 0.5f);
+            dst[i] = (int8_t)(q < -128 ? -128 : (q > 127 ? 127 : q));
+        }
+    } else {
+        float* dst = m.input->data.f + row * m.num_inputs;
+        for (int i = 0; i < m.num_inputs; i++) {
+            dst[i] = in[i];
+        }
     }
+}
 
+static void store_model_output(const registered_model& m, int row, float* out) {
+    if (m.output->type == kTfLiteInt8) {
+        const float out_scale = m.output->params.scale;
+        const int32_t out_zero_point = m.output->params.zero_point;
+        const int8_t* src = m.output->data.int8 + row * m.num_outputs;
+        for (int i = 0; i < m.num_outputs; i++) {
+            out[i] = (float)(src[i] - out_zero_point) * out_scale;
+        }
+    } else {
+        const float* src = m.output->data.f + row * m.num_outputs;
+        for (int i = 0; i < m.num_outputs; i++) {
+            out[i] = src[i];
+        }
+    }
+}
+
+int tflm_model_infer(tflm_model_handle h, const float* in, float* out, int n) {
+    if (h == TFLM_MAIN_MODEL) return tflm_infer_batch(in, out, n);
+    if (h < 0 || h >= model_count || !models[h].interpreter) return -1; //seguranca
+    if (n < 0 || (n > 0 && (!in || !out))) return -3;
+
+    //entrada e saida copiadas na mesma chamada: as ativacoes (e os tensores de in/out) sao
+    //compartilhadas com os outros modelos e o proximo Invoke de qualquer um sobrescreve
+    const registered_model& m = models[h];
+    for (int done = 0; done < n; done += m.batch_capacity) {
+        int rows = n - done < m.batch_capacity ? n - done : m.batch_capacity;
+        for (int r = 0; r < rows; r++) {
+            load_model_input(m, r, in + (done + r) * m.num_inputs);
+        }
+
+        if (m.interpreter->Invoke() != kTfLiteOk) {
+            MicroPrintf("Erro ao rodar Invoke do modelo %d", h);
+            return -2;
+        }
+
+        for (int r = 0; r < rows; r++) {
+            store_model_output(m, r, out + (done + r) * m.num_outputs);
+        }
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,104 @@
+#include "window_features.h"
+#include <math.h>
+#include <string.h>
+
+// Converte para milésimos com arredondamento (os CSVs têm 3 casas decimais)
+static int32_t to_fixed(float x) {
+    return (int32_t)floorf(x * (float)WINDOW_FIXED_SCALE + 0.5f);
+}
+
+/**
+ * @brief Insere uma amostra num eixo.
+ * @param pos posição do ring onde a amostra entra (a da mais antiga quando a janela está cheia)
+ * @param count amostras na janela antes da inserção
+ */
+static void axis_push(window_axis_t *a, uint8_t pos, uint8_t count, int32_t x) {
+    // Lado da média da janela atual (antes da troca): x >= sum / count, em inteiros x * count >= sum
+    bool above = count == 0 || (int64_t)x * count >= a->sum;
+
+    if (count == WINDOW_SIZE) {
+        // Remove a amostra mais antiga das somas e dos deques
+        int32_t old = a->values[pos];
+        a->sum -= old;
+        a->sum_sq -= (int64_t)old * old;
+        a->crossings -= a->crossed[pos];
+        if (a->max_len && a->max_q[a->max_head] == pos) {
+            a->max_head = (a->max_head + 1) % WINDOW_SIZE;
+            a->max_len--;
+        }
+        if (a->min_len && a->min_q[a->min_head] == pos) {
+            a->min_head = (a->min_head + 1) % WINDOW_SIZE;
+            a->min_len--;
+        }
+    }
+
+    a->crossed[pos] = (count > 0 && above != a->above) ? 1 : 0;
+    a->crossings += a->crossed[pos];
+    a->above = above;
+
+    a->values[pos] = x;
+    a->sum += x;
+    a->sum_sq += (int64_t)x * x;
+
+    // Deques monotônicos: cada posição entra e sai uma vez (O(1) amortizado)
+    while (a->max_len && a->values[a->max_q[(a->max_head + a->max_len - 1) % WINDOW_SIZE]] <= x) {
+        a->max_len--;
+    }
+    a->max_q[(a->max_head + a->max_len) % WINDOW_SIZE] = pos;
+    a->max_len++;
+
+    while (a->min_len && a->values[a->min_q[(a->min_head + a->min_len - 1) % WINDOW_SIZE]] >= x) {
+        a->min_len--;
+    }
+    a->min_q[(a->min_head + a->min_len) % WINDOW_SIZE] = pos;
+    a->min_len++;
+}
+
+void window_features_init(window_features_t *w) {
+    memset(w, 0, sizeof(*w));
+}
+
+void window_features_push(window_features_t *w, const float sample[WINDOW_AXES]) {
+    int32_t fixed[WINDOW_AXES];
+    for (int i = 0; i < WINDOW_AXES; i++) fixed[i] = to_fixed(sample[i]);
+    window_features_push_fixed(w, fixed);
+}
+
+void window_features_push_fixed(window_features_t *w, const int32_t sample[WINDOW_AXES]) {
+    for (int i = 0; i < WINDOW_AXES; i++) {
+        axis_push(&w->axis[i], w->head, w->count, sample[i]);
+    }
+    w->head = (w->head + 1) % WINDOW_SIZE;
+    if (w->count < WINDOW_SIZE) w->count++;
+}
+
+bool window_features_ready(const window_features_t *w) {
+    return w->count == WINDOW_SIZE;
+}
+
+void window_features_compute(const window_features_t *w, float out[WINDOW_NUM_FEATURES]) {
+    const int n = w->count;
+    if (n == 0) {
+        memset(out, 0, WINDOW_NUM_FEATURES * sizeof(float));
+        return;
+    }
+
+    // A amostra mais antiga não tem a anterior dentro da janela: o cruzamento dela não conta
+    const uint8_t oldest = n == WINDOW_SIZE ? w->head : 0;
+    const float scale = (float)WINDOW_FIXED_SCALE;
+
+    for (int i = 0; i < WINDOW_AXES; i++) {
+        const window_axis_t *a = &w->axis[i];
+        float *f = out + i * WINDOW_STATS;
+
+        // n * soma(x^2) - soma(x)^2 é exato em int64, só a divisão final é em float
+        int64_t spread = (int64_t)n * a->sum_sq - a->sum * a->sum;
+        int32_t p2p = a->values[a->max_q[a->max_head]] - a->values[a->min_q[a->min_head]];
+        int crossings = a->crossings - a->crossed[oldest];
+
+        f[0] = sqrtf((float)a->sum_sq / (float)n) / scale;
+        f[1] = (float)p2p / scale;
+        f[2] = (float)spread / ((float)n * (float)n) / (scale * scale);
+        f[3] = n > 1 ? (float)crossings / (float)(n - 1) : 0.0f;
+    }
+}
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""Exporta o modelo TFLite com uma dimensao de batch fixa para o tflm_infer_batch.
+
+O conversor gera os tensores de ativacao com shape [1, N] (shape_signature
+[-1, N]); os pesos das camadas densas nao dependem do batch. Aqui a primeira
+dimensao de cada tensor com batch dinamico e reescrita no proprio flatbuffer
+(mesmo tamanho), entao um Invoke do MicroInterpreter classifica --batch
+amostras de uma vez. O header gerado e o de entrada com o array trocado e
+#define MOTOR_MODEL_BATCH.
+
+Uso:
+    python3 tools/batch_model.py firmware/libs/motor_model.h --batch 8 -o build/motor_model.h
+"""
+import argparse
+import re
+import struct
+import sys
+
+from dense_export import FlatBuffer, load_model_bytes, parse_dense_model
+from fold_scaler import c_array
+
+
+def set_batch(data, batch):
+    """Devolve (bytes com o batch reescrito, numero de tensores alterados)."""
+    fb = FlatBuffer(data)
+    model = fb.indirect(0)
+    subgraph = fb.tables(fb.field(model, 2))[0]
+
+    out = bytearray(data)
+    changed = 0
+    for tensor in fb.tables(fb.field(subgraph, 0)):
+        shape_field = fb.field(tensor, 0)
+        signature_field = fb.field(tensor, 7)
+        if shape_field is None or signature_field is None:
+            continue  # constantes (pesos/bias) nao tem shape_signature
+        signature = fb.ints(signature_field)
+        if not signature or signature[0] != -1:
+            continue
+        start, _ = fb.vector(shape_field)
+        struct.pack_into('<i', out, start, batch)
+        changed += 1
+
+    if not changed:
+        raise ValueError('nenhum tensor com batch dinamico (shape_signature [-1, ...])')
+    parse_dense_model(bytes(out))  # continua sendo um modelo que o motor denso entende
+    return bytes(out), changed
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('header', help='motor_model.h ou motor_model_int8.h exportado pelo notebook')
+    parser.add_argument('--batch', type=int, required=True, help='amostras por Invoke')
+    parser.add_argument('-o', '--output', required=True, help='header gerado')
+    args = parser.parse_args(argv)
+
+    if args.batch < 1:
+        parser.error('--batch precisa ser >= 1')
+
+    with open(args.header) as f:
+        text = f.read()
+    if 'MOTOR_MODEL_BATCH' in text:
+        parser.error('%s ja foi exportado com batch fixo' % args.header)
+
+    var_name = re.search(r'const unsigned char (\w+)\[\]', text).group(1)
+    data, changed = set_batch(load_model_bytes(args.header), args.batch)
+
+    # Troca o array (e o _len) pelo modelo com batch e marca o header
+    start = text.index('const unsigned char %s[]' % var_name)
+    end = text.index('\n', text.index('const unsigned int %s_len' % var_name)) + 1
+    text = text[:start] + c_array(data, var_name) + text[end:]
+    text = re.sub(r'(#define NUM_CLASSES \d+\n)',
+                  r'\1\n// Batch fixo: cada Invoke classifica MOTOR_MODEL_BATCH amostras (tools/batch_model.py)\n'
+                  r'#define MOTOR_MODEL_BATCH %d\n' % args.batch, text, count=1)
+    if 'MOTOR_MODEL_BATCH' not in text:
+        # motor_model_int8.h nao tem NUM_CLASSES: coloca antes do #endif final
+        end_guard = text.rindex('#endif')
+        text = (text[:end_guard] + '// Batch fixo: cada Invoke classifica MOTOR_MODEL_BATCH amostras\n'
+                '#define MOTOR_MODEL_BATCH %d\n\n' % args.batch + text[end_guard:])
+
+    with open(args.output, 'w') as f:
+        f.write(text)
+    print('%s: batch %d em %d tensores' % (args.output, args.batch, changed))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,580 @@
+#!/usr/bin/env python3
+"""Extrai os pesos das camadas densas de um modelo TFLite para o motor denso do firmware.
+
+Le o flatbuffer (arquivo .tflite ou o array C de motor_model.h), percorre os
+operadores FULLY_CONNECTED/SOFTMAX do subgrafo principal e gera um header C++
+com os pesos em arrays constexpr e a funcao de forward ja encadeada com os
+tamanhos de cada camada (dense_engine.h).
+
+Com --int8 o modelo float e quantizado (pos-treinamento, inteiro completo):
+pesos int8 simetricos por canal, bias int32, ativacoes int8 assimetricas com
+faixas medidas rodando os CSVs de data/ e o StandardScaler embutido na
+quantizacao da entrada. --report compara a acuracia float x int8 nos CSVs.
+
+So usa a biblioteca padrao, entao roda no build do firmware sem TensorFlow.
+
+Uso:
+    python3 tools/dense_export.py firmware/libs/motor_model.h -o motor_model_dense.h
+    python3 tools/dense_export.py firmware/libs/motor_model.h -o motor_model_dense.h \
+        --int8 --scaler firmware/libs/scaler_params.h --data-dir data --report
+"""
+import argparse
+import math
+import os
+import re
+import struct
+import sys
+
+# Codigos de operador do schema TFLite
+OP_FULLY_CONNECTED = 9
+OP_RELU = 19
+OP_RESHAPE = 22
+OP_SOFTMAX = 25
+
+# Ativacoes fundidas (ActivationFunctionType)
+ACT_NONE = 0
+ACT_RELU = 1
+
+TENSOR_FLOAT32 = 0
+
+
+class FlatBuffer:
+    """Leitor minimo de flatbuffers (so o necessario para o schema do TFLite)."""
+
+    def __init__(self, data):
+        self.data = data
+
+    def u8(self, pos):
+        return self.data[pos]
+
+    def u16(self, pos):
+        return struct.unpack_from('<H', self.data, pos)[0]
+
+    def u32(self, pos):
+        return struct.unpack_from('<I', self.data, pos)[0]
+
+    def i32(self, pos):
+        return struct.unpack_from('<i', self.data, pos)[0]
+
+    def field(self, table, index):
+        """Posicao absoluta do campo `index` da tabela, ou None se ausente."""
+        vtable = table - self.i32(table)
+        vtable_len = self.u16(vtable)
+        entry = 4 + 2 * index
+        if entry >= vtable_len:
+            return None
+        offset = self.u16(vtable + entry)
+        return table + offset if offset else None
+
+    def indirect(self, pos):
+        return pos + self.u32(pos)
+
+    def vector(self, pos):
+        """(inicio, tamanho) do vetor referenciado em `pos`."""
+        start = self.indirect(pos)
+        return start + 4, self.u32(start)
+
+    def tables(self, pos):
+        start, n = self.vector(pos)
+        return [self.indirect(start + 4 * k) for k in range(n)]
+
+    def ints(self, pos):
+        start, n = self.vector(pos)
+        return [self.i32(start + 4 * k) for k in range(n)]
+
+    def string(self, pos):
+        start, n = self.vector(pos)
+        return self.data[start:start + n].decode('utf-8')
+
+
+class Layer:
+    def __init__(self, name, weights, bias, activation, weights_offset=None, bias_offset=None):
+        self.name = name
+        self.weights = weights      # lista [out][in]
+        self.bias = bias            # lista [out]
+        self.activation = activation
+        # Posicao dos dados no flatbuffer (para reescrever os pesos no lugar)
+        self.weights_offset = weights_offset
+        self.bias_offset = bias_offset
+
+    @property
+    def inputs(self):
+        return len(self.weights[0])
+
+    @property
+    def outputs(self):
+        return len(self.weights)
+
+
+class DenseModel:
+    def __init__(self, layers, softmax, scaler_folded=False):
+        self.layers = layers
+        self.softmax = softmax
+        # StandardScaler embutido na primeira camada (modelo recebe as features brutas)
+        self.scaler_folded = scaler_folded
+
+
+def load_model_bytes(path):
+    """Le um .tflite ou extrai os bytes do primeiro array C de um header."""
+    if path.endswith('.tflite'):
+        with open(path, 'rb') as f:
+            return f.read()
+    with open(path) as f:
+        text = f.read()
+    body = text[text.index('{') + 1:text.index('};')]
+    return bytes(int(x, 16) for x in re.findall(r'0x([0-9a-fA-F]{2})', body))
+
+
+def header_scaler_folded(path):
+    """True se o header foi exportado com o StandardScaler embutido (MOTOR_MODEL_SCALER_FOLDED)."""
+    if path.endswith('.tflite'):
+        return False
+    with open(path) as f:
+        return re.search(r'#define\s+MOTOR_MODEL_SCALER_FOLDED\s+1', f.read()) is not None
+
+
+def parse_dense_model(data):
+    fb = FlatBuffer(data)
+    model = fb.indirect(0)
+
+    opcodes = []
+    for code in fb.tables(fb.field(model, 1)):
+        deprecated = fb.field(code, 0)
+        builtin = fb.field(code, 3)
+        value = fb.u8(deprecated) if deprecated is not None else 0
+        if builtin is not None:
+            value = max(value, fb.i32(builtin))
+        opcodes.append(value)
+
+    buffers = fb.tables(fb.field(model, 4))
+    subgraph = fb.tables(fb.field(model, 2))[0]
+    tensors = fb.tables(fb.field(subgraph, 0))
+
+    def tensor_info(index):
+        t = tensors[index]
+        shape = fb.ints(fb.field(t, 0))
+        ttype = fb.u8(fb.field(t, 1)) if fb.field(t, 1) is not None else 0
+        buf_field = fb.field(t, 2)
+        buf = fb.u32(buf_field) if buf_field is not None else 0
+        name_field = fb.field(t, 3)
+        name = fb.string(name_field) if name_field is not None else ''
+        return shape, ttype, buf, name
+
+    def tensor_floats(index):
+        shape, ttype, buf, _ = tensor_info(index)
+        if ttype != TENSOR_FLOAT32:
+            raise ValueError('tensor %d nao e float32 (modelo quantizado?)' % index)
+        data_field = fb.field(buffers[buf], 0)
+        if data_field is None:
+            raise ValueError('tensor %d sem dados constantes' % index)
+        start, n = fb.vector(data_field)
+        values = list(struct.unpack_from('<%df' % (n // 4), data, start))
+        return shape, values, start
+
+    layers = []
+    softmax = False
+    for op in fb.tables(fb.field(subgraph, 3)):
+        opcode = opcodes[fb.u32(fb.field(op, 0)) if fb.field(op, 0) is not None else 0]
+        inputs = fb.ints(fb.field(op, 1))
+
+        if opcode == OP_FULLY_CONNECTED:
+            if softmax:
+                raise ValueError('SOFTMAX antes do fim da rede nao e suportado')
+            shape, flat, weights_offset = tensor_floats(inputs[1])
+            outputs, depth = shape
+            weights = [flat[o * depth:(o + 1) * depth] for o in range(outputs)]
+            if len(inputs) > 2 and inputs[2] >= 0:
+                _, bias, bias_offset = tensor_floats(inputs[2])
+            else:
+                bias, bias_offset = [0.0] * outputs, None
+
+            activation = ACT_NONE
+            options_field = fb.field(op, 4)
+            if options_field is not None:
+                options = fb.indirect(options_field)
+                act_field = fb.field(options, 0)
+                activation = fb.u8(act_field) if act_field is not None else ACT_NONE
+            if activation not in (ACT_NONE, ACT_RELU):
+                raise ValueError('ativacao fundida %d nao suportada' % activation)
+
+            name = tensor_info(inputs[1])[3].split('/')
+            name = name[1].rsplit('_', 1)[0] if len(name) > 1 else 'layer%d' % len(layers)
+            if layers and layers[-1].outputs != depth:
+                raise ValueError('camadas nao encadeiam (%d -> %d)' % (layers[-1].outputs, depth))
+            layers.append(Layer(name, weights, bias, activation, weights_offset, bias_offset))
+        elif opcode == OP_RELU and layers:
+            layers[-1].activation = ACT_RELU
+        elif opcode == OP_SOFTMAX:
+            softmax = True
+        elif opcode == OP_RESHAPE:
+            continue
+        else:
+            raise ValueError('operador %d nao suportado pelo motor denso' % opcode)
+
+    if not layers:
+        raise ValueError('nenhuma camada FULLY_CONNECTED encontrada')
+    return DenseModel(layers, softmax)
+
+
+def c_float(value):
+    """Float32 com digitos suficientes para reproduzir exatamente o mesmo valor."""
+    value = struct.unpack('<f', struct.pack('<f', value))[0]
+    text = '%.9g' % value
+    if 'e' not in text and '.' not in text:
+        text += '.0'
+    return text + 'f'
+
+
+def format_row(values):
+    return ', '.join(c_float(v) for v in values)
+
+
+def generate_header(model, source_name):
+    act_names = {ACT_NONE: 'kNone', ACT_RELU: 'kRelu'}
+    out = []
+    out.append('// Motor Classification Model - pesos para o motor denso (dense_engine.h)')
+    out.append('// Auto-generated by tools/dense_export.py from %s - Do not edit manually' % source_name)
+    out.append('')
+    out.append('#ifndef MOTOR_MODEL_DENSE_H')
+    out.append('#define MOTOR_MODEL_DENSE_H')
+    out.append('')
+    out.append('#include "dense_engine.h"')
+    out.append('')
+    if model.scaler_folded:
+        out.append('// StandardScaler embutido na primeira camada: forward recebe as features brutas')
+        out.append('#define MOTOR_MODEL_SCALER_FOLDED 1')
+        out.append('')
+    out.append('namespace motor_dense {')
+    out.append('')
+    out.append('constexpr int kInputs = %d;' % model.layers[0].inputs)
+    out.append('constexpr int kOutputs = %d;' % model.layers[-1].outputs)
+
+    hidden = [layer.outputs for layer in model.layers[:-1]]
+    out.append('constexpr unsigned int kActivationBytes = %d;' % (4 * sum(hidden)))
+    out.append('')
+
+    for i, layer in enumerate(model.layers):
+        out.append('// %s: %d -> %d, ativacao %s' % (layer.name, layer.inputs, layer.outputs,
+                                                  act_names[layer.activation]))
+        out.append('constexpr float layer%d_weights[%d][%d] = {' % (i, layer.outputs, layer.inputs))
+        for row in layer.weights:
+            out.append('  {%s},' % format_row(row))
+        out.append('};')
+        out.append('constexpr float layer%d_bias[%d] = {' % (i, layer.outputs))
+        for k in range(0, layer.outputs, 8):
+            out.append('  %s,' % format_row(layer.bias[k:k + 8]))
+        out.append('};')
+        out.append('')
+
+    out.append('// Forward completo, com os tamanhos de cada camada fixados em tempo de compilacao')
+    out.append('inline void forward(const float in[kInputs], float out[kOutputs]) {')
+    for i, size in enumerate(hidden):
+        out.append('    float h%d[%d];' % (i, size))
+    for i, layer in enumerate(model.layers):
+        src = 'in' if i == 0 else 'h%d' % (i - 1)
+        dst = 'out' if i == len(model.layers) - 1 else 'h%d' % i
+        out.append('    dense::fully_connected<%d, %d, dense::Activation::%s>(layer%d_weights, layer%d_bias, %s, %s);'
+                   % (layer.inputs, layer.outputs, act_names[layer.activation], i, i, src, dst))
+    if model.softmax:
+        out.append('    dense::softmax<kOutputs>(out);')
+    out.append('}')
+    out.append('')
+    out.append('}  // namespace motor_dense')
+    out.append('')
+    out.append('#endif // MOTOR_MODEL_DENSE_H')
+    return '\n'.join(out) + '\n'
+
+
+# --- Quantizacao int8 ---
+
+FEATURE_COLUMNS = ['Acel_X', 'Acel_Y', 'Acel_Z', 'Giro_X', 'Giro_Y', 'Giro_Z']
+
+
+def load_scaler(path):
+    """Le scaler_mean[] e scaler_scale[] de scaler_params.h."""
+    with open(path) as f:
+        text = f.read()
+
+    def array(name):
+        body = re.search(name + r'\[\]\s*=\s*\{([^}]*)\}', text).group(1)
+        body = re.sub(r'//[^\n]*', '', body)
+        return [float(v.strip().rstrip('f')) for v in body.split(',') if v.strip()]
+
+    return array('scaler_mean'), array('scaler_scale')
+
+
+def load_levels(data_dir):
+    """Amostras (features, nivel) de nivel0.csv..nivel3.csv."""
+    samples = []
+    for level in range(4):
+        path = os.path.join(data_dir, 'nivel%d.csv' % level)
+        with open(path) as f:
+            header = f.readline().strip().split(',')
+            cols = [header.index(c) for c in FEATURE_COLUMNS]
+            for line in f:
+                fields = line.strip().split(',')
+                if len(fields) < len(header):
+                    continue
+                samples.append(([float(fields[c]) for c in cols], level))
+    return samples
+
+
+def float_forward(model, x):
+    """Forward float32 (em double) devolvendo as saidas de cada camada."""
+    outputs = []
+    for layer in model.layers:
+        y = []
+        for row, b in zip(layer.weights, layer.bias):
+            acc = 0.0
+            for w, v in zip(row, x):
+                acc += w * v
+            acc += b
+            y.append(max(acc, 0.0) if layer.activation == ACT_RELU else acc)
+        outputs.append(y)
+        x = y
+    return outputs
+
+
+def choose_qparams(lo, hi):
+    """Escala/zero point int8 assimetricos cobrindo [lo, hi] (sempre incluindo 0)."""
+    lo = min(lo, 0.0)
+    hi = max(hi, 0.0)
+    scale = (hi - lo) / 255.0 if hi > lo else 1.0
+    zero_point = int(round(-128 - lo / scale))
+    return scale, max(-128, min(127, zero_point))
+
+
+def quantize_multiplier(real):
+    """Igual ao QuantizeMultiplier do TFLite: real = m * 2^(shift - 31), m em Q31."""
+    if real == 0.0:
+        return 0, 0
+    mantissa, shift = math.frexp(real)
+    m = int(round(mantissa * (1 << 31)))
+    if m == (1 << 31):
+        m //= 2
+        shift += 1
+    return m, shift
+
+
+def requantize(acc, multiplier, shift):
+    """Mesma aritmetica de dense::requantize (dense_engine.h)."""
+    total = 31 - shift
+    return (acc * multiplier + (1 << (total - 1))) >> total
+
+
+def round_half_up(v):
+    return int(math.floor(v + 0.5))
+
+
+def clamp8(v):
+    return max(-128, min(127, v))
+
+
+class QuantLayer:
+    def __init__(self, layer, in_scale, in_zp, out_scale, out_zp):
+        self.layer = layer
+        self.out_scale = out_scale
+        self.out_zp = out_zp
+        self.weights = []
+        self.bias = []
+        self.multiplier = []
+        self.shift = []
+        for row, b in zip(layer.weights, layer.bias):
+            w_scale = max(abs(w) for w in row) / 127.0 or 1.0
+            q_row = [clamp8(round_half_up(w / w_scale)) for w in row]
+            q_bias = round_half_up(b / (in_scale * w_scale))
+            # Zero point da entrada embutido no bias: sum((x - zp) * w) = sum(x * w) - zp * sum(w)
+            q_bias -= in_zp * sum(q_row)
+            m, sh = quantize_multiplier(in_scale * w_scale / out_scale)
+            self.weights.append(q_row)
+            self.bias.append(q_bias)
+            self.multiplier.append(m)
+            self.shift.append(sh)
+
+    def run(self, x):
+        y = []
+        for row, b, m, sh in zip(self.weights, self.bias, self.multiplier, self.shift):
+            acc = b
+            for w, v in zip(row, x):
+                acc += w * v
+            q = self.out_zp + requantize(acc, m, sh)
+            if self.layer.activation == ACT_RELU:
+                q = max(q, self.out_zp)
+            y.append(clamp8(q))
+        return y
+
+
+class QuantModel:
+    def __init__(self, model, mean, scale, samples):
+        self.model = model
+        normalized = [[(v - m) / s for v, m, s in zip(x, mean, scale)] for x, _ in samples]
+
+        # Faixas de entrada e de cada camada medidas nos dados
+        lo = min(min(z) for z in normalized)
+        hi = max(max(z) for z in normalized)
+        ranges = [[float('inf'), float('-inf')] for _ in model.layers]
+        for z in normalized:
+            for r, y in zip(ranges, float_forward(model, z)):
+                r[0] = min(r[0], min(y))
+                r[1] = max(r[1], max(y))
+
+        self.in_scale, self.in_zp = choose_qparams(lo, hi)
+        # q = round(((x - mean) / scale) / in_scale + zp) = round(x * a + b)
+        self.input_mult = [1.0 / (s * self.in_scale) for s in scale]
+        self.input_offset = [self.in_zp - m / (s * self.in_scale) for m, s in zip(mean, scale)]
+
+        self.layers = []
+        in_scale, in_zp = self.in_scale, self.in_zp
+        for layer, (r_lo, r_hi) in zip(model.layers, ranges):
+            out_scale, out_zp = choose_qparams(r_lo, r_hi)
+            self.layers.append(QuantLayer(layer, in_scale, in_zp, out_scale, out_zp))
+            in_scale, in_zp = out_scale, out_zp
+
+    def logits(self, raw):
+        x = [clamp8(round_half_up(v * a + b))
+             for v, a, b in zip(raw, self.input_mult, self.input_offset)]
+        for layer in self.layers:
+            x = layer.run(x)
+        last = self.layers[-1]
+        return [(q - last.out_zp) * last.out_scale for q in x]
+
+
+def argmax(values):
+    return max(range(len(values)), key=lambda i: values[i])
+
+
+def report_accuracy(model, qmodel, mean, scale, samples):
+    float_hits = int8_hits = agree = 0
+    for x, label in samples:
+        z = [(v - m) / s for v, m, s in zip(x, mean, scale)]
+        f_pred = argmax(float_forward(model, z)[-1])
+        q_pred = argmax(qmodel.logits(x))
+        float_hits += f_pred == label
+        int8_hits += q_pred == label
+        agree += f_pred == q_pred
+    n = len(samples)
+    print('Acuracia nos CSVs (%d amostras): float %.2f%% | int8 %.2f%% | concordancia %.2f%%'
+          % (n, 100.0 * float_hits / n, 100.0 * int8_hits / n, 100.0 * agree / n))
+
+
+def format_ints(values):
+    return ', '.join(str(v) for v in values)
+
+
+def generate_int8_header(qmodel, source_name):
+    act_names = {ACT_NONE: 'kNone', ACT_RELU: 'kRelu'}
+    layers = qmodel.model.layers
+    out = []
+    out.append('// Motor Classification Model - pesos int8 para o motor denso (dense_engine.h)')
+    out.append('// Auto-generated by tools/dense_export.py --int8 from %s - Do not edit manually' % source_name)
+    out.append('')
+    out.append('#ifndef MOTOR_MODEL_DENSE_H')
+    out.append('#define MOTOR_MODEL_DENSE_H')
+    out.append('')
+    out.append('#include <stdint.h>')
+    out.append('#include "dense_engine.h"')
+    out.append('')
+    out.append('// Modelo quantizado: forward_raw recebe as features brutas (o scaler esta embutido)')
+    out.append('#define MOTOR_DENSE_INT8 1')
+    if qmodel.model.scaler_folded:
+        out.append('#define MOTOR_MODEL_SCALER_FOLDED 1')
+    out.append('')
+    out.append('namespace motor_dense {')
+    out.append('')
+    out.append('constexpr int kInputs = %d;' % layers[0].inputs)
+    out.append('constexpr int kOutputs = %d;' % layers[-1].outputs)
+    out.append('constexpr unsigned int kActivationBytes = %d;'
+               % (layers[0].inputs + sum(l.outputs for l in layers)))
+    out.append('')
+    out.append('// Entrada: q = round(x * input_mult + input_offset), com (x - mean) / scale embutido')
+    out.append('// escala %s, zero point %d' % (c_float(qmodel.in_scale), qmodel.in_zp))
+    out.append('constexpr float input_mult[%d] = {%s};' % (layers[0].inputs, format_row(qmodel.input_mult)))
+    out.append('constexpr float input_offset[%d] = {%s};' % (layers[0].inputs, format_row(qmodel.input_offset)))
+    out.append('')
+
+    for i, q in enumerate(qmodel.layers):
+        layer = q.layer
+        out.append('// %s: %d -> %d, ativacao %s, saida escala %s zero point %d'
+                   % (layer.name, layer.inputs, layer.outputs, act_names[layer.activation],
+                      c_float(q.out_scale), q.out_zp))
+        out.append('constexpr int8_t layer%d_weights[%d][%d] = {' % (i, layer.outputs, layer.inputs))
+        for row in q.weights:
+            out.append('  {%s},' % format_ints(row))
+        out.append('};')
+        out.append('constexpr int32_t layer%d_bias[%d] = {%s};' % (i, layer.outputs, format_ints(q.bias)))
+        out.append('constexpr int32_t layer%d_multiplier[%d] = {%s};'
+                   % (i, layer.outputs, format_ints(q.multiplier)))
+        out.append('constexpr int8_t layer%d_shift[%d] = {%s};' % (i, layer.outputs, format_ints(q.shift)))
+        out.append('constexpr int32_t layer%d_output_zero_point = %d;' % (i, q.out_zp))
+        out.append('')
+
+    last = qmodel.layers[-1]
+    out.append('constexpr float output_scale = %s;' % c_float(last.out_scale))
+    out.append('constexpr int32_t output_zero_point = %d;' % last.out_zp)
+    out.append('')
+    out.append('// Forward inteiro a partir da entrada ja quantizada: camadas int8 e desquantiza os logits')
+    out.append('inline void forward_q(const int8_t x[kInputs], float out[kOutputs]) {')
+    for i, layer in enumerate(layers):
+        out.append('    int8_t h%d[%d];' % (i, layer.outputs))
+    for i, layer in enumerate(layers):
+        src = 'x' if i == 0 else 'h%d' % (i - 1)
+        out.append('    dense::fully_connected_int8<%d, %d, dense::Activation::%s>(' % (
+            layer.inputs, layer.outputs, act_names[layer.activation]))
+        out.append('        layer%d_weights, layer%d_bias, layer%d_multiplier, layer%d_shift,' % (i, i, i, i))
+        out.append('        layer%d_output_zero_point, %s, h%d);' % (i, src, i))
+    out.append('    dense::dequantize<kOutputs>(h%d, output_scale, output_zero_point, out);' % (len(layers) - 1))
+    if qmodel.model.softmax:
+        out.append('    dense::softmax<kOutputs>(out);')
+    out.append('}')
+    out.append('')
+    out.append('// Forward das features brutas: quantiza a entrada e segue no forward_q')
+    out.append('inline void forward_raw(const float in[kInputs], float out[kOutputs]) {')
+    out.append('    int8_t x[%d];' % layers[0].inputs)
+    out.append('    dense::quantize_input<kInputs>(input_mult, input_offset, in, x);')
+    out.append('    forward_q(x, out);')
+    out.append('}')
+    out.append('')
+    out.append('}  // namespace motor_dense')
+    out.append('')
+    out.append('#endif // MOTOR_MODEL_DENSE_H')
+    return '\n'.join(out) + '\n'
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('model', help='motor_model.h ou arquivo .tflite')
+    parser.add_argument('-o', '--output', required=True, help='header gerado')
+    parser.add_argument('--int8', action='store_true', help='gera o modelo quantizado int8')
+    parser.add_argument('--scaler', help='scaler_params.h (obrigatorio com --int8)')
+    parser.add_argument('--data-dir', help='pasta com nivel0.csv..nivel3.csv (obrigatorio com --int8)')
+    parser.add_argument('--report', action='store_true', help='imprime a acuracia float x int8')
+    args = parser.parse_args(argv)
+
+    model = parse_dense_model(load_model_bytes(args.model))
+    model.scaler_folded = header_scaler_folded(args.model)
+    source_name = args.model.replace('\\', '/').split('/')[-1]
+
+    if args.int8:
+        if not args.data_dir or (not args.scaler and not model.scaler_folded):
+            parser.error('--int8 precisa de --data-dir e --scaler (exceto com o scaler embutido)')
+        if model.scaler_folded:
+            # O modelo ja recebe as features brutas: normalizacao identidade
+            n = model.layers[0].inputs
+            mean, scale = [0.0] * n, [1.0] * n
+        else:
+            mean, scale = load_scaler(args.scaler)
+        samples = load_levels(args.data_dir)
+        qmodel = QuantModel(model, mean, scale, samples)
+        if args.report:
+            report_accuracy(model, qmodel, mean, scale, samples)
+        header = generate_int8_header(qmodel, source_name)
+    else:
+        header = generate_header(model, source_name)
+
+    with open(args.output, 'w') as f:
+        f.write(header)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Converte o log de amostras da flash (firmware/src/flash_log.c) em CSV.
+
+A regiao do log sao os ultimos FLASH_LOG_SIZE bytes da flash, em setores de 4 KB:
+cabecalho de 16 bytes (magic "MLOG", sequencia, ~sequencia, registros, taxa) e 255
+registros de 16 bytes (acel[3] e giro[3] int16 em contagens do MPU6050, nivel previsto,
+confianca * 255, rotulo, reservado). Setores sem cabecalho valido (apagados ou gravados
+pela metade) sao ignorados e os demais saem em ordem de sequencia, do mais antigo
+para o mais recente.
+
+O CSV tem as colunas de data/nivel*.csv (m/s^2 e graus/s) mais Previsto, Confianca e
+Rotulo. Com --by-label os registros rotulados viram nivel<N>.csv, prontos para somar
+ao dataset de treino.
+
+Para ler a regiao do Pico (2 MB de flash, log de 512 KB):
+    picotool save -r 0x10180000 0x10200000 log.bin
+    python3 tools/flash_log_dump.py log.bin -o motor.csv
+No host, a imagem da flash simulada inteira (MOTOR_HOST_FLASH_FILE) tambem serve:
+    python3 tools/flash_log_dump.py flash.bin --by-label coleta/
+"""
+import argparse
+import os
+import struct
+import sys
+
+from telemetry_decode import CSV_COLUMNS, to_units
+
+FLASH_SIZE = 2 * 1024 * 1024
+FLASH_LOG_SIZE = 512 * 1024
+SECTOR_SIZE = 4096
+MAGIC = 0x474F4C4D
+HEADER = struct.Struct('<IIIHH')
+RECORD = struct.Struct('<6hbBbB')
+RECORDS_PER_SECTOR = (SECTOR_SIZE - HEADER.size) // RECORD.size
+LOG_COLUMNS = CSV_COLUMNS + ['Previsto', 'Confianca', 'Rotulo']
+
+
+def read_sectors(image, log_size):
+    """[(seq, taxa, registros)] em ordem de sequencia."""
+    # Imagem da flash inteira: o log fica no fim; senao a imagem e so a regiao
+    if len(image) > log_size:
+        image = image[-log_size:]
+    sectors = []
+    for offset in range(0, len(image) - SECTOR_SIZE + 1, SECTOR_SIZE):
+        magic, seq, seq_inv, count, rate = HEADER.unpack_from(image, offset)
+        if magic != MAGIC or seq_inv != (~seq & 0xFFFFFFFF) or count > RECORDS_PER_SECTOR:
+            continue
+        records = [RECORD.unpack_from(image, offset + HEADER.size + i * RECORD.size) for i in range(count)]
+        sectors.append((seq, rate, records))
+    if not sectors:
+        return []
+    # A sequencia e u32: ordena pela distancia ate a mais antiga (a que vem depois do maior buraco)
+    sectors.sort(key=lambda s: s[0])
+    seqs = [s[0] for s in sectors]
+    gaps = [(seqs[(i + 1) % len(seqs)] - seqs[i]) & 0xFFFFFFFF for i in range(len(seqs))]
+    oldest = (gaps.index(max(gaps)) + 1) % len(seqs)
+    return sectors[oldest:] + sectors[:oldest]
+
+
+def row(index, record):
+    values = to_units(record[:6])
+    predicted, confidence, label = record[6], record[7], record[8]
+    return '%d,%s,%d,%.3f,%d' % (index, ','.join('%.3f' % v for v in values), predicted, confidence / 255.0, label)
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('image', help='regiao do log (picotool save) ou imagem da flash inteira')
+    parser.add_argument('-o', '--output', help='CSV de saida (padrao: stdout)')
+    parser.add_argument('--by-label', metavar='DIR', help='grava os registros rotulados em DIR/nivel<N>.csv')
+    parser.add_argument('--log-size', type=int, default=FLASH_LOG_SIZE, help='FLASH_LOG_SIZE do firmware')
+    args = parser.parse_args(argv)
+
+    with open(args.image, 'rb') as f:
+        image = f.read()
+    sectors = read_sectors(image, args.log_size)
+    records = [r for _, _, recs in sectors for r in recs]
+
+    out = open(args.output, 'w') if args.output else sys.stdout
+    out.write(','.join(LOG_COLUMNS) + '\n')
+    for i, record in enumerate(records):
+        out.write(row(i + 1, record) + '\n')
+    if args.output:
+        out.close()
+
+    if args.by_label:
+        os.makedirs(args.by_label, exist_ok=True)
+        for label in sorted(set(r[8] for r in records if r[8] >= 0)):
+            path = os.path.join(args.by_label, 'nivel%d.csv' % label)
+            with open(path, 'w') as f:
+                f.write(','.join(LOG_COLUMNS) + '\n')
+                for i, record in enumerate(r for r in records if r[8] == label):
+                    f.write(row(i + 1, record) + '\n')
+
+    rates = sorted(set(rate for _, rate, _ in sectors))
+    print('%d setores validos (sequencia %s), %d registros, %s Hz' % (
+        len(sectors), '%d..%d' % (sectors[0][0], sectors[-1][0]) if sectors else '-', len(records),
+        '/'.join(str(r) for r in rates) or '-'), file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""Embute o StandardScaler na primeira camada densa de um modelo TFLite float.
+
+Com z = (x - mean) / scale, a primeira camada vira
+    W * z + b = (W / scale) * x + (b - (W / scale) * mean)
+entao os pesos e o bias da hidden1 sao reescritos no proprio flatbuffer (mesmo
+tamanho) e o firmware passa as features brutas direto pro modelo, sem as
+subtracoes e divisoes por amostra. O header gerado tem o mesmo formato do
+notebook mais #define MOTOR_MODEL_SCALER_FOLDED 1.
+
+--check roda os CSVs de data/ nos dois modelos e falha se alguma predicao mudar.
+--tflite grava tambem o flatbuffer embutido (o mesmo array do header) num .tflite.
+
+Uso:
+    python3 tools/fold_scaler.py models/motor_classification_model.tflite \\
+        --scaler firmware/libs/scaler_params.h -o firmware/libs/motor_model.h --check data \\
+        --tflite models/motor_classification_model_folded.tflite
+"""
+import argparse
+import math
+import struct
+import sys
+
+from dense_export import (float_forward, header_scaler_folded, load_levels, load_model_bytes,
+                          load_scaler, parse_dense_model)
+
+HEADER_TEMPLATE = """// Motor Classification Model - TinyML
+// Auto-generated file - Do not edit manually
+// Model trained on MPU6050 data (Accel + Gyro)
+
+#ifndef MOTOR_MODEL_H
+#define MOTOR_MODEL_H
+
+{array}
+// Model information
+#define NUM_FEATURES 6
+#define NUM_CLASSES 4
+
+// StandardScaler folded into hidden1 (W' = W / scale, b' = b - W' * mean):
+// feed raw sensor features, scaler_params.h is not needed
+#define MOTOR_MODEL_SCALER_FOLDED 1
+
+// Class names
+const char* class_names[] = {{
+  "Nivel 0",
+  "Nivel 1",
+  "Nivel 2",
+  "Nivel 3"
+}};
+
+#endif // MOTOR_MODEL_H
+"""
+
+
+def to_float32(value):
+    return struct.unpack('<f', struct.pack('<f', value))[0]
+
+
+def fold(data, mean, scale):
+    """Devolve (bytes do modelo com a hidden1 reescrita, modelo original, modelo embutido)."""
+    model = parse_dense_model(data)
+    first = model.layers[0]
+    if first.bias_offset is None:
+        raise ValueError('a primeira camada nao tem bias, nao da pra embutir o scaler')
+    if first.inputs != len(mean):
+        raise ValueError('scaler com %d features, modelo com %d' % (len(mean), first.inputs))
+
+    out = bytearray(data)
+    for o, (row, b) in enumerate(zip(first.weights, first.bias)):
+        new_row = [to_float32(w / s) for w, s in zip(row, scale)]
+        new_bias = to_float32(b - sum((w / s) * m for w, s, m in zip(row, scale, mean)))
+        struct.pack_into('<%df' % first.inputs, out, first.weights_offset + 4 * o * first.inputs, *new_row)
+        struct.pack_into('<f', out, first.bias_offset + 4 * o, new_bias)
+
+    folded = parse_dense_model(bytes(out))
+    return bytes(out), model, folded
+
+
+def softmax(values):
+    top = max(values)
+    exps = [math.exp(v - top) for v in values]
+    total = sum(exps)
+    return [e / total for e in exps]
+
+
+def parity_check(model, folded, mean, scale, samples):
+    """Compara as predicoes do modelo original (entrada normalizada) e do embutido (entrada bruta)."""
+    same = 0
+    max_diff = 0.0
+    for x, _ in samples:
+        z = [(v - m) / s for v, m, s in zip(x, mean, scale)]
+        p_ref = softmax(float_forward(model, z)[-1])
+        p_fold = softmax(float_forward(folded, x)[-1])
+        same += p_ref.index(max(p_ref)) == p_fold.index(max(p_fold))
+        max_diff = max(max_diff, max(abs(a - b) for a, b in zip(p_ref, p_fold)))
+    print('Paridade nos CSVs: %d/%d predicoes identicas, maior diferenca de score %.2e'
+          % (same, len(samples), max_diff))
+    return same == len(samples)
+
+
+def c_array(data, var_name):
+    """Mesmo formato do convert_to_c_array do notebook."""
+    hex_array = ['0x%02x' % byte for byte in data]
+    lines = ['const unsigned char %s[] = {' % var_name]
+    for i in range(0, len(hex_array), 16):
+        line = '  ' + ', '.join(hex_array[i:i + 16])
+        if i + 16 < len(hex_array):
+            line += ','
+        lines.append(line)
+    lines.append('};')
+    lines.append('const unsigned int %s_len = %d;' % (var_name, len(data)))
+    return '\n'.join(lines) + '\n'
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('model', help='motor_model.h (sem o scaler embutido) ou arquivo .tflite')
+    parser.add_argument('--scaler', required=True, help='scaler_params.h')
+    parser.add_argument('-o', '--output', required=True, help='motor_model.h gerado')
+    parser.add_argument('--check', metavar='DATA_DIR', help='verifica a paridade com os CSVs')
+    parser.add_argument('--tflite', metavar='PATH', help='grava tambem o modelo embutido em .tflite')
+    args = parser.parse_args(argv)
+
+    if header_scaler_folded(args.model):
+        parser.error('%s ja tem o scaler embutido' % args.model)
+
+    mean, scale = load_scaler(args.scaler)
+    data, model, folded = fold(load_model_bytes(args.model), mean, scale)
+
+    if args.check and not parity_check(model, folded, mean, scale, load_levels(args.check)):
+        print('Erro: o modelo embutido muda predicoes, header nao gerado')
+        return 1
+
+    with open(args.output, 'w') as f:
+        f.write(HEADER_TEMPLATE.format(array=c_array(data, 'motor_model')))
+    if args.tflite:
+        with open(args.tflite, 'wb') as f:
+            f.write(data)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
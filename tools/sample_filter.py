@@ -0,0 +1,358 @@
+#!/usr/bin/env python3
+"""Filtro anti-aliasing + decimacao em ponto fixo, mesma conta do firmware (sample_filter.c).
+
+O firmware le o MPU6050 DECIMATION vezes mais rapido que a taxa do modelo e cada canal passa
+por uma cascata de biquads (Butterworth passa-baixa, coeficientes Q14, forma direta I com
+acumulador de 32 bits) e por um FIR passa-baixa (coeficientes Q15) que so e avaliado a cada
+DECIMATION entradas (decimador polifasico). Aqui:
+
+- design() projeta os coeficientes e os quantiza (ganho DC exatamente 1 nos inteiros)
+- write_header() gera firmware/libs/sample_filter_coeffs.h, lido por load_header()
+- SampleFilter repete a conta inteira do C bit a bit, e filter_samples() aplica o filtro nas
+  linhas dos CSVs como o build host entrega (cada linha repetida DECIMATION vezes) para o
+  notebook treinar o modelo com o mesmo sinal que o firmware ve
+
+Uso:
+    python3 tools/sample_filter.py --header firmware/libs/sample_filter_coeffs.h
+    python3 tools/sample_filter.py --check data   # resposta em frequencia e erro contra o filtro em double
+"""
+import argparse
+import cmath
+import math
+import re
+import struct
+import sys
+
+from dense_export import load_levels
+
+OUTPUT_RATE_HZ = 100  # taxa dos CSVs (e do modelo)
+DECIMATION = 5        # sensor a 500 Hz
+CUTOFF_HZ = 40.0      # abaixo do Nyquist de 50 Hz da saida
+SECTIONS = 2          # Butterworth de ordem 4
+TAPS = 15             # 3 por fase
+
+CHANNELS = 6
+BIQUAD_SHIFT = 14
+FIR_SHIFT = 15
+# Mesmas sensibilidades do mpu6050.c (±2g e ±250°/s)
+ACCEL_SENSITIVITY = 16384.0
+GYRO_SENSITIVITY = 131.0
+GRAVITY_MS2 = 9.81
+
+
+def f32(value):
+    return struct.unpack('<f', struct.pack('<f', value))[0]
+
+
+def saturate16(v):
+    return -32768 if v < -32768 else (32767 if v > 32767 else v)
+
+
+def butterworth_sections(cutoff_hz, rate_hz, sections):
+    """Biquads {b0, b1, b2, a1, a2} (a0 = 1) do Butterworth de ordem 2*sections pela transformada bilinear."""
+    k = math.tan(math.pi * cutoff_hz / rate_hz)
+    order = 2 * sections
+    out = []
+    for i in range(sections):
+        q = 1.0 / (2.0 * math.sin((2 * i + 1) * math.pi / (2 * order)))
+        norm = 1.0 / (1.0 + k / q + k * k)
+        b0 = k * k * norm
+        out.append((b0, 2.0 * b0, b0, 2.0 * (k * k - 1.0) * norm, (1.0 - k / q + k * k) * norm))
+    return out
+
+
+def fir_lowpass(cutoff_hz, rate_hz, taps):
+    """FIR passa-baixa por seno cardinal com janela de Hamming, soma 1."""
+    fc = cutoff_hz / rate_hz
+    mid = (taps - 1) / 2.0
+    h = []
+    for n in range(taps):
+        t = n - mid
+        sinc = 2.0 * fc if t == 0 else math.sin(2.0 * math.pi * fc * t) / (math.pi * t)
+        window = 0.54 - 0.46 * math.cos(2.0 * math.pi * n / (taps - 1)) if taps > 1 else 1.0
+        h.append(sinc * window)
+    total = sum(h)
+    return [v / total for v in h]
+
+
+def design(decimation=DECIMATION, output_rate_hz=OUTPUT_RATE_HZ, cutoff_hz=CUTOFF_HZ,
+           sections=SECTIONS, taps=TAPS):
+    """Coeficientes quantizados: dict com biquads (Q14), fir (Q15) e os parametros do projeto."""
+    rate_hz = output_rate_hz * decimation
+    if not 0 < cutoff_hz < output_rate_hz / 2.0:
+        raise ValueError('o corte tem que ficar abaixo do Nyquist da saida (%.1f Hz)' % (output_rate_hz / 2.0))
+
+    biquads = []
+    for b0, b1, b2, a1, a2 in butterworth_sections(cutoff_hz, rate_hz, sections):
+        one = 1 << BIQUAD_SHIFT
+        qa1, qa2 = round(a1 * one), round(a2 * one)
+        qb0 = qb2 = round(b0 * one)
+        # b1 absorve o arredondamento: sum(b) = 1 + a1 + a2 nos inteiros, ganho DC exatamente 1
+        qb1 = one + qa1 + qa2 - qb0 - qb2
+        section = (qb0, qb1, qb2, qa1, qa2)
+        # |acumulador| <= 32768 * sum|coef| cabe em int32
+        if sum(abs(c) for c in section) >= 1 << 16 or max(abs(c) for c in section) > 32767:
+            raise ValueError('biquad fora da faixa do Q14: %s' % (section,))
+        biquads.append(section)
+
+    one = 1 << FIR_SHIFT
+    fir = [round(v * one) for v in fir_lowpass(cutoff_hz, rate_hz, taps)]
+    fir[taps // 2] += one - sum(fir)  # soma exata 1.0 em Q15 no tap central
+    if sum(abs(c) for c in fir) >= 1 << 16 or max(abs(c) for c in fir) > 32767:
+        raise ValueError('FIR fora da faixa do Q15')
+
+    return {'decimation': decimation, 'output_rate_hz': output_rate_hz, 'cutoff_hz': cutoff_hz,
+            'biquads': biquads, 'fir': fir}
+
+
+def header_text(coeffs):
+    biquads = ', \\\n'.join('    {%s}' % ', '.join('%d' % c for c in s) for s in coeffs['biquads'])
+    fir = ', '.join('%d' % c for c in coeffs['fir'])
+    rate = coeffs['output_rate_hz'] * coeffs['decimation']
+    return """// Sample Filter Coefficients - anti-alias + decimation between the MPU6050 and the model
+// Auto-generated file - Do not edit manually (tools/sample_filter.py, notebook section 7)
+
+#ifndef SAMPLE_FILTER_COEFFS_H
+#define SAMPLE_FILTER_COEFFS_H
+
+// Sensor at %(rate)d Hz, model at %(out)d Hz, low-pass cutoff %(cutoff)g Hz
+#define SAMPLE_FILTER_DECIMATION %(dec)d
+#define SAMPLE_FILTER_OUTPUT_HZ %(out)d
+#define SAMPLE_FILTER_CUTOFF_HZ %(cutoff)g
+
+// Butterworth biquads {b0, b1, b2, a1, a2} in Q14 (a0 = 1), unity DC gain
+#define SAMPLE_FILTER_SECTIONS %(sections)d
+#define SAMPLE_FILTER_BIQUADS { \\
+%(biquads)s \\
+}
+
+// FIR low-pass taps in Q15 (sum = 32768), evaluated once per SAMPLE_FILTER_DECIMATION inputs
+#define SAMPLE_FILTER_TAPS %(taps)d
+#define SAMPLE_FILTER_FIR {%(fir)s}
+
+#endif // SAMPLE_FILTER_COEFFS_H
+""" % {'rate': rate, 'out': coeffs['output_rate_hz'], 'cutoff': coeffs['cutoff_hz'], 'dec': coeffs['decimation'],
+       'sections': len(coeffs['biquads']), 'biquads': biquads,
+       'taps': len(coeffs['fir']), 'fir': fir}
+
+
+def write_header(coeffs, path):
+    with open(path, 'w') as f:
+        f.write(header_text(coeffs))
+
+
+def load_header(path):
+    """Le os coeficientes de um sample_filter_coeffs.h (a fonte de verdade do firmware)."""
+    with open(path) as f:
+        text = f.read()
+
+    def define(name):
+        m = re.search(r'#define\s+%s\s+(.+?)\s*$' % name, text, re.M)
+        if not m:
+            raise ValueError('%s nao encontrado em %s' % (name, path))
+        return m.group(1)
+
+    body = re.search(r'#define\s+SAMPLE_FILTER_BIQUADS\s*\{(.*?)\}\s*$', text, re.S | re.M).group(1)
+    biquads = [tuple(int(v) for v in s.split(',')) for s in re.findall(r'\{([^{}]*)\}', body)]
+    fir = [int(v) for v in define('SAMPLE_FILTER_FIR').strip('{}').split(',')]
+    return {'decimation': int(define('SAMPLE_FILTER_DECIMATION')),
+            'output_rate_hz': int(define('SAMPLE_FILTER_OUTPUT_HZ')),
+            'cutoff_hz': float(define('SAMPLE_FILTER_CUTOFF_HZ')), 'biquads': biquads, 'fir': fir}
+
+
+class SampleFilter:
+    """Mesmo estado e mesma conta do sample_filter_t (sample_filter.c)."""
+
+    def __init__(self, coeffs):
+        self.biquads = coeffs['biquads']
+        self.fir = coeffs['fir']
+        self.decimation = coeffs['decimation']
+        self.primed = False
+        self.phase = 0
+
+    def _prime(self, x):
+        # Estado de regime para a primeira amostra (sem transitorio da gravidade)
+        self.iir = [[[v, v, v, v] for _ in self.biquads] for v in x]
+        self.history = [[v] * len(self.fir) for v in x]
+        self.primed = True
+
+    def push(self, x):
+        """Uma amostra (contagens) por canal; devolve a saida decimada ou None."""
+        if not self.primed:
+            self._prime(x)
+        for c in range(CHANNELS):
+            v = x[c]
+            for (b0, b1, b2, a1, a2), s in zip(self.biquads, self.iir[c]):
+                x1, x2, y1, y2 = s
+                acc = b0 * v + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2
+                y = saturate16((acc + (1 << (BIQUAD_SHIFT - 1))) >> BIQUAD_SHIFT)
+                s[:] = [v, x1, y, y1]
+                v = y
+            h = self.history[c]
+            h.pop(0)
+            h.append(v)
+
+        self.phase += 1
+        if self.phase < self.decimation:
+            return None
+        self.phase = 0
+        out = []
+        for c in range(CHANNELS):
+            # fir[0] multiplica a amostra mais nova
+            acc = sum(t * v for t, v in zip(self.fir, reversed(self.history[c])))
+            out.append(saturate16((acc + (1 << (FIR_SHIFT - 1))) >> FIR_SHIFT))
+        return out
+
+
+def roundf(value):
+    """roundf do C: metade para longe do zero."""
+    return int(math.copysign(math.floor(abs(value) + 0.5), value))
+
+
+def to_counts(features):
+    """Unidade fisica -> contagens, como o MPU6050 simulado do build host (fake_mpu6050_encode)."""
+    out = []
+    for axis, v in enumerate(features):
+        if axis < 3:
+            raw = f32(f32(f32(v) / f32(GRAVITY_MS2)) * ACCEL_SENSITIVITY)
+        else:
+            raw = f32(f32(v) * GYRO_SENSITIVITY)
+        out.append(saturate16(roundf(raw)))
+    return out
+
+
+def to_physical(counts):
+    """Contagens -> m/s² e °/s em float32, igual ao mpu6050_frame_to_data."""
+    return ([f32(f32(c / ACCEL_SENSITIVITY) * f32(GRAVITY_MS2)) for c in counts[:3]] +
+            [f32(c / f32(GYRO_SENSITIVITY)) for c in counts[3:]])
+
+
+def filter_samples(samples, coeffs, counts=False):
+    """Filtra uma serie de amostras (unidade fisica, uma por periodo do modelo).
+
+    Cada amostra e lida DECIMATION vezes (o sensor sobreamostrado vendo um sinal de 100 Hz, como
+    no build host) e sai uma amostra filtrada por periodo, na unidade fisica, a mesma que o
+    firmware entrega ao modelo com MOTOR_SENSOR_FILTER (counts=True: nas contagens do filtro,
+    como o push_frames as recebe no modelo de janelas).
+    """
+    f = SampleFilter(coeffs)
+    out = []
+    for features in samples:
+        raw = to_counts(features)
+        for _ in range(coeffs['decimation']):
+            y = f.push(raw)
+        out.append(y if counts else to_physical(y))
+    return out
+
+
+def filter_levels(data_dir, coeffs, counts=False):
+    """load_levels com cada nivel filtrado como serie temporal: lista de (features, nivel)."""
+    by_level = {}
+    for features, label in load_levels(data_dir):
+        by_level.setdefault(label, []).append(features)
+    out = []
+    for label in sorted(by_level):
+        out += [(features, label) for features in filter_samples(by_level[label], coeffs, counts)]
+    return out
+
+
+def response(coeffs, freq_hz):
+    """Ganho complexo da cascata quantizada + FIR na taxa do sensor."""
+    rate = coeffs['output_rate_hz'] * coeffs['decimation']
+    z = cmath.exp(-2j * math.pi * freq_hz / rate)  # z^-1
+    h = 1.0
+    for b0, b1, b2, a1, a2 in coeffs['biquads']:
+        h *= (b0 + b1 * z + b2 * z * z) / ((1 << BIQUAD_SHIFT) + a1 * z + a2 * z * z)
+    h *= sum(t * z ** n for n, t in enumerate(coeffs['fir'])) / (1 << FIR_SHIFT)
+    return h
+
+
+def reference_filter(samples, coeffs):
+    """Mesma cadeia em double com os coeficientes sem quantizar (contagens, sem saturacao)."""
+    rate = coeffs['output_rate_hz'] * coeffs['decimation']
+    sections = butterworth_sections(coeffs['cutoff_hz'], rate, len(coeffs['biquads']))
+    fir = fir_lowpass(coeffs['cutoff_hz'], rate, len(coeffs['fir']))
+    out = []
+    state = None
+    history = None
+    phase = 0
+    for features in samples:
+        x = to_counts(features)
+        for _ in range(coeffs['decimation']):
+            if state is None:
+                state = [[[float(v)] * 4 for _ in sections] for v in x]
+                history = [[float(v)] * len(fir) for v in x]
+            for c in range(CHANNELS):
+                v = float(x[c])
+                for (b0, b1, b2, a1, a2), s in zip(sections, state[c]):
+                    y = b0 * v + b1 * s[0] + b2 * s[1] - a1 * s[2] - a2 * s[3]
+                    s[:] = [v, s[0], y, s[2]]
+                    v = y
+                history[c].pop(0)
+                history[c].append(v)
+            phase += 1
+            if phase == coeffs['decimation']:
+                phase = 0
+                out.append([sum(t * v for t, v in zip(fir, reversed(h))) for h in history])
+    return out
+
+
+def check(data_dir, coeffs):
+    rate = coeffs['output_rate_hz'] * coeffs['decimation']
+    nyquist = coeffs['output_rate_hz'] / 2.0
+    print('Sensor %d Hz -> modelo %d Hz, corte %.1f Hz, %d biquads + FIR de %d taps' % (
+        rate, coeffs['output_rate_hz'], coeffs['cutoff_hz'], len(coeffs['biquads']), len(coeffs['fir'])))
+    for freq in (0, 5, 10, 20, 30, 40, nyquist, 60, 100, 150, 200, rate / 2.0):
+        gain = abs(response(coeffs, freq))
+        alias = abs((freq + nyquist) % coeffs['output_rate_hz'] - nyquist)
+        note = ' (vira %.0f Hz na saida)' % alias if freq > nyquist else ''
+        print('  %6.1f Hz: %7.2f dB%s' % (freq, 20 * math.log10(max(gain, 1e-12)), note))
+
+    by_level = {}
+    for features, label in load_levels(data_dir):
+        by_level.setdefault(label, []).append(features)
+    worst = 0.0
+    for label in sorted(by_level):
+        samples = by_level[label]
+        f = SampleFilter(coeffs)
+        fixed = []
+        for features in samples:
+            counts = to_counts(features)
+            for _ in range(coeffs['decimation']):
+                y = f.push(counts)
+            fixed.append(y)
+        ref = reference_filter(samples, coeffs)
+        err = max(abs(a - b) for fa, fb in zip(fixed, ref) for a, b in zip(fa, fb))
+        worst = max(worst, err)
+        print('Nivel %d: %d amostras, maior diferenca para o filtro em double %.2f contagens' % (
+            label, len(samples), err))
+    return worst
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('--header', metavar='PATH', help='gera o sample_filter_coeffs.h')
+    parser.add_argument('--check', metavar='DATA_DIR', help='resposta em frequencia e erro nos CSVs')
+    parser.add_argument('--coeffs', metavar='PATH', help='usa os coeficientes de um header existente')
+    parser.add_argument('--decimation', type=int, default=DECIMATION)
+    parser.add_argument('--cutoff', type=float, default=CUTOFF_HZ)
+    parser.add_argument('--sections', type=int, default=SECTIONS)
+    parser.add_argument('--taps', type=int, default=TAPS)
+    args = parser.parse_args(argv)
+
+    if args.coeffs:
+        coeffs = load_header(args.coeffs)
+    else:
+        coeffs = design(args.decimation, OUTPUT_RATE_HZ, args.cutoff, args.sections, args.taps)
+    if args.header:
+        write_header(coeffs, args.header)
+        print('%s gerado' % args.header)
+    if args.check:
+        check(args.check, coeffs)
+    if not args.header and not args.check:
+        sys.stdout.write(header_text(coeffs))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
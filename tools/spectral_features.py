@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""Energia por banda com FFT Q15, mesma conta do firmware (fft_q15.c + spectral_features.c).
+
+Cada eixo guarda as ultimas SPECTRAL_FFT_SIZE amostras em Q15 (contagens do MPU6050),
+remove a media inteira, normaliza a janela (ponto flutuante em bloco: desloca ate o
+pico ocupar metade da escala), roda a FFT real radix-2 em ponto fixo (estagios com
+>> 1, twiddles Q15 da tabela de um quarto de seno) e soma |X[k]|^2 dos bins 1..N/2
+em SPECTRAL_BANDS bandas iguais. Toda a parte inteira e identica bit a bit ao C, entao
+o modelo treinado no notebook ve exatamente as mesmas features do firmware.
+
+Uso:
+    python3 tools/spectral_features.py --twiddle     # tabela quarter_sine do fft_q15.c
+    python3 tools/spectral_features.py --check data  # erro da FFT Q15 contra a DFT em double
+"""
+import argparse
+import cmath
+import math
+import struct
+import sys
+
+FFT_Q15_MAX_SIZE = 256
+SPECTRAL_FFT_SIZE = 64
+SPECTRAL_BANDS = 4
+SPECTRAL_ACCEL_TO_Q15 = 1670.13252  # 16384 LSB/g / 9.81 m/s^2
+SPECTRAL_GYRO_TO_Q15 = 131.0
+
+
+def f32(value):
+    return struct.unpack('<f', struct.pack('<f', value))[0]
+
+
+TO_Q15 = [f32(SPECTRAL_ACCEL_TO_Q15)] * 3 + [f32(SPECTRAL_GYRO_TO_Q15)] * 3
+QUARTER_SINE = [min(32767, int(math.floor(math.sin(2 * math.pi * k / FFT_Q15_MAX_SIZE) * 32768 + 0.5)))
+                for k in range(FFT_Q15_MAX_SIZE // 4 + 1)]
+
+
+def feature_names(axes):
+    return ['%s_band%d' % (axis, b) for axis in axes for b in range(SPECTRAL_BANDS)]
+
+
+def saturate_q15(v):
+    return -32768 if v < -32768 else (32767 if v > 32767 else v)
+
+
+def to_q15(value, axis):
+    """floorf(x * k + 0.5f) em float32 com saturacao, igual ao spectral_features_push()."""
+    return saturate_q15(int(math.floor(f32(f32(f32(value) * TO_Q15[axis]) + 0.5))))
+
+
+def twiddle(m):
+    quarter = FFT_Q15_MAX_SIZE // 4
+    if m <= quarter:
+        return QUARTER_SINE[quarter - m], QUARTER_SINE[m]
+    return -QUARTER_SINE[m - quarter], QUARTER_SINE[2 * quarter - m]
+
+
+def fft_q15_complex(re, im):
+    n = len(re)
+    j = 0
+    for i in range(1, n):
+        bit = n >> 1
+        while j & bit:
+            j ^= bit
+            bit >>= 1
+        j ^= bit
+        if i < j:
+            re[i], re[j] = re[j], re[i]
+            im[i], im[j] = im[j], im[i]
+
+    length = 2
+    while length <= n:
+        half = length >> 1
+        step = FFT_Q15_MAX_SIZE // length
+        for jj in range(half):
+            c, s = twiddle(jj * step)
+            for i in range(jj, n, length):
+                b = i + half
+                tr = (c * re[b] + s * im[b] + (1 << 14)) >> 15
+                ti = (c * im[b] - s * re[b] + (1 << 14)) >> 15
+                ar, ai = re[i], im[i]
+                re[i] = saturate_q15((ar + tr) >> 1)
+                im[i] = saturate_q15((ai + ti) >> 1)
+                re[b] = saturate_q15((ar - tr) >> 1)
+                im[b] = saturate_q15((ai - ti) >> 1)
+        length <<= 1
+
+
+def fft_q15_real(samples):
+    """Bins 0..n/2 (re, im) escalados por 2/n, como o fft_q15_real() do firmware."""
+    n = len(samples)
+    half = n >> 1
+    re = list(samples[0::2])
+    im = list(samples[1::2])
+    fft_q15_complex(re, im)
+    step = FFT_Q15_MAX_SIZE // n
+    bins = []
+    for k in range(half + 1):
+        a, m = k % half, (half - k) % half
+        fe_r = (re[a] + re[m]) >> 1
+        fe_i = (im[a] - im[m]) >> 1
+        fo_r = (im[a] + im[m]) >> 1
+        fo_i = (re[m] - re[a]) >> 1
+        c, s = twiddle(k * step)
+        bins.append((fe_r + ((c * fo_r + s * fo_i + (1 << 14)) >> 15),
+                     fe_i + ((c * fo_i - s * fo_r + (1 << 14)) >> 15)))
+    return bins
+
+
+def band_energies(frame, axis, size=SPECTRAL_FFT_SIZE, bands=SPECTRAL_BANDS):
+    """Energias das bandas de uma janela Q15 (em ordem de tempo) de um eixo."""
+    mean = sum(frame) // size
+    centered = [saturate_q15(x - mean) for x in frame]
+    # Ponto flutuante em bloco: pico ate metade da escala, energia corrigida por 4^shift
+    peak = max(abs(x) for x in centered)
+    shift = 0
+    while peak and (peak << (shift + 1)) <= 16383:
+        shift += 1
+    bins = fft_q15_real([x << shift for x in centered])
+    per_band = size // 2 // bands
+    unit = 1.0 / (TO_Q15[axis] * TO_Q15[axis] * (1 << (2 * shift)))
+    out = []
+    for b in range(bands):
+        energy = sum(re * re + im * im for re, im in bins[1 + b * per_band:1 + (b + 1) * per_band])
+        out.append(energy * unit)
+    return out
+
+
+def stream_features(samples, size=SPECTRAL_FFT_SIZE, counts=False):
+    """Gera (indice, features) para cada amostra a partir da que completa a primeira janela.
+
+    counts=True: as amostras ja sao contagens do MPU6050 e entram direto como Q15, como o
+    spectral_features_push_counts() do firmware; senao passam pelo to_q15 (spectral_features_push).
+    """
+    axes = len(samples[0]) if samples else 0
+    if counts:
+        fixed = [[s[i] for s in samples] for i in range(axes)]
+    else:
+        fixed = [[to_q15(s[i], i) for s in samples] for i in range(axes)]
+    for t in range(size - 1, len(samples)):
+        out = []
+        for axis, values in enumerate(fixed):
+            out.extend(band_energies(values[t - size + 1:t + 1], axis, size))
+        yield t, out
+
+
+def twiddle_table():
+    lines = []
+    for i in range(0, len(QUARTER_SINE), 13):
+        lines.append('    ' + ', '.join(str(v) for v in QUARTER_SINE[i:i + 13]))
+    return ('static const int16_t quarter_sine[FFT_Q15_MAX_SIZE / 4 + 1] = {\n'
+            + ',\n'.join(lines) + '\n};')
+
+
+def check(data_dir, size=SPECTRAL_FFT_SIZE):
+    """Erro relativo da energia por banda (Q15) contra a DFT em double nos CSVs."""
+    from dense_export import load_levels
+    by_level = {}
+    for features, label in load_levels(data_dir):
+        by_level.setdefault(label, []).append(features)
+
+    worst = [0.0] * 6
+    for samples in by_level.values():
+        fixed = [[to_q15(s[i], i) for s in samples] for i in range(6)]
+        for t in range(size - 1, len(samples), size):
+            for axis in range(6):
+                frame = fixed[axis][t - size + 1:t + 1]
+                q = band_energies(frame, axis, size)
+                mean = sum(frame) / size
+                x = [v - mean for v in frame]
+                spectrum = [sum(x[i] * cmath.exp(-2j * math.pi * k * i / size) for i in range(size)) * 2 / size
+                            for k in range(size // 2 + 1)]
+                per_band = size // 2 // SPECTRAL_BANDS
+                for b in range(SPECTRAL_BANDS):
+                    ref = sum(abs(v) ** 2 for v in spectrum[1 + b * per_band:1 + (b + 1) * per_band])
+                    ref /= TO_Q15[axis] ** 2
+                    total = sum(abs(v) ** 2 for v in spectrum[1:]) / TO_Q15[axis] ** 2
+                    if total > 0:
+                        worst[axis] = max(worst[axis], abs(q[b] - ref) / total)
+    print('Maior erro por banda (fracao da energia total da janela), por eixo:')
+    for axis, err in enumerate(worst):
+        print('  eixo %d: %.2e' % (axis, err))
+    return 0
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('--twiddle', action='store_true', help='imprime a tabela de twiddles do fft_q15.c')
+    parser.add_argument('--check', metavar='DATA_DIR', help='compara com a DFT em double nos CSVs')
+    args = parser.parse_args(argv)
+    if args.twiddle:
+        print(twiddle_table())
+        return 0
+    if args.check:
+        return check(args.check)
+    parser.print_help()
+    return 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+"""Decodifica o fluxo binario de telemetria do firmware (firmware/src/telemetry.c).
+
+Cada quadro e COBS entre dois 0x00: tipo, sequencia, carimbo (us, u32), carga util e
+CRC-16/CCITT-FALSE, tudo little-endian (o formato de cada tipo esta em telemetry.h).
+Bytes que nao formam um quadro valido (printf de boot ou de erro no mesmo fluxo) saem
+como texto; quadros com CRC errado sao contados e descartados, e os buracos na
+sequencia de cada tipo contam os quadros perdidos.
+
+Com --csv as amostras brutas (MOTOR_TELEMETRY=RAW) viram um CSV com as colunas de
+data/nivel*.csv (m/s^2 e graus/s), pronto para entrar no dataset de treino. Num no com
+varios sensores (MOTOR_SENSOR_COUNT) o CSV leva so as amostras do motor de --motor.
+O protocolo v1 (sem os campos de motor) ainda e lido: tudo vira o motor 0.
+
+Uso:
+    ./motor_host > captura.bin && python3 tools/telemetry_decode.py captura.bin
+    python3 tools/telemetry_decode.py /dev/ttyACM0 --csv motor.csv   # precisa do pyserial
+"""
+import argparse
+import struct
+import sys
+
+TELEMETRY_VERSION = 2
+MSG_HELLO, MSG_SAMPLES, MSG_PREDICTION, MSG_STATUS = range(4)
+MSG_NAMES = ('HELLO', 'SAMPLES', 'PREDICTION', 'STATUS')
+
+# Mesmas conversoes do mpu6050.c (+-2g e +-250 graus/s)
+ACCEL_SENSITIVITY = 16384.0
+GYRO_SENSITIVITY = 131.0
+GRAVITY_MS2 = 9.81
+CSV_COLUMNS = ['Amostra', 'Acel_X', 'Acel_Y', 'Acel_Z', 'Giro_X', 'Giro_Y', 'Giro_Z']
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    """None se o bloco nao e COBS valido."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        end = i + code
+        if code == 0 or end > len(data):
+            return None
+        out += data[i + 1:end]
+        i = end
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def optional_u8(p, offset, default):
+    """Campo u8 acrescentado no fim da carga por uma versao mais nova (ausente na v1)."""
+    return p[offset] if offset < len(p) else default
+
+
+def parse_frame(raw):
+    """(tipo, seq, carimbo_us, campos) ou None se o CRC nao bate."""
+    if raw is None or len(raw) < 8:
+        return None
+    body, crc = raw[:-2], struct.unpack('<H', raw[-2:])[0]
+    if crc16(body) != crc:
+        return None
+    msg_type, seq, stamp = struct.unpack('<BBI', body[:6])
+    p = body[6:]
+    try:
+        if msg_type == MSG_HELLO:
+            version, rate, classes = struct.unpack('<BHB', p[:4])
+            fields = {'version': version, 'rate_hz': rate, 'classes': classes, 'motors': optional_u8(p, 4, 1)}
+        elif msg_type == MSG_SAMPLES:
+            n = p[0]
+            fields = {'samples': [struct.unpack('<6h', p[1 + 12 * i:13 + 12 * i]) for i in range(n)],
+                      'motor': optional_u8(p, 1 + 12 * n, 0)}
+        elif msg_type == MSG_PREDICTION:
+            level, infer_us, n = struct.unpack('<bIB', p[:6])
+            scores = [v / 65535.0 for v in struct.unpack('<%dH' % n, p[6:6 + 2 * n])]
+            fields = {'level': level, 'infer_us': infer_us, 'scores': scores, 'motor': optional_u8(p, 6 + 2 * n, 0)}
+        elif msg_type == MSG_STATUS:
+            load, dropped, n = struct.unpack('<HIB', p[:7])
+            tasks, o = [], 7
+            for _ in range(n):
+                runs, misses, max_us, name_len = struct.unpack('<HHIB', p[o:o + 9])
+                tasks.append((p[o + 9:o + 9 + name_len].decode('ascii', 'replace'), runs, misses, max_us))
+                o += 9 + name_len
+            fields = {'cpu_load': load / 100.0, 'dropped': dropped, 'tasks': tasks}
+        else:
+            return None
+    except (struct.error, IndexError):
+        return None
+    return msg_type, seq, stamp, fields
+
+
+def chunks(read):
+    """Blocos entre delimitadores 0x00 (os vazios ficam de fora); read() devolve b'' no fim."""
+    pending = bytearray()
+    while True:
+        data = read()
+        if not data:
+            break
+        pending += data
+        parts = pending.split(b'\x00')
+        pending = bytearray(parts.pop())
+        for part in parts:
+            if part:
+                yield bytes(part)
+    if pending:
+        yield bytes(pending)
+
+
+def to_units(sample):
+    accel = [round(v / ACCEL_SENSITIVITY * GRAVITY_MS2, 3) for v in sample[:3]]
+    gyro = [round(v / GYRO_SENSITIVITY, 3) for v in sample[3:]]
+    return accel + gyro
+
+
+def format_message(msg_type, stamp, fields):
+    t = '%10.3f s' % (stamp / 1e6)
+    if msg_type == MSG_HELLO:
+        return '%s HELLO v%d, %d Hz, %d classes, %d motores' % (
+            t, fields['version'], fields['rate_hz'], fields['classes'], fields['motors'])
+    if msg_type == MSG_SAMPLES:
+        last = to_units(fields['samples'][-1]) if fields['samples'] else []
+        return '%s SAMPLES motor %d: %d, ultima Acc(%s) Gyr(%s)' % (
+            t, fields['motor'], len(fields['samples']), ', '.join('%.2f' % v for v in last[:3]),
+            ', '.join('%.2f' % v for v in last[3:]))
+    if msg_type == MSG_PREDICTION:
+        return '%s PREDICTION motor %d: nivel %d (%s) em %d us' % (
+            t, fields['motor'], fields['level'], ' '.join('%.1f%%' % (100 * s) for s in fields['scores']),
+            fields['infer_us'])
+    tasks = ' | '.join('%s: %d runs, %d missed, max %d us' % task for task in fields['tasks'])
+    return '%s STATUS CPU %.2f%%, %d descartadas | %s' % (t, fields['cpu_load'], fields['dropped'], tasks)
+
+
+def open_input(path):
+    """Funcao de leitura da entrada: arquivo, stdin ou porta serial."""
+    if path == '-':
+        return lambda: sys.stdin.buffer.read1(4096)
+    if path.startswith('/dev/tty') or path.upper().startswith('COM'):
+        try:
+            import serial
+        except ImportError:
+            sys.exit('Erro: leitura da porta serial precisa do pyserial (pip install pyserial)')
+        # Bloqueia ate chegar pelo menos um byte e leva o que ja estiver no buffer; Ctrl+C encerra
+        port = serial.Serial(path, timeout=None)
+        return lambda: port.read(max(1, port.in_waiting))
+    f = open(path, 'rb')
+    return lambda: f.read(4096)
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('input', help="captura binaria, porta serial ou '-' para stdin")
+    parser.add_argument('--csv', help='grava as amostras brutas neste CSV (colunas de data/nivel*.csv)')
+    parser.add_argument('--motor', type=int, default=0, help='motor cujas amostras vao para o --csv (padrao 0)')
+    parser.add_argument('--quiet', action='store_true', help='so o resumo no fim')
+    parser.add_argument('--no-text', action='store_true', help='nao imprime o texto solto do fluxo')
+    args = parser.parse_args(argv)
+
+    counts = [0] * len(MSG_NAMES)
+    lost = [0] * len(MSG_NAMES)
+    last_seq = [None] * len(MSG_NAMES)
+    crc_errors = 0
+    csv = open(args.csv, 'w') if args.csv else None
+    if csv:
+        csv.write(','.join(CSV_COLUMNS) + '\n')
+    sample_index = 0
+
+    read = open_input(args.input)
+    try:
+        for chunk in chunks(read):
+            frame = parse_frame(cobs_decode(chunk))
+            if frame is None:
+                text = chunk.decode('utf-8', 'replace')
+                if text.strip() and all(c.isprintable() or c in '\r\n\t' for c in text):
+                    if not args.quiet and not args.no_text:
+                        print(text.rstrip('\r\n'))
+                else:
+                    crc_errors += 1
+                continue
+
+            msg_type, seq, stamp, fields = frame
+            counts[msg_type] += 1
+            if last_seq[msg_type] is not None:
+                lost[msg_type] += (seq - last_seq[msg_type] - 1) & 0xFF
+            last_seq[msg_type] = seq
+            if msg_type == MSG_HELLO and fields['version'] > TELEMETRY_VERSION:
+                print('Aviso: protocolo v%d, o decodificador e v%d' % (fields['version'], TELEMETRY_VERSION),
+                      file=sys.stderr)
+            if msg_type == MSG_SAMPLES and csv and fields['motor'] == args.motor:
+                for sample in fields['samples']:
+                    sample_index += 1
+                    csv.write('%d,%s\n' % (sample_index, ','.join('%.3f' % v for v in to_units(sample))))
+            if not args.quiet:
+                print(format_message(msg_type, stamp, fields))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if csv:
+            csv.close()
+
+    print('--- %s ---' % ', '.join('%s %d (%d perdidos)' % (name, counts[i], lost[i])
+                                   for i, name in enumerate(MSG_NAMES)), file=sys.stderr)
+    print('Quadros invalidos: %d' % crc_errors, file=sys.stderr)
+    if csv:
+        print('%d amostras em %s' % (sample_index, args.csv), file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""Features de janela deslizante, mesma conta do firmware (firmware/src/window_features.c).
+
+Para cada eixo (Acel_X/Y/Z, Giro_X/Y/Z) a janela das ultimas WINDOW_SIZE amostras vira
+RMS, pico a pico, variancia e taxa de cruzamento da media, agrupadas por eixo. As
+amostras sao convertidas para milesimos (inteiro) como no firmware, entao as somas,
+o pico a pico e os cruzamentos sao identicos aos do C; so a divisao final muda (double
+aqui, float la).
+
+O firmware recebe contagens do MPU6050 e as converte so com inteiros (mpu6050_frame_to_fixed
+-> window_features_push_fixed, contagens -> spectral_features_push_counts). level_windows faz o
+mesmo: os CSVs viram contagens como no MPU6050 simulado do build host e seguem esse caminho.
+
+O cruzamento e contado na entrada de cada amostra: ela esta acima da media se
+x >= media da janela antes dela entrar, e cruza se mudou de lado em relacao a anterior.
+
+Usado pelo notebook (secao 5) para gerar o dataset de janelas a partir de data/nivel*.csv.
+
+Uso:
+    python3 tools/window_features.py data        # quantas janelas por nivel
+"""
+import math
+import os
+import struct
+import sys
+
+import sample_filter
+import spectral_features
+from dense_export import FEATURE_COLUMNS, load_levels
+
+WINDOW_SIZE = 32
+WINDOW_FIXED_SCALE = 1000
+# Escalas em ponto fixo do mpu6050.h: valor = (contagem * MULT) >> SHIFT, arredondado
+ACCEL_MMS2_MULT, ACCEL_MMS2_SHIFT = 9810, 14
+GYRO_MDPS_MULT, GYRO_MDPS_SHIFT = 7817, 10
+STAT_NAMES = ('rms', 'p2p', 'var', 'zcr')
+
+
+def feature_names():
+    return ['%s_%s' % (axis, stat) for axis in FEATURE_COLUMNS for stat in STAT_NAMES]
+
+
+def f32(value):
+    return struct.unpack('<f', struct.pack('<f', value))[0]
+
+
+def to_fixed(value):
+    """floorf(x * 1000.0f + 0.5f) em float32, igual ao to_fixed() do firmware."""
+    return int(math.floor(f32(f32(f32(value) * WINDOW_FIXED_SCALE) + 0.5)))
+
+
+def scale_fixed(raw, mult, shift):
+    return (raw * mult + (1 << (shift - 1))) >> shift
+
+
+def frame_to_fixed(counts):
+    """6 contagens (Acel_X..Giro_Z) -> mm/s² e m°/s, igual ao mpu6050_frame_to_fixed()."""
+    return ([scale_fixed(c, ACCEL_MMS2_MULT, ACCEL_MMS2_SHIFT) for c in counts[:3]] +
+            [scale_fixed(c, GYRO_MDPS_MULT, GYRO_MDPS_SHIFT) for c in counts[3:]])
+
+
+def stream_features(samples, size=WINDOW_SIZE, counts=False):
+    """Gera (indice, features) para cada amostra a partir da que completa a primeira janela.
+
+    samples: sequencia de amostras com 6 valores (mesma ordem do in_features do firmware), na
+    unidade fisica (window_features_push) ou, com counts=True, em contagens do MPU6050
+    (mpu6050_frame_to_fixed + window_features_push_fixed).
+    """
+    axes = len(samples[0]) if samples else 0
+    if counts:
+        converted = [frame_to_fixed(s) for s in samples]
+        fixed = [[s[i] for s in converted] for i in range(axes)]
+    else:
+        fixed = [[to_fixed(s[i]) for s in samples] for i in range(axes)]
+
+    # Lado da media e cruzamento de cada amostra, como no axis_push()
+    crossed = []
+    for values in fixed:
+        flags = []
+        prev_above = True
+        total = 0
+        for t, x in enumerate(values):
+            count = min(t, size)
+            above = count == 0 or x * count >= total
+            flags.append(1 if t > 0 and above != prev_above else 0)
+            prev_above = above
+            total += x
+            if t >= size:
+                total -= values[t - size]
+        crossed.append(flags)
+
+    for t in range(size - 1, len(samples)):
+        out = []
+        for values, flags in zip(fixed, crossed):
+            window = values[t - size + 1:t + 1]
+            s1 = sum(window)
+            s2 = sum(x * x for x in window)
+            n = size
+            out.append(math.sqrt(s2 / n) / WINDOW_FIXED_SCALE)
+            out.append((max(window) - min(window)) / WINDOW_FIXED_SCALE)
+            out.append((n * s2 - s1 * s1) / (n * n) / WINDOW_FIXED_SCALE ** 2)
+            out.append(sum(flags[t - size + 2:t + 1]) / (n - 1))
+        yield t, out
+
+
+def level_windows(data_dir, size=WINDOW_SIZE, spectral=False, filter_coeffs=None):
+    """Janelas de cada data/nivel*.csv em ordem de tempo: lista de (features, nivel, indice).
+
+    spectral=True acrescenta as energias por banda de tools/spectral_features.py depois das
+    features de janela (mesma ordem do firmware com MOTOR_SPECTRAL_FEATURES); a primeira
+    entrada de cada nivel passa a ser a que enche as duas janelas.
+
+    filter_coeffs (sample_filter.load_header) passa cada nivel antes pelo filtro de decimacao,
+    como o firmware com MOTOR_SENSOR_FILTER.
+
+    As amostras seguem como contagens do MPU6050, pelo mesmo caminho inteiro do push_frames.
+    """
+    if filter_coeffs:
+        levels = sample_filter.filter_levels(data_dir, filter_coeffs, counts=True)
+    else:
+        levels = [(sample_filter.to_counts(features), label) for features, label in load_levels(data_dir)]
+    by_level = {}
+    for features, label in levels:
+        by_level.setdefault(label, []).append(features)
+    windows = []
+    for label in sorted(by_level):
+        samples = by_level[label]
+        bands = {}
+        if spectral:
+            bands = dict(spectral_features.stream_features(samples, counts=True))
+        for t, features in stream_features(samples, size, counts=True):
+            if spectral:
+                if t not in bands:
+                    continue
+                features = features + bands[t]
+            windows.append((features, label, t))
+    return windows
+
+
+def main(argv=None):
+    argv = sys.argv[1:] if argv is None else argv
+    data_dir = argv[0] if argv else os.path.join(os.path.dirname(__file__), '..', 'data')
+    windows = level_windows(data_dir)
+    for label in sorted(set(w[1] for w in windows)):
+        print('Nivel %d: %d janelas de %d amostras' % (label, sum(1 for w in windows if w[1] == label),
+                                                      WINDOW_SIZE))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())